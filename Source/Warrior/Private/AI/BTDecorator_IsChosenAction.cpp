@@ -0,0 +1,40 @@
+// ALL FREE
+
+
+#include "AI/BTDecorator_IsChosenAction.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Enum.h"
+
+UBTDecorator_IsChosenAction::UBTDecorator_IsChosenAction()
+{
+	NodeName = TEXT("Native Is Chosen Action");
+
+	Action = EWarriorEnemyAction::Attack;
+	bPassWithoutDecision = true;
+
+	// Abort both ways, the brain's choice is what the tree should be running right now.
+	FlowAbortMode = EBTFlowAbortMode::Both;
+
+	BlackboardKey.AddEnumFilter(this, GET_MEMBER_NAME_CHECKED(ThisClass, BlackboardKey), StaticEnum<EWarriorEnemyAction>());
+	BlackboardKey.SelectedKeyName = FName("ChosenAction");
+}
+
+FString UBTDecorator_IsChosenAction::GetStaticDescription() const
+{
+	return FString::Printf(TEXT("%s: %s Key is %s%s"), *Super::GetStaticDescription(), *BlackboardKey.SelectedKeyName.ToString(),
+		*UEnum::GetDisplayValueAsText(Action).ToString(), bPassWithoutDecision ? TEXT(" or None") : TEXT(""));
+}
+
+bool UBTDecorator_IsChosenAction::CalculateRawConditionValue(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const
+{
+	const UBlackboardComponent* BlackboardComp = OwnerComp.GetBlackboardComponent();
+
+	if (!BlackboardComp)
+	{
+		return false;
+	}
+
+	const EWarriorEnemyAction ChosenAction = static_cast<EWarriorEnemyAction>(BlackboardComp->GetValue<UBlackboardKeyType_Enum>(BlackboardKey.GetSelectedKeyID()));
+
+	return ChosenAction == Action || (bPassWithoutDecision && ChosenAction == EWarriorEnemyAction::None);
+}
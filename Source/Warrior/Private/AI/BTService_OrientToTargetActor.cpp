@@ -3,8 +3,10 @@
 
 #include "AI/BTService_OrientToTargetActor.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
 #include "AIController.h"
-#include "Kismet/KismetMathLibrary.h"
+#include "Subsystems/WarriorOrientationSubsystem.h"
+#include "WarriorStats.h"
 
 UBTService_OrientToTargetActor::UBTService_OrientToTargetActor()
 {
@@ -33,23 +35,65 @@ FString UBTService_OrientToTargetActor::GetStaticDescription() const
 {
 	const FString KeyDescription = InTargetActorKey.SelectedKeyName.ToString();
 
-	return FString::Printf(TEXT("Orient rotation to %s Key %s"), *KeyDescription, *GetStaticServiceDescription());
+	return FString::Printf(TEXT("Orient rotation to %s Key, batched by the orientation subsystem"), *KeyDescription);
 }
 
-void UBTService_OrientToTargetActor::TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+void UBTService_OrientToTargetActor::OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
 {
-	Super::TickNode(OwnerComp, NodeMemory, DeltaSeconds);
+	Super::OnBecomeRelevant(OwnerComp, NodeMemory);
 
-	UObject* ActorObject = OwnerComp.GetBlackboardComponent()->GetValueAsObject(InTargetActorKey.SelectedKeyName);
-	AActor* TargetActor = Cast<AActor>(ActorObject);
+	if (UBlackboardComponent* BlackboardComp = OwnerComp.GetBlackboardComponent())
+	{
+		BlackboardComp->RegisterObserver(InTargetActorKey.GetSelectedKeyID(), this, FOnBlackboardChangeNotification::CreateUObject(this, &ThisClass::OnTargetActorKeyChanged));
 
-	APawn* OwningPawn = OwnerComp.GetAIOwner()->GetPawn();
+		UpdateOrientationTarget(*BlackboardComp);
+	}
+}
 
-	if (OwningPawn && TargetActor)
+void UBTService_OrientToTargetActor::OnCeaseRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	if (UBlackboardComponent* BlackboardComp = OwnerComp.GetBlackboardComponent())
 	{
-		const FRotator LookAtRot = UKismetMathLibrary::FindLookAtRotation(OwningPawn->GetActorLocation(), TargetActor->GetActorLocation());
-		const FRotator TargetRot = FMath::RInterpTo(OwningPawn->GetActorRotation(), LookAtRot, DeltaSeconds, RotationInterpSpeed);
+		BlackboardComp->UnregisterObserversFrom(this);
+	}
+
+	const APawn* OwningPawn = OwnerComp.GetAIOwner() ? OwnerComp.GetAIOwner()->GetPawn() : nullptr;
+
+	if (UWarriorOrientationSubsystem* OrientationSubsystem = OwningPawn ? OwningPawn->GetWorld()->GetSubsystem<UWarriorOrientationSubsystem>() : nullptr)
+	{
+		OrientationSubsystem->UnregisterPawn(OwningPawn, this);
+	}
+
+	Super::OnCeaseRelevant(OwnerComp, NodeMemory);
+}
+
+EBlackboardNotificationResult UBTService_OrientToTargetActor::OnTargetActorKeyChanged(const UBlackboardComponent& Blackboard, FBlackboard::FKey ChangedKeyID)
+{
+	UpdateOrientationTarget(Blackboard);
 
-		OwningPawn->SetActorRotation(TargetRot);
+	return EBlackboardNotificationResult::ContinueObserving;
+}
+
+void UBTService_OrientToTargetActor::UpdateOrientationTarget(const UBlackboardComponent& Blackboard) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_Warrior_AIServiceTick);
+
+	const AAIController* AIController = Cast<AAIController>(Blackboard.GetOwner());
+	APawn* OwningPawn = AIController ? AIController->GetPawn() : nullptr;
+
+	UWarriorOrientationSubsystem* OrientationSubsystem = OwningPawn ? OwningPawn->GetWorld()->GetSubsystem<UWarriorOrientationSubsystem>() : nullptr;
+
+	if (!OrientationSubsystem)
+	{
+		return;
+	}
+
+	if (AActor* TargetActor = Cast<AActor>(Blackboard.GetValue<UBlackboardKeyType_Object>(InTargetActorKey.GetSelectedKeyID())))
+	{
+		OrientationSubsystem->RegisterPawn(OwningPawn, TargetActor, RotationInterpSpeed, this);
+	}
+	else
+	{
+		OrientationSubsystem->UnregisterPawn(OwningPawn, this);
 	}
 }
@@ -0,0 +1,103 @@
+// ALL FREE
+
+
+#include "AI/BTTask_FollowFlowField.h"
+#include "AIController.h"
+#include "Subsystems/WarriorFlowFieldSubsystem.h"
+
+UBTTask_FollowFlowField::UBTTask_FollowFlowField()
+{
+	NodeName = TEXT("Native Follow Flow Field To Hero");
+	FinalApproachDistance = 600.f;
+
+	INIT_TASK_NODE_NOTIFY_FLAGS();
+
+	bNotifyTick = true;
+	bNotifyTaskFinished = true;
+	bCreateNodeInstance = false;
+}
+
+uint16 UBTTask_FollowFlowField::GetInstanceMemorySize() const
+{
+	return sizeof(FFollowFlowFieldTaskMemory);
+}
+
+FString UBTTask_FollowFlowField::GetStaticDescription() const
+{
+	return FString::Printf(TEXT("Follows the shared flow field until within %s of the hero"), *FString::SanitizeFloat(FinalApproachDistance));
+}
+
+EBTNodeResult::Type UBTTask_FollowFlowField::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	APawn* OwningPawn = OwnerComp.GetAIOwner()->GetPawn();
+	UWarriorFlowFieldSubsystem* FlowFieldSubsystem = OwnerComp.GetWorld()->GetSubsystem<UWarriorFlowFieldSubsystem>();
+
+	FVector FlowDirection;
+
+	if (!OwningPawn || !FlowFieldSubsystem || !FlowFieldSubsystem->GetTargetLocation())
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	if (IsWithinFinalApproach(OwningPawn, *FlowFieldSubsystem->GetTargetLocation()))
+	{
+		return EBTNodeResult::Succeeded;
+	}
+
+	if (!FlowFieldSubsystem->GetFlowDirection(OwningPawn->GetActorLocation(), FlowDirection))
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	FFollowFlowFieldTaskMemory* Memory = CastInstanceNodeMemory<FFollowFlowFieldTaskMemory>(NodeMemory);
+	Memory->OwningPawn = OwningPawn;
+
+	// The subsystem moves every follower in one pass each frame, this task only decides when to stop.
+	FlowFieldSubsystem->RegisterFollower(OwningPawn);
+
+	return EBTNodeResult::InProgress;
+}
+
+void UBTTask_FollowFlowField::TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+{
+	FFollowFlowFieldTaskMemory* Memory = CastInstanceNodeMemory<FFollowFlowFieldTaskMemory>(NodeMemory);
+	const UWarriorFlowFieldSubsystem* FlowFieldSubsystem = OwnerComp.GetWorld()->GetSubsystem<UWarriorFlowFieldSubsystem>();
+
+	FVector FlowDirection;
+
+	if (!Memory->OwningPawn.IsValid() || !FlowFieldSubsystem || !FlowFieldSubsystem->GetTargetLocation())
+	{
+		FinishLatentTask(OwnerComp, EBTNodeResult::Failed);
+		return;
+	}
+
+	if (IsWithinFinalApproach(Memory->OwningPawn.Get(), *FlowFieldSubsystem->GetTargetLocation()))
+	{
+		FinishLatentTask(OwnerComp, EBTNodeResult::Succeeded);
+		return;
+	}
+
+	if (!FlowFieldSubsystem->GetFlowDirection(Memory->OwningPawn->GetActorLocation(), FlowDirection))
+	{
+		FinishLatentTask(OwnerComp, EBTNodeResult::Failed);
+	}
+}
+
+void UBTTask_FollowFlowField::OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult)
+{
+	FFollowFlowFieldTaskMemory* Memory = CastInstanceNodeMemory<FFollowFlowFieldTaskMemory>(NodeMemory);
+
+	if (UWarriorFlowFieldSubsystem* FlowFieldSubsystem = OwnerComp.GetWorld()->GetSubsystem<UWarriorFlowFieldSubsystem>())
+	{
+		FlowFieldSubsystem->UnregisterFollower(Memory->OwningPawn.Get());
+	}
+
+	Memory->OwningPawn.Reset();
+
+	Super::OnTaskFinished(OwnerComp, NodeMemory, TaskResult);
+}
+
+bool UBTTask_FollowFlowField::IsWithinFinalApproach(const APawn* QueryPawn, const FVector& InTargetLocation) const
+{
+	return FVector::DistSquared2D(QueryPawn->GetActorLocation(), InTargetLocation) <= FMath::Square(FinalApproachDistance);
+}
@@ -3,8 +3,9 @@
 
 #include "AI/BTTask_RotateToFaceTarget.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
 #include "AIController.h"
-#include "Kismet/KismetMathLibrary.h"
+#include "Subsystems/WarriorOrientationSubsystem.h"
 
 UBTTask_RotateToFaceTarget::UBTTask_RotateToFaceTarget()
 {
@@ -29,6 +30,9 @@ void UBTTask_RotateToFaceTarget::InitializeFromAsset(UBehaviorTree& Asset)
 	{
 		InTargetToFaceKey.ResolveSelectedKey(*BBAsset);
 	}
+
+	// acos is monotonic, so comparing the dot product against this gives the same answer as comparing angles.
+	AnglePrecisionCos = FMath::Cos(FMath::DegreesToRadians(FMath::Clamp(AnglePrecision, 0.f, 180.f)));
 }
 
 uint16 UBTTask_RotateToFaceTarget::GetInstanceMemorySize() const
@@ -45,7 +49,7 @@ FString UBTTask_RotateToFaceTarget::GetStaticDescription() const
 
 EBTNodeResult::Type UBTTask_RotateToFaceTarget::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
 {
-	UObject* ActorObject = OwnerComp.GetBlackboardComponent()->GetValueAsObject(InTargetToFaceKey.SelectedKeyName);
+	UObject* ActorObject = OwnerComp.GetBlackboardComponent()->GetValue<UBlackboardKeyType_Object>(InTargetToFaceKey.GetSelectedKeyID());
 	AActor* TargetActor = Cast<AActor>(ActorObject);
 
 	APawn* OwningPawn = OwnerComp.GetAIOwner()->GetPawn();
@@ -67,6 +71,16 @@ EBTNodeResult::Type UBTTask_RotateToFaceTarget::ExecuteTask(UBehaviorTreeCompone
 		return EBTNodeResult::Succeeded;
 	}
 
+	if (UWarriorOrientationSubsystem* OrientationSubsystem = OwningPawn->GetWorld()->GetSubsystem<UWarriorOrientationSubsystem>())
+	{
+		OrientationSubsystem->RegisterPawn(OwningPawn, TargetActor, RotationInterpSpeed, this);
+	}
+	else
+	{
+		// No subsystem in this world, so nothing else would turn the pawn.
+		Memory->bRotateInTask = true;
+	}
+
 	return EBTNodeResult::InProgress;
 }
 
@@ -77,29 +91,58 @@ void UBTTask_RotateToFaceTarget::TickTask(UBehaviorTreeComponent& OwnerComp, uin
 	if (!Memory->IsValid())
 	{
 		FinishLatentTask(OwnerComp, EBTNodeResult::Failed);
+		return;
 	}
 
-	if (HasReachedAnglePrecision(Memory->OwningPawn.Get(), Memory->TargetActor.Get()))
+	APawn* OwningPawn = Memory->OwningPawn.Get();
+	const AActor* TargetActor = Memory->TargetActor.Get();
+
+	// The turning normally happens in the orientation subsystem, this only checks whether it got there.
+	if (HasReachedAnglePrecision(OwningPawn, TargetActor))
 	{
-		Memory->Reset();
 		FinishLatentTask(OwnerComp, EBTNodeResult::Succeeded);
+		return;
 	}
-	else
+
+	if (Memory->bRotateInTask)
 	{
-		const FRotator LookAtRot = UKismetMathLibrary::FindLookAtRotation(Memory->OwningPawn->GetActorLocation(), Memory->TargetActor->GetActorLocation());
-		const FRotator TargetRot = FMath::RInterpTo(Memory->OwningPawn->GetActorRotation(), LookAtRot, DeltaSeconds, RotationInterpSpeed);
+		const FVector ToTarget = TargetActor->GetActorLocation() - OwningPawn->GetActorLocation();
+
+		FRotator TargetRotation = OwningPawn->GetActorRotation();
+		TargetRotation.Yaw = ToTarget.Rotation().Yaw;
 
-		Memory->OwningPawn->SetActorRotation(TargetRot);
+		OwningPawn->SetActorRotation(FMath::RInterpTo(OwningPawn->GetActorRotation(), TargetRotation, DeltaSeconds, RotationInterpSpeed));
 	}
 }
 
-bool UBTTask_RotateToFaceTarget::HasReachedAnglePrecision(APawn* QueryPawn, AActor* TargetActor) const
+void UBTTask_RotateToFaceTarget::OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult)
 {
-	const FVector OwnerForward = QueryPawn->GetActorForwardVector();
-	const FVector OwnerToTargetNormalized = (TargetActor->GetActorLocation() - QueryPawn->GetActorLocation()).GetSafeNormal();
+	FRotateToFaceTargetTaskMemory* Memory = CastInstanceNodeMemory<FRotateToFaceTargetTaskMemory>(NodeMemory);
 
-	const float DotResult = FVector::DotProduct(OwnerForward, OwnerToTargetNormalized);
-	const float AngleDiff = UKismetMathLibrary::DegAcos(DotResult);
+	const APawn* OwningPawn = OwnerComp.GetAIOwner() ? OwnerComp.GetAIOwner()->GetPawn() : nullptr;
+
+	if (UWarriorOrientationSubsystem* OrientationSubsystem = OwningPawn ? OwningPawn->GetWorld()->GetSubsystem<UWarriorOrientationSubsystem>() : nullptr)
+	{
+		OrientationSubsystem->UnregisterPawn(OwningPawn, this);
+	}
+
+	Memory->Reset();
+
+	Super::OnTaskFinished(OwnerComp, NodeMemory, TaskResult);
+}
+
+bool UBTTask_RotateToFaceTarget::HasReachedAnglePrecision(const APawn* QueryPawn, const AActor* TargetActor) const
+{
+	return IsFacingWithinPrecision(QueryPawn->GetActorForwardVector(), TargetActor->GetActorLocation() - QueryPawn->GetActorLocation());
+}
+
+bool UBTTask_RotateToFaceTarget::IsFacingWithinPrecision(const FVector& InForward, const FVector& InToTarget) const
+{
+	// No yaw turns the pawn any closer to a target right above or below it.
+	if (InToTarget.SizeSquared2D() <= UE_SMALL_NUMBER)
+	{
+		return true;
+	}
 
-	return AngleDiff <= AnglePrecision;
+	return FVector::DotProduct(InForward.GetSafeNormal2D(), InToTarget.GetSafeNormal2D()) >= AnglePrecisionCos;
 }
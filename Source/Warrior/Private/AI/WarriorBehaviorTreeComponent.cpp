@@ -0,0 +1,37 @@
+// ALL FREE
+
+
+#include "AI/WarriorBehaviorTreeComponent.h"
+#include "Subsystems/WarriorBehaviorTreeBudgetSubsystem.h"
+#include "WarriorStats.h"
+
+void UWarriorBehaviorTreeComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	UWarriorBehaviorTreeBudgetSubsystem* BudgetSubsystem = GetWorld()->GetSubsystem<UWarriorBehaviorTreeBudgetSubsystem>();
+
+	if (!BudgetSubsystem)
+	{
+		Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+		return;
+	}
+
+	const float PendingDeltaTime = DeferredDeltaTime + DeltaTime;
+
+	if (!BudgetSubsystem->ShouldTickTree(*this, PendingDeltaTime))
+	{
+		DeferredDeltaTime = PendingDeltaTime;
+		return;
+	}
+
+	DeferredDeltaTime = 0.f;
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_Warrior_BehaviorTreeTick);
+
+		Super::TickComponent(PendingDeltaTime, TickType, ThisTickFunction);
+	}
+
+	BudgetSubsystem->AddTreeTickCost(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles));
+}
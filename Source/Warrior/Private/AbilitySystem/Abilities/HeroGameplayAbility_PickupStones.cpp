@@ -7,6 +7,8 @@
 #include "Items/PickUps/WarriorStoneBase.h"
 #include "Components/UI/HeroUIComponent.h"
 
+#include "WarriorDebugHelper.h"
+
 void UHeroGameplayAbility_PickupStones::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData)
 {
 	GetHeroUIComponentFromActorInfo()->OnStoneInteractedDelegate.Broadcast(true);
@@ -36,7 +38,7 @@ void UHeroGameplayAbility_PickupStones::CollectStones()
 		StoneTraceChannel,
 		false,
 		TArray<AActor*>(),
-		bDrawDebugShape ? EDrawDebugTrace::ForOneFrame : EDrawDebugTrace::None,
+		WARRIOR_ENABLE_DEBUG_DRAW && bDrawDebugShape ? EDrawDebugTrace::ForOneFrame : EDrawDebugTrace::None,
 		TraceHits,
 		true
 	);
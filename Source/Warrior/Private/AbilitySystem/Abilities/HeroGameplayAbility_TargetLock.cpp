@@ -15,6 +15,9 @@
 #include "Kismet/KismetMathLibrary.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "EnhancedInputSubsystems.h"
+#include "AbilitySystem/AbilityTasks/AbilityTask_ExecuteTaskOnTick.h"
+#include "WarriorStats.h"
+#include "Subsystems/WarriorTelemetrySubsystem.h"
 
 #include "WarriorDebugHelper.h"
 
@@ -25,10 +28,22 @@ void UHeroGameplayAbility_TargetLock::ActivateAbility(const FGameplayAbilitySpec
 	InitTargetLockMappingContext();
 
 	Super::ActivateAbility(Handle, ActorInfo, ActivationInfo, TriggerEventData);
+
+	if (bUseNativeTick && IsActive())
+	{
+		UAbilityTask_ExecuteTaskOnTick* TargetLockTickTask = UAbilityTask_ExecuteTaskOnTick::ExecuteTaskOnTick(this, NativeTickInterval);
+		TargetLockTickTask->OnAbilityTaskNativeTick.AddUObject(this, &ThisClass::OnTargetLockTick);
+		TargetLockTickTask->ReadyForActivation();
+	}
 }
 
 void UHeroGameplayAbility_TargetLock::EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled)
 {
+	if (CurrentLockedActor)
+	{
+		UWarriorTelemetrySubsystem::RecordMarker(GetHeroCharacterFromActorInfo(), EWarriorTelemetryMarker::TargetLockOff);
+	}
+
 	ResetTargetLockMovement();
 	ResetTargetLockMappingContext();
 	CleanUp();
@@ -38,6 +53,8 @@ void UHeroGameplayAbility_TargetLock::EndAbility(const FGameplayAbilitySpecHandl
 
 void UHeroGameplayAbility_TargetLock::OnTargetLockTick(float DeltaTime)
 {
+	SCOPE_CYCLE_COUNTER(STAT_Warrior_TargetLockTick);
+
 	if (!CurrentLockedActor ||
 		UWarriorFunctionLibrary::NativeDoesActorHaveTag(CurrentLockedActor, WarriorGameplayTags::Shared_Status_Dead) ||
 		UWarriorFunctionLibrary::NativeDoesActorHaveTag(GetHeroCharacterFromActorInfo(), WarriorGameplayTags::Shared_Status_Dead))
@@ -109,6 +126,8 @@ void UHeroGameplayAbility_TargetLock::TryLockOnTarget()
 
 	if (CurrentLockedActor)
 	{
+		UWarriorTelemetrySubsystem::RecordMarker(GetHeroCharacterFromActorInfo(), EWarriorTelemetryMarker::TargetLockOn, AvailableActorsToLock.Num());
+
 		DrawTargetLockWidget();
 
 		SetTargetLockWidgetPosition();
@@ -121,6 +140,8 @@ void UHeroGameplayAbility_TargetLock::TryLockOnTarget()
 
 void UHeroGameplayAbility_TargetLock::GetAvailableActorsToLock()
 {
+	SCOPE_CYCLE_COUNTER(STAT_Warrior_TargetLockAcquire);
+
 	AvailableActorsToLock.Empty();
 	TArray<FHitResult> BoxTraceHits;
 
@@ -133,7 +154,7 @@ void UHeroGameplayAbility_TargetLock::GetAvailableActorsToLock()
 		BoxTraceChannel,
 		false,
 		TArray<AActor*>(),
-		bShowPersistentDebugShape ? EDrawDebugTrace::Persistent : EDrawDebugTrace::None,
+		WARRIOR_ENABLE_DEBUG_DRAW && bShowPersistentDebugShape ? EDrawDebugTrace::Persistent : EDrawDebugTrace::None,
 		BoxTraceHits,
 		true
 	);
@@ -149,6 +170,8 @@ void UHeroGameplayAbility_TargetLock::GetAvailableActorsToLock()
 			}
 		}
 	}
+
+	SET_DWORD_STAT(STAT_Warrior_TargetLockCandidates, AvailableActorsToLock.Num());
 }
 
 AActor* UHeroGameplayAbility_TargetLock::GetNearestTargetFromAvailableActors(const TArray<AActor*>& InAvailableActors)
@@ -193,6 +216,9 @@ void UHeroGameplayAbility_TargetLock::DrawTargetLockWidget()
 	{
 		checkf(TargetLockWidgetClass, TEXT("Forgot to assign a valid widget class in Blueprint"));
 
+		LLM_SCOPE_BYTAG(Warrior_Widgets);
+		WARRIOR_HITCH_SCOPE(WidgetCreation);
+
 		DrawnTargetLockWidget = CreateWidget<UWarriorWidgetBase>(GetHeroControllerFromActorInfo(), TargetLockWidgetClass);
 
 		check(DrawnTargetLockWidget);
@@ -258,6 +284,7 @@ void UHeroGameplayAbility_TargetLock::InitTargetLockMappingContext()
 
 	check(Subsystem)
 
+	WARRIOR_HITCH_SCOPE(InputMappingChange);
 	Subsystem->AddMappingContext(TargetLockMappingContext, 3);
 }
 
@@ -269,6 +296,7 @@ void UHeroGameplayAbility_TargetLock::CancelTargetLockAbility()
 void UHeroGameplayAbility_TargetLock::CleanUp()
 {
 	AvailableActorsToLock.Empty();
+	SET_DWORD_STAT(STAT_Warrior_TargetLockCandidates, 0);
 
 	CurrentLockedActor = nullptr;
 
@@ -305,5 +333,6 @@ void UHeroGameplayAbility_TargetLock::ResetTargetLockMappingContext()
 
 	check(Subsystem)
 
+	WARRIOR_HITCH_SCOPE(InputMappingChange);
 	Subsystem->RemoveMappingContext(TargetLockMappingContext);
 }
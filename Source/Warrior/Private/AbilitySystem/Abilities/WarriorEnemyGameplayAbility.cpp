@@ -4,8 +4,47 @@
 #include "AbilitySystem/Abilities/WarriorEnemyGameplayAbility.h"
 #include "Characters/WarriorEnemyCharacter.h"
 #include "AbilitySystem/WarriorAbilitySystemComponent.h"
+#include "GameControllers/WarriorAIController.h"
+#include "Subsystems/WarriorAttackTokenSubsystem.h"
+#include "WarriorFunctionLibrary.h"
 #include "WarriorGameplayTags.h"
 
+void UWarriorEnemyGameplayAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData)
+{
+	if (bRequiresAttackToken)
+	{
+		AActor* AvatarActor = ActorInfo->AvatarActor.Get();
+		const AActor* TargetActor = GetAttackTokenTarget(ActorInfo);
+		UWarriorAttackTokenSubsystem* AttackTokenSubsystem = TargetActor ? AvatarActor->GetWorld()->GetSubsystem<UWarriorAttackTokenSubsystem>() : nullptr;
+
+		if (AttackTokenSubsystem && !AttackTokenSubsystem->TryAcquireToken(AvatarActor, Handle, TargetActor, AttackTokenCost))
+		{
+			// Circles the target until a slot frees up, instead of piling onto it.
+			UWarriorFunctionLibrary::AddGameplayTagToActorIfNone(AvatarActor, WarriorGameplayTags::Enemy_Status_Strafing);
+
+			CancelAbility(Handle, ActorInfo, ActivationInfo, true);
+			return;
+		}
+
+		UWarriorFunctionLibrary::RemoveGameplayTagFromActorIfFound(AvatarActor, WarriorGameplayTags::Enemy_Status_Strafing);
+	}
+
+	Super::ActivateAbility(Handle, ActorInfo, ActivationInfo, TriggerEventData);
+}
+
+void UWarriorEnemyGameplayAbility::EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled)
+{
+	if (bRequiresAttackToken && ActorInfo && ActorInfo->AvatarActor.IsValid())
+	{
+		if (UWarriorAttackTokenSubsystem* AttackTokenSubsystem = ActorInfo->AvatarActor->GetWorld()->GetSubsystem<UWarriorAttackTokenSubsystem>())
+		{
+			AttackTokenSubsystem->ReleaseToken(ActorInfo->AvatarActor.Get(), Handle);
+		}
+	}
+
+	Super::EndAbility(Handle, ActorInfo, ActivationInfo, bReplicateEndAbility, bWasCancelled);
+}
+
 AWarriorEnemyCharacter* UWarriorEnemyGameplayAbility::GetEnemyCharacterFromActorInfo()
 {
 	if (!CachedWarriorEnemyCharacter.IsValid())
@@ -43,3 +82,11 @@ FGameplayEffectSpecHandle UWarriorEnemyGameplayAbility::MakeEnemyDamageEffectSpe
 
 	return EffectSpecHandle;
 }
+
+AActor* UWarriorEnemyGameplayAbility::GetAttackTokenTarget(const FGameplayAbilityActorInfo* ActorInfo)
+{
+	const APawn* AvatarPawn = Cast<APawn>(ActorInfo->AvatarActor.Get());
+	const AWarriorAIController* AIController = AvatarPawn ? Cast<AWarriorAIController>(AvatarPawn->GetController()) : nullptr;
+
+	return AIController ? AIController->GetTargetActor() : nullptr;
+}
@@ -2,30 +2,51 @@
 
 
 #include "AbilitySystem/AbilityTasks/AbilityTask_ExecuteTaskOnTick.h"
+#include "Subsystems/WarriorTaskTickSubsystem.h"
 
-UAbilityTask_ExecuteTaskOnTick::UAbilityTask_ExecuteTaskOnTick()
-{
-	bTickingTask = true;
-}
-
-UAbilityTask_ExecuteTaskOnTick* UAbilityTask_ExecuteTaskOnTick::ExecuteTaskOnTick(UGameplayAbility* OwningAbility)
+UAbilityTask_ExecuteTaskOnTick* UAbilityTask_ExecuteTaskOnTick::ExecuteTaskOnTick(UGameplayAbility* OwningAbility, float TickInterval)
 {
 	UAbilityTask_ExecuteTaskOnTick* Node = NewAbilityTask<UAbilityTask_ExecuteTaskOnTick>(OwningAbility);
+	Node->TickInterval = FMath::Max(TickInterval, 0.f);
 
 	return Node;
 }
 
-void UAbilityTask_ExecuteTaskOnTick::TickTask(float DeltaTime)
+void UAbilityTask_ExecuteTaskOnTick::Activate()
 {
-	Super::TickTask(DeltaTime);
+	Super::Activate();
 
-	if (ShouldBroadcastAbilityTaskDelegates())
+	// Ticked in one batched pass with every other tick task instead of through the gameplay tasks component.
+	if (UWarriorTaskTickSubsystem* TaskTickSubsystem = UWorld::GetSubsystem<UWarriorTaskTickSubsystem>(GetWorld()))
 	{
-		OnAbilityTaskTick.Broadcast(DeltaTime);
+		TaskTickSubsystem->RegisterTickTask(this);
 	}
-	else
+}
+
+void UAbilityTask_ExecuteTaskOnTick::OnDestroy(bool bInOwnerFinished)
+{
+	if (UWarriorTaskTickSubsystem* TaskTickSubsystem = UWorld::GetSubsystem<UWarriorTaskTickSubsystem>(GetWorld()))
 	{
-		EndTask();
+		TaskTickSubsystem->UnregisterTickTask(this);
 	}
+
+	OnAbilityTaskNativeTick.Clear();
+
+	Super::OnDestroy(bInOwnerFinished);
 }
 
+void UAbilityTask_ExecuteTaskOnTick::ExecuteTick(float DeltaTime)
+{
+	if (!ShouldBroadcastAbilityTaskDelegates())
+	{
+		EndTask();
+		return;
+	}
+
+	OnAbilityTaskNativeTick.Broadcast(DeltaTime);
+
+	if (OnAbilityTaskTick.IsBound())
+	{
+		OnAbilityTaskTick.Broadcast(DeltaTime);
+	}
+}
@@ -6,6 +6,8 @@
 #include "Engine/AssetManager.h"
 #include "NavigationSystem.h"
 #include "Characters/WarriorEnemyCharacter.h"
+#include "WarriorStats.h"
+#include "Subsystems/WarriorTelemetrySubsystem.h"
 
 #include "WarriorDebugHelper.h"
 
@@ -41,7 +43,8 @@ void UAbilityTask_WaitSpawnEnemies::OnGameplayEventReceived(const FGameplayEvent
 {
     if (ensure(!CachedSoftEnemyClassToSpawn.IsNull()))
     {
-        UAssetManager::Get().GetStreamableManager().RequestAsyncLoad(
+        WarriorStats::RequestTrackedAsyncLoad(
+            UAssetManager::Get().GetStreamableManager(),
             CachedSoftEnemyClassToSpawn.ToSoftObjectPath(), // Path to the resource to be loaded
             FStreamableDelegate::CreateUObject(this, &ThisClass::OnEnemyClassLoaded) // Callbacks after loading is complete
         );
@@ -74,6 +77,9 @@ void UAbilityTask_WaitSpawnEnemies::OnEnemyClassLoaded()
         return;
     }
 
+    LLM_SCOPE_BYTAG(Warrior_Enemies);
+    WARRIOR_HITCH_SCOPE(EnemySpawn);
+
     TArray<AWarriorEnemyCharacter*> SpawnedEnemies;
 
     FActorSpawnParameters SpawnParam;
@@ -97,6 +103,11 @@ void UAbilityTask_WaitSpawnEnemies::OnEnemyClassLoaded()
         }
     }
 
+    if (!SpawnedEnemies.IsEmpty())
+    {
+        UWarriorTelemetrySubsystem::RecordMarker(World, EWarriorTelemetryMarker::SpawnBurst, SpawnedEnemies.Num());
+    }
+
     if (ShouldBroadcastAbilityTaskDelegates())
     {
         if (!SpawnedEnemies.IsEmpty())
@@ -5,6 +5,7 @@
 
 #include "AbilitySystem/WarriorAttributeSet.h"
 #include "WarriorGameplayTags.h"
+#include "WarriorStats.h"
 
 #include "WarriorDebugHelper.h"
 
@@ -51,6 +52,9 @@ UGEExecuteCal_DamageTaken::UGEExecuteCal_DamageTaken()
 
 void UGEExecuteCal_DamageTaken::Execute_Implementation(const FGameplayEffectCustomExecutionParameters& ExecutionParams, FGameplayEffectCustomExecutionOutput& OutExecutionOutput) const
 {
+	SCOPE_CYCLE_COUNTER(STAT_Warrior_DamageExecution);
+	WARRIOR_HITCH_SCOPE(DamageResolution);
+
 	const FGameplayEffectSpec& EffectSpec = ExecutionParams.GetOwningSpec();
 
 	/*EffectSpec.GetContext().GetSourceObject();
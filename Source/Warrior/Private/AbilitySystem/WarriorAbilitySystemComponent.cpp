@@ -4,6 +4,47 @@
 #include "AbilitySystem/WarriorAbilitySystemComponent.h"
 #include "AbilitySystem/Abilities/WarriorHeroGameplayAbility.h"
 #include "WarriorGameplayTags.h"
+#include "WarriorStats.h"
+#include "Subsystems/WarriorTelemetrySubsystem.h"
+#include "Subsystems/WarriorInputLatencySubsystem.h"
+
+FActiveGameplayEffectHandle UWarriorAbilitySystemComponent::ApplyGameplayEffectSpecToSelf(const FGameplayEffectSpec& GameplayEffect, FPredictionKey PredictionKey)
+{
+	INC_DWORD_STAT(STAT_Warrior_GameplayEffectsApplied);
+
+	return Super::ApplyGameplayEffectSpecToSelf(GameplayEffect, PredictionKey);
+}
+
+float UWarriorAbilitySystemComponent::PlayMontage(UGameplayAbility* AnimatingAbility, FGameplayAbilityActivationInfo ActivationInfo, UAnimMontage* Montage, float InPlayRate, FName StartSectionName, float StartTimeSeconds)
+{
+	const float Duration = Super::PlayMontage(AnimatingAbility, ActivationInfo, Montage, InPlayRate, StartSectionName, StartTimeSeconds);
+
+	if (Duration > 0.f)
+	{
+		UWarriorInputLatencySubsystem::MarkMontageStarted(GetAvatarActor(), AnimatingAbility);
+	}
+
+	return Duration;
+}
+
+void UWarriorAbilitySystemComponent::NotifyAbilityActivated(const FGameplayAbilitySpecHandle Handle, UGameplayAbility* Ability)
+{
+	// Runs from inside the activation, before the ability gets to start its montage.
+	if (bIsActivatingFromInput)
+	{
+		UWarriorInputLatencySubsystem::MarkAbilityActivated(GetAvatarActor(), Ability);
+	}
+
+	Super::NotifyAbilityActivated(Handle, Ability);
+}
+
+UGameplayAbility* UWarriorAbilitySystemComponent::CreateNewInstanceOfAbility(FGameplayAbilitySpec& Spec, const UGameplayAbility* Ability)
+{
+	LLM_SCOPE_BYTAG(Warrior_Abilities);
+	WARRIOR_HITCH_SCOPE(AbilityActivation);
+
+	return Super::CreateNewInstanceOfAbility(Spec, Ability);
+}
 
 void UWarriorAbilitySystemComponent::OnAbilityInputPressed(const FGameplayTag& InInputTag)
 {
@@ -16,9 +57,14 @@ void UWarriorAbilitySystemComponent::OnAbilityInputPressed(const FGameplayTag& I
 		if (!AbilitySpec.DynamicAbilityTags.HasTagExact(InInputTag)) continue;
 		
 		if (InInputTag.MatchesTag(WarriorGameplayTags::InputTag_Toggleable) && AbilitySpec.IsActive())
+		{
 			CancelAbilityHandle(AbilitySpec.Handle);
+		}
 		else
+		{
+			TGuardValue<bool> ActivatingFromInputGuard(bIsActivatingFromInput, true);
 			TryActivateAbility(AbilitySpec.Handle);
+		}
 	}
 }
 
@@ -40,11 +86,15 @@ void UWarriorAbilitySystemComponent::OnAbilityInputReleased(const FGameplayTag&
 
 void UWarriorAbilitySystemComponent::GrantHeroWeaponAbilities(const TArray<FWarriorHeroAbilitySet>& InDefaultWeaponAbilities, const TArray<FWarriorHeroSpecialAbilitySet>& InSpecialWeaponAbilities, int32 ApplyLevel, TArray<FGameplayAbilitySpecHandle>& OutGrantedAbilitySpecHandles)
 {
+	LLM_SCOPE_BYTAG(Warrior_Abilities);
+
 	if (InDefaultWeaponAbilities.IsEmpty())
 	{
 		return;
 	}
 
+	UWarriorTelemetrySubsystem::RecordMarker(GetAvatarActor(), EWarriorTelemetryMarker::WeaponEquipped, InDefaultWeaponAbilities.Num() + InSpecialWeaponAbilities.Num());
+
 	for (const FWarriorHeroAbilitySet& AbilitySet : InDefaultWeaponAbilities)
 	{
 		if (!AbilitySet.IsValid()) continue;
@@ -77,6 +127,8 @@ void UWarriorAbilitySystemComponent::RemovedGrantedHeroWeaponAbilities(UPARAM(re
 		return;
 	}
 
+	UWarriorTelemetrySubsystem::RecordMarker(GetAvatarActor(), EWarriorTelemetryMarker::WeaponUnequipped, InSpecHandlesToRemove.Num());
+
 	for (const FGameplayAbilitySpecHandle& SpecHandle : InSpecHandlesToRemove)
 	{
 		if (SpecHandle.IsValid())
@@ -110,3 +162,60 @@ bool UWarriorAbilitySystemComponent::TryActivateAbilityByTag(FGameplayTag Abilit
 
 	return false;
 }
+
+void UWarriorAbilitySystemComponent::GetRemainingCooldownsByParentTag(const FGameplayTag& InCooldownParentTag, TMap<FGameplayTag, float>& OutRemainingCooldowns) const
+{
+	const FGameplayEffectQuery CooldownQuery = FGameplayEffectQuery::MakeQuery_MatchAnyOwningTags(InCooldownParentTag.GetSingleTagContainer());
+	const float WorldTime = GetWorld()->GetTimeSeconds();
+
+	for (const FActiveGameplayEffectHandle& EffectHandle : GetActiveEffects(CooldownQuery))
+	{
+		const FActiveGameplayEffect* ActiveEffect = GetActiveGameplayEffect(EffectHandle);
+
+		if (!ActiveEffect) continue;
+
+		const float RemainingTime = ActiveEffect->GetTimeRemaining(WorldTime);
+
+		FGameplayTagContainer GrantedTags;
+		ActiveEffect->Spec.GetAllGrantedTags(GrantedTags);
+
+		for (const FGameplayTag& GrantedTag : GrantedTags)
+		{
+			if (!GrantedTag.MatchesTag(InCooldownParentTag)) continue;
+
+			float& FoundRemainingTime = OutRemainingCooldowns.FindOrAdd(GrantedTag);
+			FoundRemainingTime = FMath::Max(FoundRemainingTime, RemainingTime);
+		}
+	}
+}
+
+bool UWarriorAbilitySystemComponent::RestoreCooldownByTag(const FGameplayTag& InCooldownTag, float InRemainingTime)
+{
+	if (!InCooldownTag.IsValid() || InRemainingTime <= 0.f)
+	{
+		return false;
+	}
+
+	for (const FGameplayAbilitySpec& AbilitySpec : GetActivatableAbilities())
+	{
+		if (!AbilitySpec.Ability) continue;
+
+		const FGameplayTagContainer* CooldownTags = AbilitySpec.Ability->GetCooldownTags();
+		UGameplayEffect* CooldownEffect = AbilitySpec.Ability->GetCooldownGameplayEffect();
+
+		if (!CooldownTags || !CooldownEffect || !CooldownTags->HasTagExact(InCooldownTag)) continue;
+
+		FGameplayEffectSpecHandle CooldownSpecHandle = MakeOutgoingSpec(CooldownEffect->GetClass(), AbilitySpec.Level, MakeEffectContext());
+
+		if (!CooldownSpecHandle.IsValid())
+		{
+			return false;
+		}
+
+		CooldownSpecHandle.Data->SetDuration(InRemainingTime, true);
+
+		return ApplyGameplayEffectSpecToSelf(*CooldownSpecHandle.Data.Get()).IsValid();
+	}
+
+	return false;
+}
@@ -8,6 +8,7 @@
 #include "Interfaces/PawnUIInterface.h"
 #include "Components/UI/PawnUIComponent.h"
 #include "Components/UI/HeroUIComponent.h"
+#include "WarriorStats.h"
 
 #include "WarriorDebugHelper.h"
 
@@ -23,6 +24,9 @@ UWarriorAttributeSet::UWarriorAttributeSet()
 
 void UWarriorAttributeSet::PostGameplayEffectExecute(const FGameplayEffectModCallbackData& Data)
 {
+	SCOPE_CYCLE_COUNTER(STAT_Warrior_AttributePostExecute);
+	WARRIOR_HITCH_SCOPE(DamageResolution);
+
 	if (!CachedPawnUIInterface.IsValid())
 	{
 		CachedPawnUIInterface = TWeakInterfacePtr<IPawnUIInterface>(Data.Target.GetAvatarActor());
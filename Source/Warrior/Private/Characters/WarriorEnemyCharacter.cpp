@@ -2,7 +2,10 @@
 
 
 #include "Characters/WarriorEnemyCharacter.h"
+#include "HAL/IConsoleManager.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "Kismet/GameplayStatics.h"
+#include "TimerManager.h"
 #include "Components/Combat/EnemyCombatComponent.h"
 #include "Engine/AssetManager.h"
 #include "DataAssets/StartUpData/DataAsset_EnemyStartUpDataBase.h"
@@ -12,11 +15,36 @@
 #include "Components/BoxComponent.h"
 #include "WarriorFunctionLibrary.h"
 #include "GameModes/WarriorGameMode.h"
+#include "AbilitySystem/WarriorAbilitySystemComponent.h"
+#include "AbilitySystem/WarriorAttributeSet.h"
+#include "WarriorStats.h"
 
 #include "WarriorDebugHelper.h"
 
+static TAutoConsoleVariable<int32> CVarWarriorEnemyLeanComponents(
+	TEXT("Warrior.Enemy.LeanComponents"),
+	-1,
+	TEXT("-1 follows bUseLeanComponents of each enemy Blueprint, 0 keeps every component of every enemy registered, 1 makes every enemy lean. Read when an enemy spawns."));
+
+static TAutoConsoleVariable<float> CVarWarriorEnemyHealthWidgetDistance(
+	TEXT("Warrior.Enemy.HealthWidgetDistance"),
+	2500.f,
+	TEXT("Lean enemies show their health bar while hurt and closer than this to the hero."));
+
+static TAutoConsoleVariable<float> CVarWarriorEnemyHealthWidgetHideDistance(
+	TEXT("Warrior.Enemy.HealthWidgetHideDistance"),
+	3000.f,
+	TEXT("Lean enemies hide their health bar again once the hero is further than this. Kept above HealthWidgetDistance so the bar does not flicker at the edge."));
+
+static TAutoConsoleVariable<float> CVarWarriorEnemyHealthWidgetInterval(
+	TEXT("Warrior.Enemy.HealthWidgetInterval"),
+	0.25f,
+	TEXT("Seconds between health bar distance checks of a hurt lean enemy."));
+
 AWarriorEnemyCharacter::AWarriorEnemyCharacter()
 {
+	LLM_SCOPE_BYTAG(Warrior_Enemies);
+
 	AutoPossessAI = EAutoPossessAI::PlacedInWorldOrSpawned;
 
 	bUseControllerRotationPitch = false;
@@ -59,19 +87,151 @@ UPawnUIComponent* AWarriorEnemyCharacter::GetPawnUIComponent() const
 
 void AWarriorEnemyCharacter::BeginPlay()
 {
+	LLM_SCOPE_BYTAG(Warrior_Enemies);
+
+	if (!bLeanComponentsActive)
+	{
+		// Create the health bar here rather than inside the component so it is counted as a widget, not as the enemy.
+		LLM_SCOPE_BYTAG(Warrior_Widgets);
+		WARRIOR_HITCH_SCOPE(WidgetCreation);
+		EnemyHealthWidgetComponent->InitWidget();
+	}
+
 	Super::BeginPlay();
 
-	if (UWarriorWidgetBase* HealthWidget = Cast<UWarriorWidgetBase>(EnemyHealthWidgetComponent->GetUserWidgetObject()))
+	INC_DWORD_STAT(STAT_Warrior_AliveEnemies);
+
+	if (bLeanComponentsActive)
+	{
+		EnemyUIComponent->OnCurrentHealthChanged.AddUniqueDynamic(this, &ThisClass::OnLeanHealthChanged);
+	}
+	else if (UWarriorWidgetBase* HealthWidget = Cast<UWarriorWidgetBase>(EnemyHealthWidgetComponent->GetUserWidgetObject()))
 	{
 		HealthWidget->InitEnemyCreatedWidget(this);
 	}
 }
 
+void AWarriorEnemyCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	DEC_DWORD_STAT(STAT_Warrior_AliveEnemies);
+
+	if (bLeanComponentsActive && EnemyHealthWidgetComponent->IsRegistered())
+	{
+		DEC_DWORD_STAT(STAT_Warrior_EnemyHealthBarsShown);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AWarriorEnemyCharacter::PreRegisterAllComponents()
+{
+	Super::PreRegisterAllComponents();
+
+	const int32 LeanComponentsOverride = CVarWarriorEnemyLeanComponents.GetValueOnGameThread();
+	const UWorld* World = GetWorld();
+
+	// Editor previews keep everything registered so the hit boxes and the health bar can still be placed.
+	bLeanComponentsActive = World && World->IsGameWorld() && (LeanComponentsOverride < 0 ? bUseLeanComponents : LeanComponentsOverride > 0);
+
+	LeftHandHitBoxComponent->bAutoRegister = !bLeanComponentsActive;
+	RightHandHitBoxComponent->bAutoRegister = !bLeanComponentsActive;
+	EnemyHealthWidgetComponent->bAutoRegister = !bLeanComponentsActive;
+}
+
 UEnemyUIComponent* AWarriorEnemyCharacter::GetEnemyUIComponent() const
 {
 	return EnemyUIComponent;
 }
 
+void AWarriorEnemyCharacter::RestoreHealthPercent(float InHealthPercent)
+{
+	PendingRestoredHealthPercent = FMath::Clamp(InHealthPercent, 0.f, 1.f);
+
+	if (bEnemyStartUpDataGranted)
+	{
+		ApplyRestoredHealthPercent();
+	}
+}
+
+void AWarriorEnemyCharacter::ApplyRestoredHealthPercent()
+{
+	if (!PendingRestoredHealthPercent.IsSet())
+	{
+		return;
+	}
+
+	// Never restore an enemy straight into its death.
+	const float RestoredHealth = FMath::Max(WarriorAttributeSet->GetMaxHealth() * PendingRestoredHealthPercent.GetValue(), 1.f);
+
+	WarriorAbilitySystemComponent->SetNumericAttributeBase(UWarriorAttributeSet::GetCurrentHealthAttribute(), RestoredHealth);
+
+	EnemyUIComponent->OnCurrentHealthChanged.Broadcast(RestoredHealth / WarriorAttributeSet->GetMaxHealth());
+
+	PendingRestoredHealthPercent.Reset();
+}
+
+void AWarriorEnemyCharacter::SetHandCollisionBoxEnabled(UBoxComponent* InCollisionBox, bool bShouldEnable)
+{
+	check(InCollisionBox);
+
+	if (bShouldEnable && !InCollisionBox->IsRegistered())
+	{
+		InCollisionBox->RegisterComponent();
+	}
+
+	InCollisionBox->SetCollisionEnabled(bShouldEnable ? ECollisionEnabled::QueryOnly : ECollisionEnabled::NoCollision);
+
+	if (!bShouldEnable && bLeanComponentsActive && InCollisionBox->IsRegistered())
+	{
+		InCollisionBox->UnregisterComponent();
+	}
+}
+
+void AWarriorEnemyCharacter::CreateHealthWidget()
+{
+	{
+		LLM_SCOPE_BYTAG(Warrior_Widgets);
+		WARRIOR_HITCH_SCOPE(WidgetCreation);
+		EnemyHealthWidgetComponent->InitWidget();
+	}
+
+	if (UWarriorWidgetBase* HealthWidget = Cast<UWarriorWidgetBase>(EnemyHealthWidgetComponent->GetUserWidgetObject()))
+	{
+		HealthWidget->InitEnemyCreatedWidget(this);
+	}
+}
+
+void AWarriorEnemyCharacter::SetHealthWidgetShown(bool bShouldShow)
+{
+	if (EnemyHealthWidgetComponent->IsRegistered() == bShouldShow)
+	{
+		return;
+	}
+
+	if (!bShouldShow)
+	{
+		EnemyHealthWidgetComponent->UnregisterComponent();
+		DEC_DWORD_STAT(STAT_Warrior_EnemyHealthBarsShown);
+		return;
+	}
+
+	const bool bIsWidgetCreated = EnemyHealthWidgetComponent->GetUserWidgetObject() != nullptr;
+
+	if (!bIsWidgetCreated)
+	{
+		CreateHealthWidget();
+	}
+
+	EnemyHealthWidgetComponent->RegisterComponent();
+	INC_DWORD_STAT(STAT_Warrior_EnemyHealthBarsShown);
+
+	if (!bIsWidgetCreated)
+	{
+		// The new widget missed every change so far. The broadcast comes back through OnLeanHealthChanged, which finds the bar already shown.
+		EnemyUIComponent->OnCurrentHealthChanged.Broadcast(LeanHealthPercent);
+	}
+}
+
 void AWarriorEnemyCharacter::PossessedBy(AController* NewController)
 {
 	Super::PossessedBy(NewController);
@@ -95,11 +255,56 @@ void AWarriorEnemyCharacter::PostEditChangeProperty(FPropertyChangedEvent& Prope
 
 void AWarriorEnemyCharacter::OnBodyCollisionBoxBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
+	INC_DWORD_STAT(STAT_Warrior_MeleeOverlaps);
+
 	if (APawn* HitPawn = Cast<APawn>(OtherActor))
 		if (UWarriorFunctionLibrary::IsTargetPawnHostile(this, HitPawn))
 			EnemyCombatComponent->OnHitTargetActor(HitPawn);
 }
 
+void AWarriorEnemyCharacter::OnLeanHealthChanged(float NewPercent)
+{
+	LeanHealthPercent = NewPercent;
+
+	UpdateLeanHealthWidget();
+
+	const bool bIsHurt = LeanHealthPercent > 0.f && LeanHealthPercent < 1.f;
+	FTimerManager& TimerManager = GetWorldTimerManager();
+
+	if (bIsHurt && !TimerManager.IsTimerActive(LeanHealthWidgetTimerHandle))
+	{
+		TimerManager.SetTimer(LeanHealthWidgetTimerHandle, this, &ThisClass::UpdateLeanHealthWidget, FMath::Max(CVarWarriorEnemyHealthWidgetInterval.GetValueOnGameThread(), 0.01f), true);
+	}
+	else if (!bIsHurt)
+	{
+		TimerManager.ClearTimer(LeanHealthWidgetTimerHandle);
+	}
+}
+
+void AWarriorEnemyCharacter::UpdateLeanHealthWidget()
+{
+	const bool bIsHurt = LeanHealthPercent > 0.f && LeanHealthPercent < 1.f;
+	const APawn* Hero = UGameplayStatics::GetPlayerPawn(this, 0);
+	const float DistanceSquared = Hero ? FVector::DistSquared(Hero->GetActorLocation(), GetActorLocation()) : TNumericLimits<float>::Max();
+
+	const float ShowDistance = CVarWarriorEnemyHealthWidgetDistance.GetValueOnGameThread();
+	const float HideDistance = FMath::Max(CVarWarriorEnemyHealthWidgetHideDistance.GetValueOnGameThread(), ShowDistance);
+
+	// Between the two distances the bar keeps whatever state it is in, registering and unregistering it rebuilds its renderer.
+	bool bShouldShow = EnemyHealthWidgetComponent->IsRegistered();
+
+	if (!bIsHurt || DistanceSquared > FMath::Square(HideDistance))
+	{
+		bShouldShow = false;
+	}
+	else if (DistanceSquared < FMath::Square(ShowDistance))
+	{
+		bShouldShow = true;
+	}
+
+	SetHealthWidgetShown(bShouldShow);
+}
+
 void AWarriorEnemyCharacter::InitEnemyStartUpData()
 {
 	if (CharacterStartUpData.IsNull())
@@ -134,7 +339,8 @@ void AWarriorEnemyCharacter::InitEnemyStartUpData()
 		}
 	}
 
-	UAssetManager::GetStreamableManager().RequestAsyncLoad(
+	WarriorStats::RequestTrackedAsyncLoad(
+		UAssetManager::GetStreamableManager(),
 		CharacterStartUpData.ToSoftObjectPath(),
 		FStreamableDelegate::CreateLambda(
 			[this, AbilityCurrentLevel]()
@@ -143,7 +349,10 @@ void AWarriorEnemyCharacter::InitEnemyStartUpData()
 				{
 					LoadedData->GiveToAbilitySystemComponent(WarriorAbilitySystemComponent, AbilityCurrentLevel);
 
-					Debug::Print(TEXT("Enemy Start Up Data Loaded"), FColor::Green);
+					bEnemyStartUpDataGranted = true;
+					ApplyRestoredHealthPercent();
+
+					WARRIOR_LOG(Verbose, TEXT("%s: enemy start up data granted"), *GetName());
 				}
 			}
 		)
@@ -16,6 +16,12 @@
 #include "Components/UI/HeroUIComponent.h"
 #include "AbilitySystemBlueprintLibrary.h"
 #include "GameModes/WarriorGameMode.h"
+#include "GameInstance/WarriorGameInstance.h"
+#include "Engine/AssetManager.h"
+#include "AbilitySystem/WarriorAttributeSet.h"
+#include "WarriorFunctionLibrary.h"
+#include "WarriorStats.h"
+#include "Subsystems/WarriorInputLatencySubsystem.h"
 
 #include "WarriorDebugHelper.h"
 
@@ -86,6 +92,13 @@ void AWarriorHeroCharacter::Input_PickupStonesStarted(const FInputActionValue& I
 
 void AWarriorHeroCharacter::Input_AbilityInputPressed(FGameplayTag InInputTag)
 {
+	if (!bHeroStartUpDataGranted)
+	{
+		return;
+	}
+
+	UWarriorInputLatencySubsystem::MarkInputPressed(this, InInputTag);
+
 	WarriorAbilitySystemComponent->OnAbilityInputPressed(InInputTag);
 }
 
@@ -141,43 +154,169 @@ void AWarriorHeroCharacter::PossessedBy(AController* NewController)
 {
 	Super::PossessedBy(NewController);
 
-	if (!CharacterStartUpData.IsNull())
+	if (CharacterStartUpData.IsNull() || bHeroStartUpDataGranted)
+	{
+		return;
+	}
+
+	PossessedTimeSeconds = FPlatformTime::Seconds();
+
+	if (!AWarriorGamemode::ShouldPreLoadHeroStartUpData())
+	{
+		CharacterStartUpData.LoadSynchronous();
+		InitHeroStartUpData();
+		return;
+	}
+
+	// The game mode starts streaming the hero start up data in InitGame, so it is normally resident by now.
+	if (CharacterStartUpData.Get())
+	{
+		InitHeroStartUpData();
+		return;
+	}
+
+	StartUpDataStreamableHandle = WarriorStats::RequestTrackedAsyncLoad(
+		UAssetManager::GetStreamableManager(),
+		CharacterStartUpData.ToSoftObjectPath(),
+		FStreamableDelegate::CreateUObject(this, &ThisClass::InitHeroStartUpData),
+		FStreamableManager::AsyncLoadHighPriority
+	);
+}
+
+void AWarriorHeroCharacter::InitHeroStartUpData()
+{
+	UDataAsset_StartupDataBase* LoadedData = CharacterStartUpData.Get();
+
+	if (!LoadedData || bHeroStartUpDataGranted)
 	{
-		if (UDataAsset_StartupDataBase* LoadedData = CharacterStartUpData.LoadSynchronous())
+		return;
+	}
+
+	int32 AbilityCurrentLevel = 1;
+
+	if (AWarriorGamemode* CurrentGamemode = GetWorld()->GetAuthGameMode<AWarriorGamemode>())
+	{
+		switch (CurrentGamemode->GetCurrentGameDifficulty())
 		{
-			int32 AbilityCurrentLevel = 1;
-
-			if (AWarriorGamemode* CurrentGamemode = GetWorld()->GetAuthGameMode<AWarriorGamemode>())
-			{
-				switch (CurrentGamemode->GetCurrentGameDifficulty())
-				{
-				case EWarriorGameplayDifficulty::Easy:
-					AbilityCurrentLevel = 4;
-					Debug::Print(TEXT("Current Difficulty: Easy"));
-					break;
-
-				case EWarriorGameplayDifficulty::Normal:
-					AbilityCurrentLevel = 3;
-					Debug::Print(TEXT("Current Difficulty: Normal"));
-					break;
-
-				case EWarriorGameplayDifficulty::Hard:
-					AbilityCurrentLevel = 2;
-					Debug::Print(TEXT("Current Difficulty: Hard"));
-					break;
-
-				case EWarriorGameplayDifficulty::VeryHard:
-					AbilityCurrentLevel = 1;
-					Debug::Print(TEXT("Current Difficulty: Very Hard"));
-					break;
-
-				default:
-					break;
-				}
-			}
-
-			LoadedData->GiveToAbilitySystemComponent(WarriorAbilitySystemComponent, AbilityCurrentLevel);
+		case EWarriorGameplayDifficulty::Easy:
+			AbilityCurrentLevel = 4;
+			break;
+
+		case EWarriorGameplayDifficulty::Normal:
+			AbilityCurrentLevel = 3;
+			break;
+
+		case EWarriorGameplayDifficulty::Hard:
+			AbilityCurrentLevel = 2;
+			break;
+
+		case EWarriorGameplayDifficulty::VeryHard:
+			AbilityCurrentLevel = 1;
+			break;
+
+		default:
+			break;
 		}
+
+		WARRIOR_LOG(Log, TEXT("Current Difficulty: %s"), *StaticEnum<EWarriorGameplayDifficulty>()->GetNameStringByValue(static_cast<int64>(CurrentGamemode->GetCurrentGameDifficulty())));
+	}
+
+	LoadedData->GiveToAbilitySystemComponent(WarriorAbilitySystemComponent, AbilityCurrentLevel);
+
+	bHeroStartUpDataGranted = true;
+	StartUpDataStreamableHandle.Reset();
+
+	WARRIOR_LOG(Log, TEXT("%s: start up data granted %.2f ms after possession"), *GetName(), (FPlatformTime::Seconds() - PossessedTimeSeconds) * 1000.0);
+
+	if (UWarriorGameInstance* WarriorGameInstance = IsPlayerControlled() ? GetGameInstance<UWarriorGameInstance>() : nullptr)
+	{
+		WarriorGameInstance->NotifyHeroReadyForInput();
+	}
+
+	if (PendingSessionSnapshot.IsSet())
+	{
+		ApplySessionSnapshot(PendingSessionSnapshot.GetValue());
+		PendingSessionSnapshot.Reset();
+	}
+}
+
+void AWarriorHeroCharacter::CaptureSessionSnapshot(FWarriorHeroSnapshot& OutHeroSnapshot) const
+{
+	OutHeroSnapshot.Location = GetActorLocation();
+	OutHeroSnapshot.Yaw = GetActorRotation().Yaw;
+	OutHeroSnapshot.CurrentHealth = WarriorAttributeSet->GetCurrentHealth();
+	OutHeroSnapshot.CurrentRage = WarriorAttributeSet->GetCurrentRage();
+	OutHeroSnapshot.EquippedWeaponTag = HeroCombatComponent->CurrentEquippedWeaponTag;
+	OutHeroSnapshot.Cooldowns.Reset();
+
+	TMap<FGameplayTag, float> RemainingCooldowns;
+	WarriorAbilitySystemComponent->GetRemainingCooldownsByParentTag(WarriorGameplayTags::Player_Cooldown, RemainingCooldowns);
+
+	for (const TPair<FGameplayTag, float>& RemainingCooldown : RemainingCooldowns)
+	{
+		OutHeroSnapshot.Cooldowns.Add({ RemainingCooldown.Key, RemainingCooldown.Value });
+	}
+
+	OutHeroSnapshot.bIsValid = true;
+}
+
+void AWarriorHeroCharacter::RestoreFromSessionSnapshot(const FWarriorHeroSnapshot& InHeroSnapshot)
+{
+	if (!InHeroSnapshot.bIsValid)
+	{
+		return;
+	}
+
+	if (!bHeroStartUpDataGranted)
+	{
+		PendingSessionSnapshot = InHeroSnapshot;
+		return;
+	}
+
+	ApplySessionSnapshot(InHeroSnapshot);
+}
+
+void AWarriorHeroCharacter::ApplySessionSnapshot(const FWarriorHeroSnapshot& InHeroSnapshot)
+{
+	SetActorLocationAndRotation(InHeroSnapshot.Location, FRotator(0.f, InHeroSnapshot.Yaw, 0.f), false, nullptr, ETeleportType::TeleportPhysics);
+
+	if (Controller)
+	{
+		Controller->SetControlRotation(FRotator(0.f, InHeroSnapshot.Yaw, 0.f));
+	}
+
+	const float RestoredHealth = FMath::Clamp(InHeroSnapshot.CurrentHealth, 1.f, WarriorAttributeSet->GetMaxHealth());
+	const float RestoredRage = FMath::Clamp(InHeroSnapshot.CurrentRage, 0.f, WarriorAttributeSet->GetMaxRage());
+
+	WarriorAbilitySystemComponent->SetNumericAttributeBase(UWarriorAttributeSet::GetCurrentHealthAttribute(), RestoredHealth);
+	WarriorAbilitySystemComponent->SetNumericAttributeBase(UWarriorAttributeSet::GetCurrentRageAttribute(), RestoredRage);
+
+	// Setting the base value skips PostGameplayEffectExecute, so mirror what it would have done for rage and the UI.
+	UWarriorFunctionLibrary::RemoveGameplayTagFromActorIfFound(this, WarriorGameplayTags::Player_Status_Rage_Full);
+	UWarriorFunctionLibrary::RemoveGameplayTagFromActorIfFound(this, WarriorGameplayTags::Player_Status_Rage_None);
+
+	if (RestoredRage == WarriorAttributeSet->GetMaxRage())
+	{
+		UWarriorFunctionLibrary::AddGameplayTagToActorIfNone(this, WarriorGameplayTags::Player_Status_Rage_Full);
+	}
+	else if (RestoredRage == 0.f)
+	{
+		UWarriorFunctionLibrary::AddGameplayTagToActorIfNone(this, WarriorGameplayTags::Player_Status_Rage_None);
+	}
+
+	HeroUIComponent->OnCurrentHealthChanged.Broadcast(RestoredHealth / WarriorAttributeSet->GetMaxHealth());
+	HeroUIComponent->OnCurrentRageChanged.Broadcast(RestoredRage / WarriorAttributeSet->GetMaxRage());
+
+	// The axe is the only weapon the hero can equip, and equipping it has to go through its ability.
+	if (InHeroSnapshot.EquippedWeaponTag.MatchesTagExact(WarriorGameplayTags::Player_Weapon_Axe) &&
+		!HeroCombatComponent->CurrentEquippedWeaponTag.MatchesTagExact(WarriorGameplayTags::Player_Weapon_Axe))
+	{
+		WarriorAbilitySystemComponent->TryActivateAbilityByTag(WarriorGameplayTags::Player_Ability_Equip_Axe);
+	}
+
+	for (const FWarriorCooldownSnapshot& CooldownSnapshot : InHeroSnapshot.Cooldowns)
+	{
+		WarriorAbilitySystemComponent->RestoreCooldownByTag(CooldownSnapshot.CooldownTag, CooldownSnapshot.RemainingTime);
 	}
 }
 
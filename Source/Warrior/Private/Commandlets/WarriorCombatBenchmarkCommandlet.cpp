@@ -0,0 +1,459 @@
+// ALL FREE
+
+
+#include "Commandlets/WarriorCombatBenchmarkCommandlet.h"
+#include "Misc/FileHelper.h"
+#include "Engine/Engine.h"
+#include "GameplayEffect.h"
+#include "GameplayEffectExtension.h"
+#include "Characters/WarriorEnemyCharacter.h"
+#include "GameControllers/WarriorAIController.h"
+#include "GameControllers/WarriorHeroController.h"
+#include "AbilitySystem/WarriorAbilitySystemComponent.h"
+#include "AbilitySystem/WarriorAttributeSet.h"
+#include "AbilitySystem/GEExecuteCal/GEExecuteCal_DamageTaken.h"
+#include "WarriorFunctionLibrary.h"
+#include "WarriorGameplayTags.h"
+
+#include "WarriorDebugHelper.h"
+
+namespace WarriorCombatBenchmark
+{
+	/** Keeps the best of this many timed runs, so a background thread allocating or a context switch doesn't land in the results */
+	static constexpr int32 NumRepetitions = 3;
+
+	/**
+	 * Reads the call counters FMalloc keeps for the stats system, without installing anything as GMalloc.
+	 * Never instantiated, deriving is only how the protected counters can be reached.
+	 */
+	class FMallocCallCounts : public FMalloc
+	{
+	public:
+		static uint64 GetNumAllocations()
+		{
+#if STATS
+			return static_cast<uint64>(TotalMallocCalls) + static_cast<uint64>(TotalReallocCalls);
+#else
+			return 0;
+#endif
+		}
+
+		/** Not every allocator bumps the counters, so check one allocation shows up before trusting them */
+		static bool AreCounted()
+		{
+			const uint64 StartAllocations = GetNumAllocations();
+
+			FMemory::Free(FMemory::Malloc(64));
+
+			return GetNumAllocations() > StartAllocations;
+		}
+	};
+
+	static bool bAreAllocationsCounted = false;
+
+	/** Every op folds its result in here and Main logs it, so the optimizer cannot drop the calls */
+	static int32 GResultSink = 0;
+}
+
+UWarriorCombatBenchmarkCommandlet::UWarriorCombatBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UWarriorCombatBenchmarkCommandlet::Main(const FString& Params)
+{
+	using namespace WarriorCombatBenchmark;
+
+	FString ActorCountsParam = TEXT("1,16,128");
+	FParse::Value(*Params, TEXT("Actors="), ActorCountsParam, false);
+
+	int32 NumOps = 20000;
+	FParse::Value(*Params, TEXT("Ops="), NumOps);
+
+	float Tolerance = 0.25f;
+	FParse::Value(*Params, TEXT("Tolerance="), Tolerance);
+
+	FString BaselineFilePath = FPaths::ProjectDir() / TEXT("Build") / TEXT("Benchmarks") / TEXT("WarriorCombatBaseline.csv");
+	FParse::Value(*Params, TEXT("Baseline="), BaselineFilePath);
+
+	FString OutputFilePath = FPaths::ProjectSavedDir() / TEXT("Profiling") / TEXT("WarriorCombatBenchmark.csv");
+	FParse::Value(*Params, TEXT("Output="), OutputFilePath);
+
+	const bool bUpdateBaseline = FParse::Param(*Params, TEXT("UpdateBaseline"));
+
+	TSubclassOf<AWarriorBaseCharacter> PawnClass = AWarriorEnemyCharacter::StaticClass();
+	FString PawnClassPath;
+
+	if (FParse::Value(*Params, TEXT("Pawn="), PawnClassPath))
+	{
+		PawnClass = FSoftClassPath(PawnClassPath).TryLoadClass<AWarriorBaseCharacter>();
+
+		if (!PawnClass)
+		{
+			UE_LOG(LogWarrior, Error, TEXT("'%s' is not a Warrior character class"), *PawnClassPath);
+			return 1;
+		}
+	}
+
+	TArray<FString> ActorCountStrings;
+	ActorCountsParam.ParseIntoArray(ActorCountStrings, TEXT(","));
+
+	bAreAllocationsCounted = FMallocCallCounts::AreCounted();
+
+	if (!bAreAllocationsCounted)
+	{
+		UE_LOG(LogWarrior, Warning, TEXT("%s doesn't count its calls in this build, allocations/op are not measured"), GMalloc->GetDescriptiveName());
+	}
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("WarriorCombatBenchmarkWorld"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+
+	TArray<FBenchmarkResult> Results;
+
+	for (const FString& ActorCountString : ActorCountStrings)
+	{
+		const int32 NumActors = FCString::Atoi(*ActorCountString);
+
+		if (NumActors <= 0)
+		{
+			continue;
+		}
+
+		FCombatants Combatants = SpawnCombatants(World, PawnClass, NumActors);
+
+		RunBenchmarks(Combatants, FMath::Max(NumOps, 1), Results);
+
+		DestroyCombatants(Combatants);
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	if (!WriteCsv(bUpdateBaseline ? BaselineFilePath : OutputFilePath, Results))
+	{
+		UE_LOG(LogWarrior, Error, TEXT("Failed to write %s"), bUpdateBaseline ? *BaselineFilePath : *OutputFilePath);
+		return 1;
+	}
+
+	if (bUpdateBaseline)
+	{
+		UE_LOG(LogWarrior, Display, TEXT("Recorded %d combat benchmarks to %s"), Results.Num(), *BaselineFilePath);
+		return 0;
+	}
+
+	TMap<FString, FBenchmarkResult> Baseline;
+
+	// A missing baseline fails the gate, otherwise nothing would ever be compared.
+	if (!LoadBaseline(BaselineFilePath, Baseline))
+	{
+		UE_LOG(LogWarrior, Error, TEXT("No baseline at %s, run with -UpdateBaseline to record one"), *BaselineFilePath);
+		return 1;
+	}
+
+	int32 NumRegressions = 0;
+	int32 NumUnrecorded = 0;
+
+	for (const FBenchmarkResult& Result : Results)
+	{
+		const FBenchmarkResult* BaselineResult = Baseline.Find(GetBaselineKey(Result));
+
+		// New benchmarks and actor counts have nothing to regress against until the build machine records them.
+		if (!BaselineResult)
+		{
+			UE_LOG(LogWarrior, Warning, TEXT("%-40s x%-4d %10.1f ns/op %8.2f allocs/op, not in the baseline"), *Result.Name, Result.NumActors, Result.NsPerOp, Result.AllocsPerOp);
+
+			NumUnrecorded++;
+			continue;
+		}
+
+		if (IsRegression(Result, *BaselineResult, Tolerance))
+		{
+			UE_LOG(LogWarrior, Error, TEXT("%-40s x%-4d %10.1f ns/op %8.2f allocs/op, baseline %.1f ns/op %.2f allocs/op"),
+				*Result.Name, Result.NumActors, Result.NsPerOp, Result.AllocsPerOp, BaselineResult->NsPerOp, BaselineResult->AllocsPerOp);
+
+			NumRegressions++;
+		}
+		else
+		{
+			UE_LOG(LogWarrior, Display, TEXT("%-40s x%-4d %10.1f ns/op %8.2f allocs/op, baseline %.1f ns/op %.2f allocs/op"),
+				*Result.Name, Result.NumActors, Result.NsPerOp, Result.AllocsPerOp, BaselineResult->NsPerOp, BaselineResult->AllocsPerOp);
+		}
+	}
+
+	UE_LOG(LogWarrior, Verbose, TEXT("Result checksum %d"), GResultSink);
+
+	if (NumUnrecorded > 0)
+	{
+		UE_LOG(LogWarrior, Warning, TEXT("%d combat benchmarks are not in %s yet, run with -UpdateBaseline to record them"), NumUnrecorded, *BaselineFilePath);
+	}
+
+	UE_LOG(LogWarrior, Display, TEXT("Ran %d combat benchmarks, %d regressed past the baseline, results in %s"), Results.Num(), NumRegressions, *OutputFilePath);
+
+	return NumRegressions > 0 ? 1 : 0;
+}
+
+UWarriorCombatBenchmarkCommandlet::FCombatants UWarriorCombatBenchmarkCommandlet::SpawnCombatants(UWorld* InWorld, TSubclassOf<AWarriorBaseCharacter> InPawnClass, int32 InNumActors)
+{
+	FCombatants Combatants;
+
+	// Fixed seed, every run measures the same layout of attackers and targets.
+	FRandomStream RandomStream(InNumActors);
+
+	for (int32 ActorIndex = 0; ActorIndex < InNumActors * 2; ActorIndex++)
+	{
+		const bool bIsAttacker = ActorIndex < InNumActors;
+		const FTransform SpawnTransform(
+			FRotator(0.f, RandomStream.FRandRange(-180.f, 180.f), 0.f),
+			FVector(RandomStream.FRandRange(-5000.f, 5000.f), RandomStream.FRandRange(-5000.f, 5000.f), 0.f)
+		);
+
+		AWarriorBaseCharacter* Character = InWorld->SpawnActorDeferred<AWarriorBaseCharacter>(InPawnClass, SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+		Character->AutoPossessAI = EAutoPossessAI::Disabled;
+		Character->FinishSpawning(SpawnTransform);
+
+		// The hero and AI controllers put the two sides on different teams, which is what the hostility check reads.
+		AController* Controller = bIsAttacker
+			? static_cast<AController*>(InWorld->SpawnActor<AWarriorHeroController>())
+			: static_cast<AController*>(InWorld->SpawnActor<AWarriorAIController>());
+
+		Controller->Possess(Character);
+
+		UWarriorAbilitySystemComponent* ASC = Character->GetWarriorAbilitySystemComponent();
+		ASC->SetNumericAttributeBase(UWarriorAttributeSet::GetMaxHealthAttribute(), 1.e9f);
+		ASC->SetNumericAttributeBase(UWarriorAttributeSet::GetCurrentHealthAttribute(), 1.e9f);
+		ASC->SetNumericAttributeBase(UWarriorAttributeSet::GetDamageTakenAttribute(), 1.f);
+
+		(bIsAttacker ? Combatants.Attackers : Combatants.Targets).Add(Character);
+	}
+
+	return Combatants;
+}
+
+void UWarriorCombatBenchmarkCommandlet::DestroyCombatants(FCombatants& InCombatants)
+{
+	for (TArray<AWarriorBaseCharacter*>* Characters : { &InCombatants.Attackers, &InCombatants.Targets })
+	{
+		for (AWarriorBaseCharacter* Character : *Characters)
+		{
+			AController* Controller = Character->GetController();
+
+			Character->Destroy();
+
+			if (Controller)
+			{
+				Controller->Destroy();
+			}
+		}
+
+		Characters->Reset();
+	}
+}
+
+void UWarriorCombatBenchmarkCommandlet::RunBenchmarks(const FCombatants& InCombatants, int32 InNumOps, TArray<FBenchmarkResult>& OutResults)
+{
+	using namespace WarriorCombatBenchmark;
+
+	const TArray<AWarriorBaseCharacter*>& Attackers = InCombatants.Attackers;
+	const TArray<AWarriorBaseCharacter*>& Targets = InCombatants.Targets;
+	const int32 NumActors = Targets.Num();
+
+	UGameplayEffect* DamageEffect = NewObject<UGameplayEffect>(GetTransientPackage(), TEXT("WarriorBenchmarkDamageEffect"));
+	DamageEffect->DurationPolicy = EGameplayEffectDurationType::Instant;
+	DamageEffect->Executions.AddDefaulted_GetRef().CalculationClass = UGEExecuteCal_DamageTaken::StaticClass();
+
+	TArray<FGameplayEffectSpecHandle> DamageSpecHandles;
+	TArray<FGameplayEffectSpec> CapturedDamageSpecs;
+
+	for (int32 ActorIndex = 0; ActorIndex < NumActors; ActorIndex++)
+	{
+		UWarriorAbilitySystemComponent* SourceASC = Attackers[ActorIndex]->GetWarriorAbilitySystemComponent();
+
+		FGameplayEffectSpecHandle SpecHandle(new FGameplayEffectSpec(DamageEffect, SourceASC->MakeEffectContext(), 1.f));
+		SpecHandle.Data->SetSetByCallerMagnitude(WarriorGameplayTags::Shared_SetByCaller_BaseDamage, 1.f);
+		SpecHandle.Data->SetSetByCallerMagnitude(WarriorGameplayTags::Player_SetByCaller_AttackType_Light, 2.f);
+
+		DamageSpecHandles.Add(SpecHandle);
+
+		// Applying a spec captures the target attributes first, the execution on its own needs that done up front.
+		FGameplayEffectSpec& CapturedDamageSpec = CapturedDamageSpecs.Add_GetRef(*SpecHandle.Data);
+		CapturedDamageSpec.CaptureAttributeDataFromTarget(Targets[ActorIndex]->GetWarriorAbilitySystemComponent());
+	}
+
+	const TArray<FGameplayEffectExecutionScopedModifierInfo> NoScopedModifiers;
+
+	OutResults.Add(Measure(TEXT("GEExecuteCal_DamageTaken"), NumActors, InNumOps,
+		[&](int32 OpIndex)
+		{
+			const int32 ActorIndex = OpIndex % NumActors;
+
+			FGameplayEffectCustomExecutionParameters ExecutionParams(CapturedDamageSpecs[ActorIndex], NoScopedModifiers, Targets[ActorIndex]->GetWarriorAbilitySystemComponent(), FGameplayTagContainer(), FPredictionKey());
+			FGameplayEffectCustomExecutionOutput ExecutionOutput;
+
+			GetDefault<UGEExecuteCal_DamageTaken>()->Execute_Implementation(ExecutionParams, ExecutionOutput);
+
+			GResultSink += ExecutionOutput.GetOutputModifiersRef().Num();
+		}
+	));
+
+	OutResults.Add(Measure(TEXT("ComputeHitReactDirectionTag"), NumActors, InNumOps,
+		[&](int32 OpIndex)
+		{
+			float AngleDifference = 0.f;
+
+			GResultSink += UWarriorFunctionLibrary::ComputeHitReactDirectionTag(Attackers[OpIndex % NumActors], Targets[OpIndex % NumActors], AngleDifference).IsValid();
+		}
+	));
+
+	OutResults.Add(Measure(TEXT("IsValidBlock"), NumActors, InNumOps,
+		[&](int32 OpIndex)
+		{
+			GResultSink += UWarriorFunctionLibrary::IsValidBlock(Attackers[OpIndex % NumActors], Targets[OpIndex % NumActors]);
+		}
+	));
+
+	OutResults.Add(Measure(TEXT("IsTargetPawnHostile"), NumActors, InNumOps,
+		[&](int32 OpIndex)
+		{
+			GResultSink += UWarriorFunctionLibrary::IsTargetPawnHostile(Attackers[OpIndex % NumActors], Targets[OpIndex % NumActors]);
+		}
+	));
+
+	OutResults.Add(Measure(TEXT("NativeDoesActorHaveTag"), NumActors, InNumOps,
+		[&](int32 OpIndex)
+		{
+			GResultSink += UWarriorFunctionLibrary::NativeDoesActorHaveTag(Targets[OpIndex % NumActors], WarriorGameplayTags::Shared_Status_Dead);
+		}
+	));
+
+	OutResults.Add(Measure(TEXT("ApplyGameplayEffectSpecHandleToTargetActor"), NumActors, InNumOps,
+		[&](int32 OpIndex)
+		{
+			const int32 ActorIndex = OpIndex % NumActors;
+
+			GResultSink += UWarriorFunctionLibrary::ApplyGameplayEffectSpecHandleToTargetActor(Attackers[ActorIndex], Targets[ActorIndex], DamageSpecHandles[ActorIndex]);
+		}
+	));
+
+	FGameplayModifierEvaluatedData DamageTakenEvaluatedData(UWarriorAttributeSet::GetDamageTakenAttribute(), EGameplayModOp::Override, 1.f);
+
+	OutResults.Add(Measure(TEXT("WarriorAttributeSet::PostGameplayEffectExecute"), NumActors, InNumOps,
+		[&](int32 OpIndex)
+		{
+			const int32 ActorIndex = OpIndex % NumActors;
+
+			FGameplayEffectModCallbackData CallbackData(*DamageSpecHandles[ActorIndex].Data, DamageTakenEvaluatedData, *Targets[ActorIndex]->GetWarriorAbilitySystemComponent());
+
+			// Protected on the Warrior attribute set, public on the base.
+			UAttributeSet* TargetAttributeSet = Targets[ActorIndex]->GetWarriorAttributeSet();
+			TargetAttributeSet->PostGameplayEffectExecute(CallbackData);
+		}
+	));
+}
+
+UWarriorCombatBenchmarkCommandlet::FBenchmarkResult UWarriorCombatBenchmarkCommandlet::Measure(const TCHAR* InName, int32 InNumActors, int32 InNumOps, TFunctionRef<void(int32)> InOp)
+{
+	using namespace WarriorCombatBenchmark;
+
+	// Warms caches and lets lazily built GAS data, like the capture definitions, get created outside the timed loop.
+	for (int32 OpIndex = 0; OpIndex < FMath::Max(InNumOps / 10, InNumActors); OpIndex++)
+	{
+		InOp(OpIndex);
+	}
+
+	FBenchmarkResult Result;
+	Result.Name = InName;
+	Result.NumActors = InNumActors;
+	Result.NsPerOp = TNumericLimits<double>::Max();
+	Result.AllocsPerOp = bAreAllocationsCounted ? TNumericLimits<double>::Max() : -1.0;
+
+	for (int32 Repetition = 0; Repetition < NumRepetitions; Repetition++)
+	{
+		// The counters are process wide, the commandlet world has no other gameplay running and the best repetition drops stray worker allocations.
+		const uint64 StartAllocations = FMallocCallCounts::GetNumAllocations();
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+
+		for (int32 OpIndex = 0; OpIndex < InNumOps; OpIndex++)
+		{
+			InOp(OpIndex);
+		}
+
+		const uint64 EndCycles = FPlatformTime::Cycles64();
+		const uint64 EndAllocations = FMallocCallCounts::GetNumAllocations();
+
+		Result.NsPerOp = FMath::Min(Result.NsPerOp, FPlatformTime::ToSeconds64(EndCycles - StartCycles) * 1.e9 / InNumOps);
+
+		if (bAreAllocationsCounted)
+		{
+			Result.AllocsPerOp = FMath::Min(Result.AllocsPerOp, static_cast<double>(EndAllocations - StartAllocations) / InNumOps);
+		}
+	}
+
+	return Result;
+}
+
+bool UWarriorCombatBenchmarkCommandlet::LoadBaseline(const FString& InFilePath, TMap<FString, FBenchmarkResult>& OutBaseline)
+{
+	TArray<FString> Lines;
+
+	if (!FFileHelper::LoadFileToStringArray(Lines, *InFilePath))
+	{
+		return false;
+	}
+
+	TArray<FString> Columns;
+
+	// First line is the header.
+	for (int32 LineIndex = 1; LineIndex < Lines.Num(); LineIndex++)
+	{
+		Lines[LineIndex].ParseIntoArray(Columns, TEXT(","));
+
+		if (Columns.Num() < 4)
+		{
+			continue;
+		}
+
+		FBenchmarkResult BaselineResult;
+		BaselineResult.Name = Columns[0];
+		BaselineResult.NumActors = FCString::Atoi(*Columns[1]);
+		BaselineResult.NsPerOp = FCString::Atod(*Columns[2]);
+		BaselineResult.AllocsPerOp = FCString::Atod(*Columns[3]);
+
+		OutBaseline.Add(GetBaselineKey(BaselineResult), BaselineResult);
+	}
+
+	return true;
+}
+
+bool UWarriorCombatBenchmarkCommandlet::WriteCsv(const FString& InFilePath, const TArray<FBenchmarkResult>& InResults)
+{
+	TArray<FString> Lines;
+	Lines.Reserve(InResults.Num() + 1);
+	Lines.Add(TEXT("Benchmark,Actors,NsPerOp,AllocsPerOp"));
+
+	for (const FBenchmarkResult& Result : InResults)
+	{
+		Lines.Add(FString::Printf(TEXT("%s,%d,%.2f,%.3f"), *Result.Name, Result.NumActors, Result.NsPerOp, Result.AllocsPerOp));
+	}
+
+	return FFileHelper::SaveStringArrayToFile(Lines, *InFilePath);
+}
+
+FString UWarriorCombatBenchmarkCommandlet::GetBaselineKey(const FBenchmarkResult& InResult)
+{
+	return FString::Printf(TEXT("%s@%d"), *InResult.Name, InResult.NumActors);
+}
+
+bool UWarriorCombatBenchmarkCommandlet::IsRegression(const FBenchmarkResult& InResult, const FBenchmarkResult& InBaselineResult, float InTolerance)
+{
+	const bool bIsSlower = InResult.NsPerOp > InBaselineResult.NsPerOp * (1.0 + InTolerance);
+
+	// Allocation counts barely move between runs, so anything beyond the CSV rounding is a regression. Skipped when either side couldn't count.
+	const bool bAllocatesMore = InResult.AllocsPerOp >= 0.0 && InBaselineResult.AllocsPerOp >= 0.0 && InResult.AllocsPerOp > InBaselineResult.AllocsPerOp + 0.01;
+
+	return bIsSlower || bAllocatesMore;
+}
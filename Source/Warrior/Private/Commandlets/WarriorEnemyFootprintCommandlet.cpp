@@ -0,0 +1,355 @@
+// ALL FREE
+
+
+#include "Commandlets/WarriorEnemyFootprintCommandlet.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Serialization/ArchiveCountMem.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Engine/Engine.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/StaticMesh.h"
+#include "Animation/AnimationAsset.h"
+#include "Animation/AnimInstance.h"
+#include "Components/WidgetComponent.h"
+#include "Blueprint/UserWidget.h"
+#include "Abilities/GameplayAbility.h"
+#include "Characters/WarriorEnemyCharacter.h"
+#include "DataAssets/StartupData/DataAsset_StartupDataBase.h"
+
+#include "WarriorDebugHelper.h"
+
+UWarriorEnemyFootprintCommandlet::UWarriorEnemyFootprintCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UWarriorEnemyFootprintCommandlet::Main(const FString& Params)
+{
+	FString ContentPath = TEXT("/Game/EnemyCharacter");
+	FParse::Value(*Params, TEXT("Path="), ContentPath);
+
+	FString OutputFilePath = FPaths::ProjectSavedDir() / TEXT("Profiling") / TEXT("WarriorEnemyFootprint.csv");
+	FParse::Value(*Params, TEXT("Output="), OutputFilePath);
+
+	const bool bCompareLean = FParse::Param(*Params, TEXT("CompareLean"));
+	IConsoleVariable* LeanComponentsCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Warrior.Enemy.LeanComponents"));
+
+	TArray<TSubclassOf<AWarriorEnemyCharacter>> EnemyClasses;
+	GatherEnemyClasses(ContentPath, EnemyClasses);
+
+	if (EnemyClasses.IsEmpty())
+	{
+		UE_LOG(LogWarrior, Error, TEXT("No enemy Blueprints found under %s"), *ContentPath);
+		return 1;
+	}
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("WarriorEnemyFootprintWorld"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+
+	TArray<FEnemyFootprint> Footprints;
+	Footprints.Reserve(bCompareLean ? EnemyClasses.Num() * 2 : EnemyClasses.Num());
+
+	for (const TSubclassOf<AWarriorEnemyCharacter>& EnemyClass : EnemyClasses)
+	{
+		if (!bCompareLean || !LeanComponentsCVar)
+		{
+			Footprints.Add(MeasureEnemy(World, EnemyClass));
+			continue;
+		}
+
+		const int32 PreviousLeanComponents = LeanComponentsCVar->GetInt();
+
+		LeanComponentsCVar->Set(0, ECVF_SetByCode);
+		Footprints.Add(MeasureEnemy(World, EnemyClass));
+
+		LeanComponentsCVar->Set(1, ECVF_SetByCode);
+		FEnemyFootprint& LeanFootprint = Footprints.Add_GetRef(MeasureEnemy(World, EnemyClass));
+		LeanFootprint.ArchetypeName += TEXT("_Lean");
+
+		LeanComponentsCVar->Set(PreviousLeanComponents, ECVF_SetByCode);
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	if (!WriteCsv(OutputFilePath, Footprints))
+	{
+		UE_LOG(LogWarrior, Error, TEXT("Failed to write %s"), *OutputFilePath);
+		return 1;
+	}
+
+	UE_LOG(LogWarrior, Display, TEXT("Wrote the footprint of %d enemy archetypes to %s"), Footprints.Num(), *OutputFilePath);
+
+	return 0;
+}
+
+void UWarriorEnemyFootprintCommandlet::GatherEnemyClasses(const FString& InContentPath, TArray<TSubclassOf<AWarriorEnemyCharacter>>& OutEnemyClasses) const
+{
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	AssetRegistry.SearchAllAssets(true);
+
+	TArray<FAssetData> BlueprintAssets;
+	AssetRegistry.GetAssetsByPath(FName(*InContentPath), BlueprintAssets, true);
+
+	for (const FAssetData& AssetData : BlueprintAssets)
+	{
+		if (AssetData.AssetClassPath != FTopLevelAssetPath(TEXT("/Script/Engine"), TEXT("Blueprint")))
+		{
+			continue;
+		}
+
+		const FSoftClassPath GeneratedClassPath(FString::Printf(TEXT("%s.%s_C"), *AssetData.PackageName.ToString(), *AssetData.AssetName.ToString()));
+		UClass* GeneratedClass = GeneratedClassPath.TryLoadClass<AWarriorEnemyCharacter>();
+
+		if (GeneratedClass && !GeneratedClass->HasAnyClassFlags(CLASS_Abstract))
+		{
+			OutEnemyClasses.Add(GeneratedClass);
+		}
+	}
+}
+
+UWarriorEnemyFootprintCommandlet::FEnemyFootprint UWarriorEnemyFootprintCommandlet::MeasureEnemy(UWorld* InWorld, TSubclassOf<AWarriorEnemyCharacter> InEnemyClass) const
+{
+	FEnemyFootprint Footprint;
+	Footprint.ArchetypeName = InEnemyClass->GetName();
+
+	FActorSpawnParameters SpawnParam;
+	SpawnParam.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnParam.bNoFail = true;
+
+	AWarriorEnemyCharacter* SpawnedEnemy = InWorld->SpawnActor<AWarriorEnemyCharacter>(InEnemyClass, FTransform::Identity, SpawnParam);
+
+	if (!SpawnedEnemy)
+	{
+		UE_LOG(LogWarrior, Warning, TEXT("Could not spawn %s"), *Footprint.ArchetypeName);
+		return Footprint;
+	}
+
+	Footprint.NumObjects = 1;
+	Footprint.NumComponents = SpawnedEnemy->GetComponents().Num();
+
+	for (const UActorComponent* Component : SpawnedEnemy->GetComponents())
+	{
+		if (!Component->IsRegistered())
+		{
+			continue;
+		}
+
+		Footprint.NumRegisteredComponents++;
+
+		if (Component->IsA<USceneComponent>())
+		{
+			Footprint.NumRegisteredSceneComponents++;
+		}
+
+		if (Component->PrimaryComponentTick.bCanEverTick && Component->IsComponentTickEnabled())
+		{
+			Footprint.NumTickingComponents++;
+		}
+	}
+
+	Footprint.OwnedBytes = GetObjectBytes(SpawnedEnemy);
+
+	ForEachObjectWithOuter(SpawnedEnemy,
+		[&Footprint](UObject* InnerObject)
+		{
+			Footprint.NumObjects++;
+			Footprint.OwnedBytes += GetObjectBytes(InnerObject);
+		}
+	);
+
+	// The user widget is outered to the game instance, so it isn't in OwnedBytes. It is what lean enemies skip until they are first hurt.
+	TInlineComponentArray<UWidgetComponent*> WidgetComponents(SpawnedEnemy);
+
+	for (const UWidgetComponent* WidgetComponent : WidgetComponents)
+	{
+		UUserWidget* Widget = WidgetComponent->GetWidget();
+
+		if (!Widget)
+		{
+			continue;
+		}
+
+		Footprint.NumWidgetObjects++;
+		Footprint.WidgetBytes += GetObjectBytes(Widget);
+
+		ForEachObjectWithOuter(Widget,
+			[&Footprint](UObject* InnerObject)
+			{
+				Footprint.NumWidgetObjects++;
+				Footprint.WidgetBytes += GetObjectBytes(InnerObject);
+			}
+		);
+	}
+
+	// The start up data is a soft reference, but every spawned enemy loads it straight away, so count it with the hard references.
+	TSet<FName> HardReferencedPackageNames;
+	GatherHardPackageDependencies(InEnemyClass->GetOutermost()->GetFName(), HardReferencedPackageNames);
+
+	if (UDataAsset_StartupDataBase* StartUpData = SpawnedEnemy->GetCharacterStartUpData().LoadSynchronous())
+	{
+		HardReferencedPackageNames.Add(StartUpData->GetOutermost()->GetFName());
+		GatherHardPackageDependencies(StartUpData->GetOutermost()->GetFName(), HardReferencedPackageNames);
+	}
+
+	HardReferencedPackageNames.Remove(InEnemyClass->GetOutermost()->GetFName());
+
+	for (const FName& PackageName : HardReferencedPackageNames)
+	{
+		UPackage* Package = FindPackage(nullptr, *PackageName.ToString());
+
+		if (!Package)
+		{
+			continue;
+		}
+
+		int64 PackageBytes = 0;
+
+		ForEachObjectWithPackage(Package,
+			[&PackageBytes](UObject* PackageObject)
+			{
+				PackageBytes += GetObjectBytes(PackageObject);
+				return true;
+			}
+		);
+
+		Footprint.NumHardReferencedPackages++;
+		Footprint.HardReferencedBytesByCategory[static_cast<uint8>(CategorizePackage(Package))] += PackageBytes;
+	}
+
+	AController* SpawnedController = SpawnedEnemy->GetController();
+
+	SpawnedEnemy->Destroy();
+
+	if (SpawnedController)
+	{
+		SpawnedController->Destroy();
+	}
+
+	return Footprint;
+}
+
+void UWarriorEnemyFootprintCommandlet::GatherHardPackageDependencies(FName InRootPackageName, TSet<FName>& OutPackageNames)
+{
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	TArray<FName> PackagesToVisit;
+	PackagesToVisit.Add(InRootPackageName);
+
+	TArray<FName> Dependencies;
+
+	while (!PackagesToVisit.IsEmpty())
+	{
+		const FName PackageName = PackagesToVisit.Pop(EAllowShrinking::No);
+
+		Dependencies.Reset();
+		AssetRegistry.GetDependencies(PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+
+		for (const FName& Dependency : Dependencies)
+		{
+			if (Dependency.ToString().StartsWith(TEXT("/Script/")))
+			{
+				continue;
+			}
+
+			bool bIsAlreadyInSet = false;
+			OutPackageNames.Add(Dependency, &bIsAlreadyInSet);
+
+			if (!bIsAlreadyInSet)
+			{
+				PackagesToVisit.Add(Dependency);
+			}
+		}
+	}
+}
+
+UWarriorEnemyFootprintCommandlet::EReferenceCategory UWarriorEnemyFootprintCommandlet::CategorizePackage(const UPackage* InPackage)
+{
+	EReferenceCategory FoundCategory = EReferenceCategory::Other;
+
+	ForEachObjectWithPackage(InPackage,
+		[&FoundCategory](UObject* PackageObject)
+		{
+			if (PackageObject->IsA<USkeletalMesh>() || PackageObject->IsA<UStaticMesh>())
+			{
+				FoundCategory = EReferenceCategory::Mesh;
+			}
+			else if (PackageObject->IsA<UAnimationAsset>())
+			{
+				FoundCategory = EReferenceCategory::Anim;
+			}
+			else if (PackageObject->IsA<UDataAsset_StartupDataBase>())
+			{
+				FoundCategory = EReferenceCategory::StartUpData;
+			}
+			else if (const UClass* PackageClass = Cast<UClass>(PackageObject))
+			{
+				if (PackageClass->IsChildOf<UGameplayAbility>())
+				{
+					FoundCategory = EReferenceCategory::Ability;
+				}
+				else if (PackageClass->IsChildOf<UAnimInstance>())
+				{
+					FoundCategory = EReferenceCategory::Anim;
+				}
+			}
+
+			// Keep looking until something more specific than Other turns up.
+			return FoundCategory == EReferenceCategory::Other;
+		},
+		false
+	);
+
+	return FoundCategory;
+}
+
+int64 UWarriorEnemyFootprintCommandlet::GetObjectBytes(UObject* InObject)
+{
+	FArchiveCountMem CountMem(InObject);
+
+	return static_cast<int64>(CountMem.GetMax()) + InObject->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+}
+
+bool UWarriorEnemyFootprintCommandlet::WriteCsv(const FString& InFilePath, const TArray<FEnemyFootprint>& InFootprints)
+{
+	TArray<FString> Lines;
+	Lines.Reserve(InFootprints.Num() + 1);
+	Lines.Add(TEXT("Archetype,UObjects,Components,RegisteredComponents,RegisteredSceneComponents,TickingComponents,OwnedBytes,WidgetUObjects,WidgetBytes,HardRefPackages,HardRefBytes,MeshBytes,AnimBytes,AbilityBytes,StartUpDataBytes,OtherBytes"));
+
+	for (const FEnemyFootprint& Footprint : InFootprints)
+	{
+		int64 TotalHardReferencedBytes = 0;
+
+		for (const int64 CategoryBytes : Footprint.HardReferencedBytesByCategory)
+		{
+			TotalHardReferencedBytes += CategoryBytes;
+		}
+
+		Lines.Add(FString::Printf(TEXT("%s,%d,%d,%d,%d,%d,%lld,%d,%lld,%d,%lld,%lld,%lld,%lld,%lld,%lld"),
+			*Footprint.ArchetypeName,
+			Footprint.NumObjects,
+			Footprint.NumComponents,
+			Footprint.NumRegisteredComponents,
+			Footprint.NumRegisteredSceneComponents,
+			Footprint.NumTickingComponents,
+			Footprint.OwnedBytes,
+			Footprint.NumWidgetObjects,
+			Footprint.WidgetBytes,
+			Footprint.NumHardReferencedPackages,
+			TotalHardReferencedBytes,
+			Footprint.HardReferencedBytesByCategory[static_cast<uint8>(EReferenceCategory::Mesh)],
+			Footprint.HardReferencedBytesByCategory[static_cast<uint8>(EReferenceCategory::Anim)],
+			Footprint.HardReferencedBytesByCategory[static_cast<uint8>(EReferenceCategory::Ability)],
+			Footprint.HardReferencedBytesByCategory[static_cast<uint8>(EReferenceCategory::StartUpData)],
+			Footprint.HardReferencedBytesByCategory[static_cast<uint8>(EReferenceCategory::Other)]
+		));
+	}
+
+	return FFileHelper::SaveStringArrayToFile(Lines, *InFilePath);
+}
@@ -0,0 +1,207 @@
+// ALL FREE
+
+
+#include "Commandlets/WarriorTelemetryAnalyzerCommandlet.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Algo/BinarySearch.h"
+
+#include "WarriorDebugHelper.h"
+
+namespace WarriorTelemetryAnalyzer
+{
+	struct FTimingColumn
+	{
+		const TCHAR* Name;
+		float FWarriorTelemetryFrame::* Member;
+	};
+
+	static const FTimingColumn TimingColumns[] =
+	{
+		{ TEXT("FrameMs"),			&FWarriorTelemetryFrame::FrameMs },
+		{ TEXT("GameThreadMs"),		&FWarriorTelemetryFrame::GameThreadMs },
+		{ TEXT("RenderThreadMs"),	&FWarriorTelemetryFrame::RenderThreadMs },
+		{ TEXT("GPUMs"),			&FWarriorTelemetryFrame::GPUMs },
+		{ TEXT("GCMs"),				&FWarriorTelemetryFrame::GCMs },
+	};
+
+	/** Index of the first frame recorded at or after InFrameNumber */
+	static int32 LowerBoundFrame(const TArray<FWarriorTelemetryFrame>& InFrames, uint32 InFrameNumber)
+	{
+		return Algo::LowerBoundBy(InFrames, InFrameNumber, &FWarriorTelemetryFrame::FrameNumber);
+	}
+}
+
+UWarriorTelemetryAnalyzerCommandlet::UWarriorTelemetryAnalyzerCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UWarriorTelemetryAnalyzerCommandlet::Main(const FString& Params)
+{
+	using namespace WarriorTelemetryAnalyzer;
+
+	FString InputFilePath;
+
+	if (!FParse::Value(*Params, TEXT("Input="), InputFilePath))
+	{
+		InputFilePath = FindNewestTelemetryFile();
+	}
+
+	FString OutputFilePath = FPaths::ChangeExtension(InputFilePath, TEXT("csv"));
+	FParse::Value(*Params, TEXT("Output="), OutputFilePath);
+
+	int32 MarkerWindowFrames = 30;
+	FParse::Value(*Params, TEXT("MarkerWindow="), MarkerWindowFrames);
+
+	TArray<FWarriorTelemetryFrame> Frames;
+	TArray<FWarriorTelemetryMarker> Markers;
+
+	if (InputFilePath.IsEmpty() || !FWarriorTelemetryRingWriter::ReadRingFile(InputFilePath, Frames, Markers))
+	{
+		UE_LOG(LogWarrior, Error, TEXT("Could not read telemetry file '%s'"), *InputFilePath);
+		return 1;
+	}
+
+	TArray<FString> Lines;
+	Lines.Add(TEXT("Scope,Name,Frames,Timing,P50,P90,P95,P99,Max"));
+
+	AppendPercentileRows(TEXT("Session"), TEXT("All"), Frames, Lines);
+
+	// A wrapped ring can start halfway through a wave, those only get a row once both ends are in the file.
+	TMap<int32, uint32> WaveStartFrames;
+
+	for (const FWarriorTelemetryMarker& Marker : Markers)
+	{
+		if (Marker.Marker == EWarriorTelemetryMarker::WaveStarted)
+		{
+			WaveStartFrames.Add(Marker.Value, Marker.FrameNumber);
+		}
+		else if (Marker.Marker == EWarriorTelemetryMarker::WaveCompleted)
+		{
+			if (const uint32* WaveStartFrame = WaveStartFrames.Find(Marker.Value))
+			{
+				const int32 FirstFrameIndex = LowerBoundFrame(Frames, *WaveStartFrame);
+				const int32 EndFrameIndex = LowerBoundFrame(Frames, Marker.FrameNumber + 1);
+
+				AppendPercentileRows(TEXT("Wave"), FString::Printf(TEXT("Wave%d"), Marker.Value), TConstArrayView<FWarriorTelemetryFrame>(Frames).Slice(FirstFrameIndex, EndFrameIndex - FirstFrameIndex), Lines);
+
+				WaveStartFrames.Remove(Marker.Value);
+			}
+		}
+	}
+
+	for (uint8 MarkerIndex = 0; MarkerIndex < static_cast<uint8>(EWarriorTelemetryMarker::Num); MarkerIndex++)
+	{
+		const EWarriorTelemetryMarker MarkerType = static_cast<EWarriorTelemetryMarker>(MarkerIndex);
+
+		TArray<FWarriorTelemetryFrame> WindowFrames;
+		int32 NumOccurrences = 0;
+
+		for (const FWarriorTelemetryMarker& Marker : Markers)
+		{
+			if (Marker.Marker != MarkerType)
+			{
+				continue;
+			}
+
+			const int32 FirstFrameIndex = LowerBoundFrame(Frames, Marker.FrameNumber);
+			const int32 EndFrameIndex = LowerBoundFrame(Frames, Marker.FrameNumber + MarkerWindowFrames);
+
+			WindowFrames.Append(TConstArrayView<FWarriorTelemetryFrame>(Frames).Slice(FirstFrameIndex, EndFrameIndex - FirstFrameIndex));
+			NumOccurrences++;
+		}
+
+		if (NumOccurrences > 0)
+		{
+			AppendPercentileRows(TEXT("Marker"), FString::Printf(TEXT("%s x%d"), LexToString(MarkerType), NumOccurrences), WindowFrames, Lines);
+		}
+	}
+
+	if (!FFileHelper::SaveStringArrayToFile(Lines, *OutputFilePath))
+	{
+		UE_LOG(LogWarrior, Error, TEXT("Failed to write %s"), *OutputFilePath);
+		return 1;
+	}
+
+	for (const FString& Line : Lines)
+	{
+		UE_LOG(LogWarrior, Display, TEXT("%s"), *Line);
+	}
+
+	UE_LOG(LogWarrior, Display, TEXT("Analyzed %d frames and %d markers from %s into %s"), Frames.Num(), Markers.Num(), *InputFilePath, *OutputFilePath);
+
+	return 0;
+}
+
+FString UWarriorTelemetryAnalyzerCommandlet::FindNewestTelemetryFile()
+{
+	const FString TelemetryDir = FPaths::ProjectSavedDir() / TEXT("Profiling") / TEXT("Telemetry");
+
+	TArray<FString> FileNames;
+	IFileManager::Get().FindFiles(FileNames, *TelemetryDir, TEXT("wtlm"));
+
+	FString NewestFilePath;
+	FDateTime NewestTimeStamp = FDateTime::MinValue();
+
+	for (const FString& FileName : FileNames)
+	{
+		const FString FilePath = TelemetryDir / FileName;
+		const FDateTime TimeStamp = IFileManager::Get().GetTimeStamp(*FilePath);
+
+		if (TimeStamp > NewestTimeStamp)
+		{
+			NewestTimeStamp = TimeStamp;
+			NewestFilePath = FilePath;
+		}
+	}
+
+	return NewestFilePath;
+}
+
+void UWarriorTelemetryAnalyzerCommandlet::AppendPercentileRows(const FString& InScope, const FString& InName, TConstArrayView<FWarriorTelemetryFrame> InFrames, TArray<FString>& OutLines)
+{
+	using namespace WarriorTelemetryAnalyzer;
+
+	if (InFrames.IsEmpty())
+	{
+		return;
+	}
+
+	TArray<float> SortedValues;
+	SortedValues.Reserve(InFrames.Num());
+
+	for (const FTimingColumn& Column : TimingColumns)
+	{
+		SortedValues.Reset();
+
+		for (const FWarriorTelemetryFrame& Frame : InFrames)
+		{
+			SortedValues.Add(Frame.*Column.Member);
+		}
+
+		SortedValues.Sort();
+
+		OutLines.Add(FString::Printf(TEXT("%s,%s,%d,%s,%.2f,%.2f,%.2f,%.2f,%.2f"),
+			*InScope,
+			*InName,
+			InFrames.Num(),
+			Column.Name,
+			GetPercentile(SortedValues, 0.5f),
+			GetPercentile(SortedValues, 0.9f),
+			GetPercentile(SortedValues, 0.95f),
+			GetPercentile(SortedValues, 0.99f),
+			SortedValues.Last()
+		));
+	}
+}
+
+float UWarriorTelemetryAnalyzerCommandlet::GetPercentile(const TArray<float>& InSortedValues, float InPercentile)
+{
+	const int32 Rank = FMath::CeilToInt32(InPercentile * InSortedValues.Num());
+
+	return InSortedValues[FMath::Clamp(Rank - 1, 0, InSortedValues.Num() - 1)];
+}
@@ -0,0 +1,348 @@
+// ALL FREE
+
+
+#include "Commandlets/WarriorWaveStressCommandlet.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Engine/Engine.h"
+#include "EngineUtils.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/PlayerStart.h"
+#include "Components/CapsuleComponent.h"
+#include "NavigationSystem.h"
+#include "BrainComponent.h"
+#include "Navigation/CrowdFollowingComponent.h"
+#include "Subsystems/WarriorEnemyLODSubsystem.h"
+#include "Characters/WarriorEnemyCharacter.h"
+#include "GameControllers/WarriorAIController.h"
+#include "GameControllers/WarriorHeroController.h"
+
+#include "WarriorDebugHelper.h"
+
+namespace WarriorWaveStress
+{
+	static constexpr float FixedDeltaTime = 1.f / 30.f;
+
+	/** Enemies spawn within this distance of the level's player start */
+	static constexpr float SpawnRadius = 4000.f;
+
+	/** The hero stand in circles the player start at this distance, so the crowd keeps repathing and moving */
+	static constexpr float HeroOrbitRadius = 1500.f;
+	static constexpr float HeroOrbitDegreesPerSecond = 20.f;
+
+	static constexpr float AcceptanceRadius = 150.f;
+}
+
+void UWarriorTimedCrowdManager::Tick(float DeltaTime)
+{
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	Super::Tick(DeltaTime);
+
+	TotalTickMs += FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+}
+
+UWarriorWaveStressCommandlet::UWarriorWaveStressCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UWarriorWaveStressCommandlet::Main(const FString& Params)
+{
+	FString MapPath = TEXT("/Game/Maps/GamemodeTestMap");
+	FParse::Value(*Params, TEXT("Map="), MapPath);
+
+	FString WavesParam = TEXT("16,32,64,128");
+	FParse::Value(*Params, TEXT("Waves="), WavesParam, false);
+
+	int32 NumFrames = 600;
+	FParse::Value(*Params, TEXT("Frames="), NumFrames);
+
+	const bool bDisableLOD = FParse::Param(*Params, TEXT("DisableLOD"));
+
+	FString OutputFilePath = FPaths::ProjectSavedDir() / TEXT("Profiling") / (bDisableLOD ? TEXT("WarriorWaveStress_NoLOD.csv") : TEXT("WarriorWaveStress.csv"));
+	FParse::Value(*Params, TEXT("Output="), OutputFilePath);
+
+	TSubclassOf<AWarriorEnemyCharacter> EnemyClass = AWarriorEnemyCharacter::StaticClass();
+	FString EnemyClassPath;
+
+	if (FParse::Value(*Params, TEXT("Pawn="), EnemyClassPath))
+	{
+		EnemyClass = FSoftClassPath(EnemyClassPath).TryLoadClass<AWarriorEnemyCharacter>();
+
+		if (!EnemyClass)
+		{
+			UE_LOG(LogWarrior, Error, TEXT("'%s' is not a Warrior enemy class"), *EnemyClassPath);
+			return 1;
+		}
+	}
+
+	// The LOD subsystem reads this when the world is created, so it has to be set before the level is initialized.
+	IConsoleVariable* EnemyLODEnabledCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Warrior.EnemyLOD.Enabled"));
+
+	if (EnemyLODEnabledCVar)
+	{
+		EnemyLODEnabledCVar->Set(!bDisableLOD, ECVF_SetByCode);
+	}
+
+	UPackage* MapPackage = LoadPackage(nullptr, *MapPath, LOAD_None);
+	UWorld* World = MapPackage ? UWorld::FindWorldInPackage(MapPackage) : nullptr;
+
+	if (!World)
+	{
+		UE_LOG(LogWarrior, Error, TEXT("Could not load the level %s"), *MapPath);
+		return 1;
+	}
+
+	World->WorldType = EWorldType::Game;
+	World->AddToRoot();
+
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	World->InitWorld();
+	World->UpdateWorldComponents(true, false);
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	// Swapped in before any enemy registers its crowd agent.
+	UNavigationSystemV1* NavigationSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	UWarriorTimedCrowdManager* CrowdManager = NavigationSystem ? NewObject<UWarriorTimedCrowdManager>(NavigationSystem) : nullptr;
+
+	if (NavigationSystem)
+	{
+		NavigationSystem->SetCrowdManager(CrowdManager);
+	}
+
+	FVector Center = FVector::ZeroVector;
+
+	for (TActorIterator<APlayerStart> It(World); It; ++It)
+	{
+		Center = It->GetActorLocation();
+		break;
+	}
+
+	// Plain character possessed by the hero controller, so the LOD subsystem finds it as player pawn 0 and the enemies see it as hostile.
+	FActorSpawnParameters SpawnParam;
+	SpawnParam.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	ACharacter* Hero = World->SpawnActor<ACharacter>(ACharacter::StaticClass(), Center + FVector(WarriorWaveStress::HeroOrbitRadius, 0.f, 0.f), FRotator::ZeroRotator, SpawnParam);
+	AWarriorHeroController* HeroController = World->SpawnActor<AWarriorHeroController>();
+	HeroController->Possess(Hero);
+
+	TArray<FString> WaveStrings;
+	WavesParam.ParseIntoArray(WaveStrings, TEXT(","));
+
+	TArray<AWarriorAIController*> Controllers;
+	TArray<FWaveResult> Results;
+
+	bool bSpawnedAllWaves = true;
+
+	for (const FString& WaveString : WaveStrings)
+	{
+		const int32 NumEnemies = FCString::Atoi(*WaveString);
+
+		if (NumEnemies <= 0)
+		{
+			continue;
+		}
+
+		// Waves only ever add enemies, like the survival mode does while the hero is still fighting the previous one.
+		if (!SpawnEnemies(World, EnemyClass, Center, NumEnemies, Controllers))
+		{
+			bSpawnedAllWaves = false;
+			break;
+		}
+
+		const FWaveResult& Result = Results.Add_GetRef(SimulateWave(World, Hero, Center, Controllers, CrowdManager, FMath::Max(NumFrames, 1)));
+
+		UE_LOG(LogWarrior, Display, TEXT("%4d enemies %8.2f ms/frame %8.2f ms p95, crowd %6.3f ms/frame %6.3f ms p95, LOD pass %6.3f ms/frame, %8.1f agents simulated"),
+			Result.NumEnemies, Result.MeanFrameMs, Result.P95FrameMs, Result.MeanCrowdMs, Result.P95CrowdMs, Result.MeanLODPassMs, Result.MeanSimulatedAgents);
+	}
+
+	for (AWarriorAIController* Controller : Controllers)
+	{
+		if (APawn* Enemy = Controller->GetPawn())
+		{
+			Enemy->Destroy();
+		}
+
+		Controller->Destroy();
+	}
+
+	HeroController->Destroy();
+	Hero->Destroy();
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	World->RemoveFromRoot();
+
+	if (!bSpawnedAllWaves)
+	{
+		UE_LOG(LogWarrior, Error, TEXT("Could not spawn the enemies on the nav mesh of %s around its player start"), *MapPath);
+		return 1;
+	}
+
+	if (!WriteCsv(OutputFilePath, !bDisableLOD, Results))
+	{
+		UE_LOG(LogWarrior, Error, TEXT("Failed to write %s"), *OutputFilePath);
+		return 1;
+	}
+
+	UE_LOG(LogWarrior, Display, TEXT("Simulated %d waves with the enemy LOD %s, results in %s"), Results.Num(), bDisableLOD ? TEXT("off") : TEXT("on"), *OutputFilePath);
+
+	return 0;
+}
+
+bool UWarriorWaveStressCommandlet::SpawnEnemies(UWorld* InWorld, TSubclassOf<AWarriorEnemyCharacter> InEnemyClass, const FVector& InCenter, int32 InNumEnemies, TArray<AWarriorAIController*>& InOutControllers)
+{
+	UNavigationSystemV1* NavigationSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(InWorld);
+
+	if (!NavigationSystem)
+	{
+		return false;
+	}
+
+	// Spawn points come from the nav mesh query, only the facing is seeded here.
+	FRandomStream RandomStream(InOutControllers.Num());
+
+	while (InOutControllers.Num() < InNumEnemies)
+	{
+		FNavLocation SpawnNavLocation;
+
+		if (!NavigationSystem->GetRandomReachablePointInRadius(InCenter, WarriorWaveStress::SpawnRadius, SpawnNavLocation))
+		{
+			return false;
+		}
+
+		const FTransform SpawnTransform(FRotator(0.f, RandomStream.FRandRange(-180.f, 180.f), 0.f), SpawnNavLocation.Location);
+
+		AWarriorEnemyCharacter* Enemy = InWorld->SpawnActorDeferred<AWarriorEnemyCharacter>(InEnemyClass, SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+		Enemy->AutoPossessAI = EAutoPossessAI::Disabled;
+
+		// The native enemy class has no controller set up, it gets the one that uses Detour crowd avoidance.
+		if (!Enemy->AIControllerClass || !Enemy->AIControllerClass->IsChildOf<AWarriorAIController>())
+		{
+			Enemy->AIControllerClass = AWarriorAIController::StaticClass();
+		}
+
+		Enemy->FinishSpawning(SpawnTransform);
+		Enemy->AddActorWorldOffset(FVector(0.f, 0.f, Enemy->GetCapsuleComponent()->GetScaledCapsuleHalfHeight()));
+		Enemy->SpawnDefaultController();
+
+		AWarriorAIController* Controller = Cast<AWarriorAIController>(Enemy->GetController());
+
+		if (!Controller)
+		{
+			Enemy->Destroy();
+			return false;
+		}
+
+		// Every enemy chasing the hero is the worst case for Detour, the behavior tree would only add its own cost on top.
+		if (UBrainComponent* BrainComponent = Controller->GetBrainComponent())
+		{
+			BrainComponent->StopLogic(TEXT("Wave stress"));
+		}
+
+		InOutControllers.Add(Controller);
+	}
+
+	return true;
+}
+
+UWarriorWaveStressCommandlet::FWaveResult UWarriorWaveStressCommandlet::SimulateWave(UWorld* InWorld, APawn* InHero, const FVector& InCenter, const TArray<AWarriorAIController*>& InControllers, const UWarriorTimedCrowdManager* InCrowdManager, int32 InNumFrames)
+{
+	using namespace WarriorWaveStress;
+
+	// Not created at all with -DisableLOD.
+	const UWarriorEnemyLODSubsystem* EnemyLODSubsystem = InWorld->GetSubsystem<UWarriorEnemyLODSubsystem>();
+	const double StartLODPassMs = EnemyLODSubsystem ? EnemyLODSubsystem->GetTotalPassMs() : 0.0;
+
+	TArray<double> FrameMs;
+	FrameMs.Reserve(InNumFrames);
+
+	TArray<double> CrowdMs;
+	CrowdMs.Reserve(InNumFrames);
+
+	int64 TotalSimulatedAgents = 0;
+
+	for (int32 FrameIndex = 0; FrameIndex < InNumFrames; FrameIndex++)
+	{
+		const float OrbitDegrees = InWorld->GetTimeSeconds() * HeroOrbitDegreesPerSecond;
+		InHero->SetActorLocation(InCenter + FRotator(0.f, OrbitDegrees, 0.f).Vector() * HeroOrbitRadius);
+
+		for (AWarriorAIController* Controller : InControllers)
+		{
+			if (Controller->GetMoveStatus() == EPathFollowingStatus::Idle)
+			{
+				Controller->MoveToActor(InHero, AcceptanceRadius);
+			}
+		}
+
+		// Only the world tick is timed, the driver above is not part of a real frame.
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		const double StartCrowdMs = InCrowdManager ? InCrowdManager->GetTotalTickMs() : 0.0;
+
+		InWorld->Tick(LEVELTICK_All, FixedDeltaTime);
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+
+		FrameMs.Add(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles));
+		CrowdMs.Add(InCrowdManager ? InCrowdManager->GetTotalTickMs() - StartCrowdMs : 0.0);
+
+		GFrameCounter++;
+
+		for (const AWarriorAIController* Controller : InControllers)
+		{
+			const UCrowdFollowingComponent* CrowdComp = Cast<UCrowdFollowingComponent>(Controller->GetPathFollowingComponent());
+
+			TotalSimulatedAgents += CrowdComp && CrowdComp->IsCrowdSimulationEnabled();
+		}
+	}
+
+	FWaveResult Result;
+	Result.NumEnemies = InControllers.Num();
+	Result.NumFrames = InNumFrames;
+	Result.MeanSimulatedAgents = static_cast<double>(TotalSimulatedAgents) / InNumFrames;
+
+	Result.MeanLODPassMs = EnemyLODSubsystem ? (EnemyLODSubsystem->GetTotalPassMs() - StartLODPassMs) / InNumFrames : 0.0;
+
+	const int32 P95Index = FMath::Min(FMath::FloorToInt32(InNumFrames * 0.95f), InNumFrames - 1);
+
+	double TotalFrameMs = 0.0;
+	double TotalCrowdMs = 0.0;
+
+	for (int32 FrameIndex = 0; FrameIndex < InNumFrames; FrameIndex++)
+	{
+		TotalFrameMs += FrameMs[FrameIndex];
+		TotalCrowdMs += CrowdMs[FrameIndex];
+	}
+
+	Result.MeanFrameMs = TotalFrameMs / InNumFrames;
+	Result.MeanCrowdMs = TotalCrowdMs / InNumFrames;
+
+	FrameMs.Sort();
+	Result.P95FrameMs = FrameMs[P95Index];
+
+	CrowdMs.Sort();
+	Result.P95CrowdMs = CrowdMs[P95Index];
+
+	return Result;
+}
+
+bool UWarriorWaveStressCommandlet::WriteCsv(const FString& InFilePath, bool bInLODEnabled, const TArray<FWaveResult>& InResults)
+{
+	TArray<FString> Lines;
+	Lines.Reserve(InResults.Num() + 1);
+	Lines.Add(TEXT("Enemies,EnemyLOD,Frames,MeanFrameMs,P95FrameMs,MeanCrowdMs,P95CrowdMs,MeanLODPassMs,MeanSimulatedAgents"));
+
+	for (const FWaveResult& Result : InResults)
+	{
+		Lines.Add(FString::Printf(TEXT("%d,%d,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.1f"), Result.NumEnemies, bInLODEnabled, Result.NumFrames,
+			Result.MeanFrameMs, Result.P95FrameMs, Result.MeanCrowdMs, Result.P95CrowdMs, Result.MeanLODPassMs, Result.MeanSimulatedAgents));
+	}
+
+	return FFileHelper::SaveStringArrayToFile(Lines, *InFilePath);
+}
@@ -7,11 +7,14 @@
 #include "WarriorFunctionLibrary.h"
 #include "Characters/WarriorEnemyCharacter.h"
 #include "Components/BoxComponent.h"
+#include "WarriorStats.h"
 
 #include "WarriorDebugHelper.h"
 
 void UEnemyCombatComponent::OnHitTargetActor(AActor* HitActor)
 {
+	SCOPE_CYCLE_COUNTER(STAT_Warrior_CombatHitTarget);
+
 	if (OverlappedActors.Contains(HitActor))
 	{
 		return;
@@ -66,11 +69,11 @@ void UEnemyCombatComponent::ToggleBodyCollsionBoxCollision(bool bShouldEnable, E
 	switch (ToggleDamageType)
 	{
 	case EToggleDamageType::LeftHand:
-		LeftHandCollisionBox->SetCollisionEnabled(bShouldEnable ? ECollisionEnabled::QueryOnly : ECollisionEnabled::NoCollision);
+		OwningEnemyCharacter->SetHandCollisionBoxEnabled(LeftHandCollisionBox, bShouldEnable);
 		break;
 
 	case EToggleDamageType::RightHand:
-		RightHandCollisionBox->SetCollisionEnabled(bShouldEnable ? ECollisionEnabled::QueryOnly : ECollisionEnabled::NoCollision);
+		OwningEnemyCharacter->SetHandCollisionBoxEnabled(RightHandCollisionBox, bShouldEnable);
 		break;
 
 	default:
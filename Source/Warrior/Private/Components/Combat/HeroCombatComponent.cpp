@@ -5,6 +5,8 @@
 #include "Items/Weapons/WarriorHeroWeapon.h"
 #include "AbilitySystemBlueprintLibrary.h"
 #include "WarriorGameplayTags.h"
+#include "WarriorStats.h"
+#include "Subsystems/WarriorInputLatencySubsystem.h"
 
 #include "WarriorDebugHelper.h"
 
@@ -25,6 +27,8 @@ float UHeroCombatComponent::GetHeroCurrentEquippWeaponDamageAtLevel(float InLeve
 
 void UHeroCombatComponent::OnHitTargetActor(AActor* HitActor)
 {
+	SCOPE_CYCLE_COUNTER(STAT_Warrior_CombatHitTarget);
+
 	if (OverlappedActors.Contains(HitActor))
 	{
 		return;
@@ -32,6 +36,8 @@ void UHeroCombatComponent::OnHitTargetActor(AActor* HitActor)
 
 	OverlappedActors.AddUnique(HitActor);
 
+	UWarriorInputLatencySubsystem::MarkHitLanded(GetOwningPawn());
+
 	FGameplayEventData Data;
 	Data.Instigator = GetOwningPawn();
 	Data.Target = HitActor;
@@ -4,9 +4,12 @@
 #include "DataAssets/StartupData/DataAsset_EnemyStartupDataBase.h"
 #include "AbilitySystem/WarriorAbilitySystemComponent.h"
 #include "AbilitySystem/Abilities/WarriorEnemyGameplayAbility.h"
+#include "WarriorStats.h"
 
 void UDataAsset_EnemyStartupDataBase::GiveToAbilitySystemComponent(UWarriorAbilitySystemComponent* InASCToGive, int32 ApplyLevel)
 {
+	LLM_SCOPE_BYTAG(Warrior_Abilities);
+
 	Super::GiveToAbilitySystemComponent(InASCToGive, ApplyLevel);
 
 	if (!EnemyCombatAbilities.IsEmpty())
@@ -4,9 +4,12 @@
 #include "DataAssets/StartupData/DataAsset_HeroStartupData.h"
 #include "AbilitySystem/WarriorAbilitySystemComponent.h"
 #include "AbilitySystem/Abilities/WarriorHeroGameplayAbility.h"
+#include "WarriorStats.h"
 
 void UDataAsset_HeroStartupData::GiveToAbilitySystemComponent(UWarriorAbilitySystemComponent* InASCToGive, int32 ApplyLevel)
 {
+    LLM_SCOPE_BYTAG(Warrior_Abilities);
+
     Super::GiveToAbilitySystemComponent(InASCToGive, ApplyLevel);
 
     for (const FWarriorHeroAbilitySet& AbilitySet : HeroStartUpAbilitySets)
@@ -4,12 +4,15 @@
 #include "DataAssets/StartupData/DataAsset_StartupDataBase.h"
 #include "AbilitySystem/WarriorAbilitySystemComponent.h"
 #include "AbilitySystem/Abilities/WarriorGameplayAbility.h"
+#include "WarriorStats.h"
 
 
 void UDataAsset_StartupDataBase::GiveToAbilitySystemComponent(UWarriorAbilitySystemComponent *InASCToGive, int32 ApplyLevel)
 {
     check(InASCToGive);
 
+	LLM_SCOPE_BYTAG(Warrior_Abilities);
+
     GrantAbilities(ActivateOnGivenAbilities,InASCToGive,ApplyLevel);
 	GrantAbilities(ReactiveAbilities,InASCToGive,ApplyLevel); 
 
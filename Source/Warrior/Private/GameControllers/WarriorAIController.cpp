@@ -5,7 +5,13 @@
 #include "Navigation/CrowdFollowingComponent.h"
 #include "Perception/AIPerceptionComponent.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Enum.h"
 #include "Perception/AISenseConfig_Sight.h"
+#include "AI/WarriorBehaviorTreeComponent.h"
+#include "Subsystems/WarriorAwarenessSubsystem.h"
+#include "Subsystems/WarriorEnemyLODSubsystem.h"
+#include "Subsystems/WarriorUtilityBrainSubsystem.h"
 
 #include "WarriorDebugHelper.h"
 
@@ -25,6 +31,9 @@ AWarriorAIController::AWarriorAIController(const FObjectInitializer& ObjectIniti
 	EnemyPerceptionComponent->SetDominantSense(UAISenseConfig_Sight::StaticClass());
 	EnemyPerceptionComponent->OnTargetPerceptionUpdated.AddUniqueDynamic(this, &ThisClass::OnEnemyPerceptionUpdated);
 
+	// Created up front so RunBehaviorTree picks it up instead of making a plain UBehaviorTreeComponent.
+	BrainComponent = CreateDefaultSubobject<UWarriorBehaviorTreeComponent>("BehaviorTreeComponent");
+
 	SetGenericTeamId(FGenericTeamId(1));
 }
 
@@ -42,6 +51,43 @@ ETeamAttitude::Type AWarriorAIController::GetTeamAttitudeTowards(const AActor& O
 	return ETeamAttitude::Friendly;
 }
 
+bool AWarriorAIController::TrySetTargetActor(AActor* InActor)
+{
+	UBlackboardComponent* BlackboardComponent = GetBlackboardComponent();
+	const FBlackboard::FKey TargetActorKeyID = GetTargetActorKeyID();
+
+	if (!InActor || TargetActorKeyID == FBlackboard::InvalidKey || BlackboardComponent->GetValue<UBlackboardKeyType_Object>(TargetActorKeyID))
+	{
+		return false;
+	}
+
+	return BlackboardComponent->SetValue<UBlackboardKeyType_Object>(TargetActorKeyID, InActor);
+}
+
+bool AWarriorAIController::HasTargetActor() const
+{
+	return GetTargetActor() != nullptr;
+}
+
+AActor* AWarriorAIController::GetTargetActor() const
+{
+	const FBlackboard::FKey TargetActorKeyID = GetTargetActorKeyID();
+
+	return TargetActorKeyID != FBlackboard::InvalidKey ? Cast<AActor>(GetBlackboardComponent()->GetValue<UBlackboardKeyType_Object>(TargetActorKeyID)) : nullptr;
+}
+
+void AWarriorAIController::SetChosenAction(EWarriorEnemyAction InAction)
+{
+	const FBlackboard::FKey ChosenActionKeyID = GetChosenActionKeyID();
+
+	if (ChosenActionKeyID == FBlackboard::InvalidKey)
+	{
+		return;
+	}
+
+	GetBlackboardComponent()->SetValue<UBlackboardKeyType_Enum>(ChosenActionKeyID, static_cast<uint8>(InAction));
+}
+
 void AWarriorAIController::BeginPlay()
 {
 	Super::BeginPlay();
@@ -64,18 +110,100 @@ void AWarriorAIController::BeginPlay()
 		CrowdComp->SetGroupsToAvoid(1);
 		CrowdComp->SetCrowdCollisionQueryRange(CollisionQueryRange);
 	}
+
+	// The crowd settings above become the highest level of detail, the subsystem lowers them and the movement cost with distance and crowd size.
+	if (UWarriorEnemyLODSubsystem* EnemyLODSubsystem = GetWorld()->GetSubsystem<UWarriorEnemyLODSubsystem>())
+	{
+		EnemyLODSubsystem->RegisterEnemy(this, bEnableDetourCrowdAvoidance, static_cast<ECrowdAvoidanceQuality::Type>(FMath::Clamp(DetourCrowdAvoidanceQuality, 1, 4) - 1), CollisionQueryRange);
+	}
+
+	if (bUseSharedHeroAwareness)
+	{
+		if (UWarriorAwarenessSubsystem* AwarenessSubsystem = GetWorld()->GetSubsystem<UWarriorAwarenessSubsystem>())
+		{
+			EnemyPerceptionComponent->SetSenseEnabled(UAISense_Sight::StaticClass(), false);
+			AwarenessSubsystem->RegisterController(this, AISenseConfig_Sight->SightRadius);
+		}
+	}
+
+	if (UWarriorUtilityBrainSubsystem* UtilityBrainSubsystem = bUseUtilityBrain ? GetWorld()->GetSubsystem<UWarriorUtilityBrainSubsystem>() : nullptr)
+	{
+		UtilityBrainSubsystem->RegisterController(this);
+	}
+}
+
+void AWarriorAIController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UWarriorAwarenessSubsystem* AwarenessSubsystem = bUseSharedHeroAwareness ? GetWorld()->GetSubsystem<UWarriorAwarenessSubsystem>() : nullptr)
+	{
+		AwarenessSubsystem->UnregisterController(this);
+	}
+
+	if (UWarriorEnemyLODSubsystem* EnemyLODSubsystem = GetWorld()->GetSubsystem<UWarriorEnemyLODSubsystem>())
+	{
+		EnemyLODSubsystem->UnregisterEnemy(this);
+	}
+
+	if (UWarriorUtilityBrainSubsystem* UtilityBrainSubsystem = bUseUtilityBrain ? GetWorld()->GetSubsystem<UWarriorUtilityBrainSubsystem>() : nullptr)
+	{
+		UtilityBrainSubsystem->UnregisterController(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+FAIRequestID AWarriorAIController::RequestMove(const FAIMoveRequest& MoveRequest, FNavPathSharedPtr Path)
+{
+	// UWarriorEnemyLODSubsystem turns idle enemies into crowd obstacles, they rejoin the simulation before moving again.
+	UCrowdFollowingComponent* CrowdComp = bEnableDetourCrowdAvoidance ? Cast<UCrowdFollowingComponent>(GetPathFollowingComponent()) : nullptr;
+
+	if (CrowdComp && CrowdComp->GetCrowdSimulationState() == ECrowdSimulationState::ObstacleOnly)
+	{
+		CrowdComp->SetCrowdSimulationState(ECrowdSimulationState::Enabled);
+	}
+
+	return Super::RequestMove(MoveRequest, Path);
 }
 
 void AWarriorAIController::OnEnemyPerceptionUpdated(AActor* Actor, FAIStimulus Stimulus)
 {
-	if (UBlackboardComponent* BlackboardComponent = GetBlackboardComponent())
+	if (Stimulus.WasSuccessfullySensed())
 	{
-		if (!BlackboardComponent->GetValueAsObject(FName("TargetActor")))
-		{
-			if (Stimulus.WasSuccessfullySensed() && Actor)
-			{
-				BlackboardComponent->SetValueAsObject(FName("TargetActor"), Actor);
-			}
-		}
+		TrySetTargetActor(Actor);
+	}
+}
+
+FBlackboard::FKey AWarriorAIController::GetTargetActorKeyID() const
+{
+	CacheBlackboardKeyIDs();
+
+	return CachedTargetActorKeyID;
+}
+
+FBlackboard::FKey AWarriorAIController::GetChosenActionKeyID() const
+{
+	CacheBlackboardKeyIDs();
+
+	return CachedChosenActionKeyID;
+}
+
+void AWarriorAIController::CacheBlackboardKeyIDs() const
+{
+	const UBlackboardComponent* BlackboardComponent = GetBlackboardComponent();
+	const UBlackboardData* BlackboardAsset = BlackboardComponent ? BlackboardComponent->GetBlackboardAsset() : nullptr;
+
+	if (!BlackboardAsset)
+	{
+		CachedBlackboardAsset.Reset();
+		CachedTargetActorKeyID = FBlackboard::InvalidKey;
+		CachedChosenActionKeyID = FBlackboard::InvalidKey;
+		return;
+	}
+
+	if (CachedBlackboardAsset != BlackboardAsset)
+	{
+		CachedBlackboardAsset = BlackboardAsset;
+		CachedTargetActorKeyID = BlackboardComponent->GetKeyID(FName("TargetActor"));
+		CachedChosenActionKeyID = BlackboardComponent->GetKeyID(FName("ChosenAction"));
 	}
 }
@@ -3,6 +3,19 @@
 
 #include "GameInstance/WarriorGameInstance.h"
 #include "MoviePlayer.h"
+#include "Engine/AssetManager.h"
+#include "GameModes/WarriorGamemode.h"
+#include "Characters/WarriorBaseCharacter.h"
+#include "Kismet/GameplayStatics.h"
+#include "WarriorStats.h"
+
+#include "WarriorDebugHelper.h"
+
+namespace WarriorLoadScreenPrewarm
+{
+	// Stage 0 streams the level and game mode assets, stage 1 streams soft data discovered on them (e.g. character start up data).
+	static constexpr int32 NumStages = 2;
+}
 
 void UWarriorGameInstance::Init()
 {
@@ -11,14 +24,40 @@ void UWarriorGameInstance::Init()
 	FCoreUObjectDelegates::PreLoadMap.AddUObject(this, &ThisClass::OnpenLoadScreen);
 	FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &ThisClass::ExitLoadScreen);
 
+	GameLevelsByTag.Reset();
+
+	for (const FWarriorGameLevelSet& GameLevelSet : GameLevelSets)
+	{
+		if (!GameLevelSet.IsValid()) continue;
 
+		GameLevelsByTag.Emplace(GameLevelSet.LevelTag, GameLevelSet.Level);
+	}
+}
+
+void UWarriorGameInstance::Shutdown()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(LoadScreenPrewarmTimeoutHandle);
+
+	LoadScreenPrewarmHandles.Empty();
+
+	Super::Shutdown();
 }
 
 void UWarriorGameInstance::OnpenLoadScreen(const FString& MapName)
 {
+	// Assets prewarmed for the previous map are no longer needed once we leave it.
+	LoadScreenPrewarmHandles.Empty();
+	LoadScreenPausedWorld.Reset();
+	SetLoadScreenPrewarmProgress(0.f);
+
+	MapLoadStartTime = FPlatformTime::Seconds();
+	bIsLoadScreenUp = true;
+	bIsHeroReadyForInput = false;
+
 	FLoadingScreenAttributes LoadingScreenAttributes;
-	LoadingScreenAttributes.bAutoCompleteWhenLoadingCompletes = true;
-	LoadingScreenAttributes.MinimumLoadingScreenDisplayTime = 2.f;
+	LoadingScreenAttributes.bAutoCompleteWhenLoadingCompletes = false;
+	LoadingScreenAttributes.bWaitForManualStop = true;
+	LoadingScreenAttributes.bAllowEngineTick = true;
 	LoadingScreenAttributes.WidgetLoadingScreen = FLoadingScreenAttributes::NewTestLoadingScreenWidget();
 
 	GetMoviePlayer()->SetupLoadingScreen(LoadingScreenAttributes);
@@ -26,20 +65,209 @@ void UWarriorGameInstance::OnpenLoadScreen(const FString& MapName)
 
 void UWarriorGameInstance::ExitLoadScreen(UWorld* LoadedWorld)
 {
-	GetMoviePlayer()->StopMovie();
+	if (!LoadedWorld)
+	{
+		GetMoviePlayer()->StopMovie();
+
+		bIsLoadScreenUp = false;
+		MapLoadStartTime = 0.0;
+		return;
+	}
+
+	TArray<FSoftObjectPath> AssetsToPrewarm;
+
+	if (const FWarriorGameLevelSet* FoundLevelSet = FindGameLevelSetByWorld(LoadedWorld))
+	{
+		AssetsToPrewarm.Append(FoundLevelSet->LoadScreenPrewarmAssets);
+	}
+
+	if (const AWarriorGamemode* WarriorGamemode = LoadedWorld->GetAuthGameMode<AWarriorGamemode>())
+	{
+		WarriorGamemode->GetLoadScreenPrewarmAssets(AssetsToPrewarm);
+	}
+
+	// The engine keeps ticking behind the loading screen, so hold gameplay (waves, enemy AI, timers) until the player can see it.
+	if (!UGameplayStatics::IsGamePaused(LoadedWorld) && UGameplayStatics::SetGamePaused(LoadedWorld, true))
+	{
+		LoadScreenPausedWorld = LoadedWorld;
+	}
+
+	bIsLoadScreenPrewarming = true;
+	LoadScreenPrewarmStageIndex = 0;
+	LoadScreenPrewarmStartTime = FPlatformTime::Seconds();
+
+	FTSTicker::GetCoreTicker().RemoveTicker(LoadScreenPrewarmTimeoutHandle);
+	LoadScreenPrewarmTimeoutHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::TickLoadScreenPrewarmTimeout));
+
+	RequestLoadScreenPrewarmStage(MoveTemp(AssetsToPrewarm));
 }
 
 TSoftObjectPtr<UWorld> UWarriorGameInstance::GetGameLevelByTag(FGameplayTag InTag) const
 {
+	if (const TSoftObjectPtr<UWorld>* FoundLevel = GameLevelsByTag.Find(InTag))
+	{
+		return *FoundLevel;
+	}
+
+	return TSoftObjectPtr<UWorld>();
+}
+
+const FWarriorGameLevelSet* UWarriorGameInstance::FindGameLevelSetByWorld(const UWorld* InWorld) const
+{
+	const FString LoadedPackageName = UWorld::RemovePIEPrefix(InWorld->GetOutermost()->GetName());
+
 	for (const FWarriorGameLevelSet& GameLevelSet : GameLevelSets)
 	{
 		if (!GameLevelSet.IsValid()) continue;
 
-		if (GameLevelSet.LevelTag == InTag)
+		if (GameLevelSet.Level.ToSoftObjectPath().GetLongPackageName() == LoadedPackageName)
 		{
-			return GameLevelSet.Level;
+			return &GameLevelSet;
 		}
 	}
 
-	return TSoftObjectPtr<UWorld>();
+	return nullptr;
+}
+
+void UWarriorGameInstance::RequestLoadScreenPrewarmStage(TArray<FSoftObjectPath>&& InAssetsToPrewarm)
+{
+	InAssetsToPrewarm.RemoveAll([](const FSoftObjectPath& AssetPath) { return AssetPath.IsNull(); });
+
+	LoadScreenPrewarmStageAssets = MoveTemp(InAssetsToPrewarm);
+
+	if (LoadScreenPrewarmStageAssets.IsEmpty())
+	{
+		OnLoadScreenPrewarmStageCompleted(LoadScreenPrewarmStageIndex);
+		return;
+	}
+
+	TSharedPtr<FStreamableHandle> StageHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		LoadScreenPrewarmStageAssets,
+		FStreamableDelegate::CreateUObject(this, &ThisClass::OnLoadScreenPrewarmStageCompleted, LoadScreenPrewarmStageIndex),
+		FStreamableManager::AsyncLoadHighPriority
+	);
+
+	if (StageHandle.IsValid())
+	{
+		StageHandle->BindUpdateDelegate(FStreamableUpdateDelegate::CreateUObject(this, &ThisClass::OnLoadScreenPrewarmStageUpdated));
+
+		LoadScreenPrewarmHandles.Add(StageHandle);
+	}
+}
+
+void UWarriorGameInstance::CollectFollowUpPrewarmAssets(TArray<FSoftObjectPath>& OutAssetsToPrewarm) const
+{
+	for (const FSoftObjectPath& PrewarmedAssetPath : LoadScreenPrewarmStageAssets)
+	{
+		const UClass* PrewarmedClass = Cast<UClass>(PrewarmedAssetPath.ResolveObject());
+
+		if (!PrewarmedClass || !PrewarmedClass->IsChildOf<AWarriorBaseCharacter>()) continue;
+
+		const TSoftObjectPtr<UDataAsset_StartupDataBase>& StartUpData = PrewarmedClass->GetDefaultObject<AWarriorBaseCharacter>()->GetCharacterStartUpData();
+
+		if (!StartUpData.IsNull())
+		{
+			OutAssetsToPrewarm.AddUnique(StartUpData.ToSoftObjectPath());
+		}
+	}
+}
+
+void UWarriorGameInstance::OnLoadScreenPrewarmStageUpdated(TSharedRef<FStreamableHandle> InHandle)
+{
+	SetLoadScreenPrewarmProgress((LoadScreenPrewarmStageIndex + InHandle->GetProgress()) / WarriorLoadScreenPrewarm::NumStages);
+}
+
+void UWarriorGameInstance::OnLoadScreenPrewarmStageCompleted(int32 InStageIndex)
+{
+	if (!bIsLoadScreenPrewarming || InStageIndex != LoadScreenPrewarmStageIndex)
+	{
+		return;
+	}
+
+	LoadScreenPrewarmStageIndex++;
+
+	SetLoadScreenPrewarmProgress(static_cast<float>(LoadScreenPrewarmStageIndex) / WarriorLoadScreenPrewarm::NumStages);
+
+	if (LoadScreenPrewarmStageIndex >= WarriorLoadScreenPrewarm::NumStages)
+	{
+		FinishLoadScreenPrewarm();
+		return;
+	}
+
+	TArray<FSoftObjectPath> FollowUpAssets;
+	CollectFollowUpPrewarmAssets(FollowUpAssets);
+
+	RequestLoadScreenPrewarmStage(MoveTemp(FollowUpAssets));
+}
+
+void UWarriorGameInstance::FinishLoadScreenPrewarm()
+{
+	if (!bIsLoadScreenPrewarming)
+	{
+		return;
+	}
+
+	bIsLoadScreenPrewarming = false;
+
+	FTSTicker::GetCoreTicker().RemoveTicker(LoadScreenPrewarmTimeoutHandle);
+	LoadScreenPrewarmTimeoutHandle.Reset();
+
+	SetLoadScreenPrewarmProgress(1.f);
+
+	WARRIOR_LOG(Log, TEXT("Load screen prewarm finished in %.2f ms"), (FPlatformTime::Seconds() - LoadScreenPrewarmStartTime) * 1000.0);
+
+	GetMoviePlayer()->StopMovie();
+
+	if (UWorld* PausedWorld = LoadScreenPausedWorld.Get())
+	{
+		UGameplayStatics::SetGamePaused(PausedWorld, false);
+	}
+
+	LoadScreenPausedWorld.Reset();
+
+	bIsLoadScreenUp = false;
+	TryReportLoadToFirstInput();
+}
+
+bool UWarriorGameInstance::TickLoadScreenPrewarmTimeout(float DeltaTime)
+{
+	if (bIsLoadScreenPrewarming && FPlatformTime::Seconds() - LoadScreenPrewarmStartTime >= MaxLoadScreenPrewarmTime)
+	{
+		WARRIOR_LOG(Warning, TEXT("Load screen prewarm timed out after %.1f seconds, showing the level anyway"), MaxLoadScreenPrewarmTime);
+
+		FinishLoadScreenPrewarm();
+	}
+
+	return bIsLoadScreenPrewarming;
+}
+
+void UWarriorGameInstance::SetLoadScreenPrewarmProgress(float InProgress)
+{
+	LoadScreenPrewarmProgress = InProgress;
+
+	OnLoadScreenPrewarmProgress.Broadcast(LoadScreenPrewarmProgress);
+}
+
+void UWarriorGameInstance::NotifyHeroReadyForInput()
+{
+	bIsHeroReadyForInput = true;
+
+	TryReportLoadToFirstInput();
+}
+
+void UWarriorGameInstance::TryReportLoadToFirstInput()
+{
+	// PIE never goes through PreLoadMap, so there is no start to measure from.
+	if (MapLoadStartTime <= 0.0 || bIsLoadScreenUp || !bIsHeroReadyForInput)
+	{
+		return;
+	}
+
+	const double LoadToFirstInputMs = (FPlatformTime::Seconds() - MapLoadStartTime) * 1000.0;
+	MapLoadStartTime = 0.0;
+
+	SET_FLOAT_STAT(STAT_Warrior_LastLoadToFirstInputMs, LoadToFirstInputMs);
+
+	WARRIOR_LOG(Log, TEXT("Load to first input %.2f ms, hero start up data %s"), LoadToFirstInputMs,
+		AWarriorGamemode::ShouldPreLoadHeroStartUpData() ? TEXT("streamed during the load") : TEXT("loaded on possession"));
 }
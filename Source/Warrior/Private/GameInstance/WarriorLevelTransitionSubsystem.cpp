@@ -0,0 +1,122 @@
+// ALL FREE
+
+
+#include "GameInstance/WarriorLevelTransitionSubsystem.h"
+#include "GameInstance/WarriorGameInstance.h"
+#include "Engine/AssetManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "WarriorStats.h"
+
+#include "WarriorDebugHelper.h"
+
+void UWarriorLevelTransitionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PostLoadMapDelegateHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &ThisClass::OnPostLoadMapWithWorld);
+}
+
+void UWarriorLevelTransitionSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapDelegateHandle);
+
+	LevelPrefetchHandles.Empty();
+
+	Super::Deinitialize();
+}
+
+void UWarriorLevelTransitionSubsystem::PrefetchLevelByTag(FGameplayTag InLevelTag)
+{
+	if (LevelPrefetchHandles.Contains(InLevelTag))
+	{
+		return;
+	}
+
+	UWarriorGameInstance* WarriorGameInstance = Cast<UWarriorGameInstance>(GetGameInstance());
+
+	if (!WarriorGameInstance)
+	{
+		return;
+	}
+
+	const TSoftObjectPtr<UWorld> LevelToPrefetch = WarriorGameInstance->GetGameLevelByTag(InLevelTag);
+
+	if (LevelToPrefetch.IsNull())
+	{
+		return;
+	}
+
+	// Default priority so the prefetch never jumps ahead of streaming the current level needs.
+	TSharedPtr<FStreamableHandle> PrefetchHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		LevelToPrefetch.ToSoftObjectPath(),
+		FStreamableDelegate(),
+		FStreamableManager::DefaultAsyncLoadPriority
+	);
+
+	LevelPrefetchHandles.Emplace(InLevelTag, PrefetchHandle);
+}
+
+void UWarriorLevelTransitionSubsystem::CancelLevelPrefetch(FGameplayTag InLevelTag)
+{
+	if (TSharedPtr<FStreamableHandle>* FoundHandle = LevelPrefetchHandles.Find(InLevelTag))
+	{
+		if (FoundHandle->IsValid())
+		{
+			(*FoundHandle)->CancelHandle();
+		}
+
+		LevelPrefetchHandles.Remove(InLevelTag);
+	}
+}
+
+bool UWarriorLevelTransitionSubsystem::IsLevelPrefetched(FGameplayTag InLevelTag) const
+{
+	const TSharedPtr<FStreamableHandle>* FoundHandle = LevelPrefetchHandles.Find(InLevelTag);
+
+	return FoundHandle && FoundHandle->IsValid() && (*FoundHandle)->HasLoadCompleted();
+}
+
+void UWarriorLevelTransitionSubsystem::OpenLevelByTag(FGameplayTag InLevelTag, const FString& Options)
+{
+	UWarriorGameInstance* WarriorGameInstance = Cast<UWarriorGameInstance>(GetGameInstance());
+
+	if (!WarriorGameInstance)
+	{
+		return;
+	}
+
+	const TSoftObjectPtr<UWorld> LevelToOpen = WarriorGameInstance->GetGameLevelByTag(InLevelTag);
+
+	if (LevelToOpen.IsNull())
+	{
+		WARRIOR_LOG(Warning, TEXT("No level is registered under %s"), *InLevelTag.ToString());
+		return;
+	}
+
+	bIsTransitioningToPrefetchedLevel = IsLevelPrefetched(InLevelTag);
+	LevelTransitionStartTime = FPlatformTime::Seconds();
+
+	UGameplayStatics::OpenLevelBySoftObjectPtr(WarriorGameInstance, LevelToOpen, true, Options);
+}
+
+void UWarriorLevelTransitionSubsystem::OnPostLoadMapWithWorld(UWorld* LoadedWorld)
+{
+	// The loaded world now keeps its package alive, and any other prefetched level is no longer the likely next one.
+	LevelPrefetchHandles.Empty();
+
+	if (LevelTransitionStartTime <= 0.0)
+	{
+		return;
+	}
+
+	LastLevelTransitionTime = static_cast<float>(FPlatformTime::Seconds() - LevelTransitionStartTime);
+	LevelTransitionStartTime = 0.0;
+
+	SET_FLOAT_STAT(STAT_Warrior_LastLevelTransitionMs, LastLevelTransitionTime * 1000.f);
+	SET_DWORD_STAT(STAT_Warrior_LastLevelTransitionPrefetched, bIsTransitioningToPrefetchedLevel ? 1 : 0);
+
+	WARRIOR_LOG(Log, TEXT("Level transition to %s took %.2f ms (prefetched: %s)"),
+		LoadedWorld ? *LoadedWorld->GetName() : TEXT("None"),
+		LastLevelTransitionTime * 1000.f,
+		bIsTransitioningToPrefetchedLevel ? TEXT("yes") : TEXT("no"));
+}
@@ -2,9 +2,59 @@
 
 
 #include "GameModes/WarriorGamemode.h"
+#include "Engine/AssetManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Characters/WarriorBaseCharacter.h"
+#include "DataAssets/StartupData/DataAsset_StartupDataBase.h"
+#include "WarriorStats.h"
+
+static TAutoConsoleVariable<bool> CVarWarriorHeroLoadStartUpDataOnPossession(
+	TEXT("Warrior.Hero.LoadStartUpDataOnPossession"),
+	false,
+	TEXT("Skip streaming the hero start up data during the map load and load it synchronously on possession, like before. Only for before/after load to first input timings."));
 
 AWarriorGamemode::AWarriorGamemode()
 {
 	PrimaryActorTick.bCanEverTick = true;
 	PrimaryActorTick.bStartWithTickEnabled = true;
 }
+
+void AWarriorGamemode::GetLoadScreenPrewarmAssets(TArray<FSoftObjectPath>& OutAssetsToPrewarm) const
+{
+	const AWarriorBaseCharacter* DefaultPawnCDO = DefaultPawnClass ? Cast<AWarriorBaseCharacter>(DefaultPawnClass->GetDefaultObject()) : nullptr;
+
+	if (DefaultPawnCDO && !DefaultPawnCDO->GetCharacterStartUpData().IsNull() && ShouldPreLoadHeroStartUpData())
+	{
+		OutAssetsToPrewarm.AddUnique(DefaultPawnCDO->GetCharacterStartUpData().ToSoftObjectPath());
+	}
+}
+
+bool AWarriorGamemode::ShouldPreLoadHeroStartUpData()
+{
+	return !CVarWarriorHeroLoadStartUpDataOnPossession.GetValueOnGameThread();
+}
+
+void AWarriorGamemode::InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage)
+{
+	Super::InitGame(MapName, Options, ErrorMessage);
+
+	PreLoadDefaultPawnStartUpData();
+}
+
+void AWarriorGamemode::PreLoadDefaultPawnStartUpData()
+{
+	const AWarriorBaseCharacter* DefaultPawnCDO = DefaultPawnClass ? Cast<AWarriorBaseCharacter>(DefaultPawnClass->GetDefaultObject()) : nullptr;
+
+	if (!DefaultPawnCDO || DefaultPawnCDO->GetCharacterStartUpData().IsNull() || !ShouldPreLoadHeroStartUpData())
+	{
+		return;
+	}
+
+	// Stream the hero abilities, weapons and anim layers in while the map finishes loading so possession does not have to block on them.
+	DefaultPawnStartUpDataStreamableHandle = WarriorStats::RequestTrackedAsyncLoad(
+		UAssetManager::GetStreamableManager(),
+		DefaultPawnCDO->GetCharacterStartUpData().ToSoftObjectPath(),
+		FStreamableDelegate(),
+		FStreamableManager::AsyncLoadHighPriority
+	);
+}
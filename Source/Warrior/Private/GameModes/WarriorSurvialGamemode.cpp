@@ -8,19 +8,66 @@
 #include "Engine/TargetPoint.h"
 #include "NavigationSystem.h"
 #include "WarriorFunctionLibrary.h"
+#include "Characters/WarriorHeroCharacter.h"
+#include "AbilitySystem/WarriorAttributeSet.h"
+#include "SaveGame/WarriorSaveGameSubsystem.h"
+#include "EngineUtils.h"
+#include "WarriorGameplayTags.h"
+#include "WarriorStats.h"
+#include "Misc/ScopeExit.h"
+#include "Subsystems/WarriorTelemetrySubsystem.h"
 
 #include "WarriorDebugHelper.h"
 
+void AWarriorSurvialGamemode::GetLoadScreenPrewarmAssets(TArray<FSoftObjectPath>& OutAssetsToPrewarm) const
+{
+	Super::GetLoadScreenPrewarmAssets(OutAssetsToPrewarm);
+
+	if (!EnemyWaveSpawnerDataTable)
+	{
+		return;
+	}
+
+	for (int32 WaveIndex = 1; WaveIndex <= NumWavesToPrewarm; WaveIndex++)
+	{
+		const FName RowName = FName(TEXT("Wave") + FString::FromInt(WaveIndex));
+
+		const FWarriorEnemyWaveSpawnerTableRow* FoundRow = EnemyWaveSpawnerDataTable->FindRow<FWarriorEnemyWaveSpawnerTableRow>(RowName, FString(), false);
+
+		if (!FoundRow) break;
+
+		for (const FWarriorEnemySpawnWaveInfo& SpawnInfo : FoundRow->EnemyWaveSpawnerDefinitions)
+		{
+			if (SpawnInfo.SoftEnemyClassToSpawn.IsNull()) continue;
+
+			OutAssetsToPrewarm.AddUnique(SpawnInfo.SoftEnemyClassToSpawn.ToSoftObjectPath());
+		}
+	}
+}
+
 void AWarriorSurvialGamemode::InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage)
 {
 	Super::InitGame(MapName, Options, ErrorMessage);
 
 	EWarriorGameplayDifficulty SavedGameDifficulty;
 
-	if (UWarriorFunctionLibrary::TryLoadSavedGameDifficulty(SavedGameDifficulty))
+	if (UWarriorFunctionLibrary::TryLoadSavedGameDifficulty(this, SavedGameDifficulty))
 	{
 		WarriorGameplaydifficulty = SavedGameDifficulty;
 	}
+
+	if (UGameplayStatics::HasOption(Options, TEXT("RestoreCheckpoint")))
+	{
+		UWarriorSaveGameSubsystem* SaveGameSubsystem = GetGameInstance()->GetSubsystem<UWarriorSaveGameSubsystem>();
+
+		bIsRestoringSessionCheckpoint = SaveGameSubsystem && SaveGameSubsystem->TryGetSessionCheckpoint(PendingSessionCheckpoint);
+
+		if (bIsRestoringSessionCheckpoint)
+		{
+			// The run has to continue at the difficulty it was started with.
+			WarriorGameplaydifficulty = static_cast<EWarriorGameplayDifficulty>(PendingSessionCheckpoint.GameDifficulty);
+		}
+	}
 }
 
 void AWarriorSurvialGamemode::BeginPlay()
@@ -29,10 +76,16 @@ void AWarriorSurvialGamemode::BeginPlay()
 
 	checkf(EnemyWaveSpawnerDataTable, TEXT("Forgot to assign a valid datat table in survial game mode blueprint"));
 
-	SetCurrentSurvialGameModeState(EWarriorSurvialGameModeState::WaitSpawnNewWave);
-
 	TotalWavesToSpawn = EnemyWaveSpawnerDataTable->GetRowNames().Num();
 
+	if (bIsRestoringSessionCheckpoint)
+	{
+		RestoreSessionCheckpoint();
+		return;
+	}
+
+	SetCurrentSurvialGameModeState(EWarriorSurvialGameModeState::WaitSpawnNewWave);
+
 	PreLoadNextWaveEnemies();
 }
 
@@ -40,6 +93,21 @@ void AWarriorSurvialGamemode::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	EnemySpawnStatWindowTime += DeltaTime;
+
+	if (EnemySpawnStatWindowTime >= 1.f)
+	{
+		SET_FLOAT_STAT(STAT_Warrior_EnemySpawnsPerSecond, EnemySpawnsInStatWindow / EnemySpawnStatWindowTime);
+
+		EnemySpawnsInStatWindow = 0;
+		EnemySpawnStatWindowTime = 0.f;
+	}
+
+	if (bIsRestoringSessionCheckpoint)
+	{
+		return;
+	}
+
 	if (CurrentSurvialGameModeState == EWarriorSurvialGameModeState::WaitSpawnNewWave)
 	{
 		TimePassedSinceStart += DeltaTime;
@@ -93,6 +161,33 @@ void AWarriorSurvialGamemode::SetCurrentSurvialGameModeState(EWarriorSurvialGame
 	CurrentSurvialGameModeState = InState;
 
 	OnSurvialGameModeStateChanged.Broadcast(CurrentSurvialGameModeState);
+
+	switch (CurrentSurvialGameModeState)
+	{
+	case EWarriorSurvialGameModeState::SpawningNewWave:
+		UWarriorTelemetrySubsystem::RecordMarker(this, EWarriorTelemetryMarker::WaveStarted, CurrentWaveCount);
+		break;
+
+	case EWarriorSurvialGameModeState::InProgress:
+		WriteSessionCheckpoint(false);
+		break;
+
+	case EWarriorSurvialGameModeState::WaveCompleted:
+		UWarriorTelemetrySubsystem::RecordMarker(this, EWarriorTelemetryMarker::WaveCompleted, CurrentWaveCount);
+		WriteSessionCheckpoint(true);
+		break;
+
+	case EWarriorSurvialGameModeState::AllWavesDone:
+	case EWarriorSurvialGameModeState::PlayerDied:
+		if (UWarriorSaveGameSubsystem* SaveGameSubsystem = GetGameInstance()->GetSubsystem<UWarriorSaveGameSubsystem>())
+		{
+			SaveGameSubsystem->ClearSessionCheckpoint();
+		}
+		break;
+
+	default:
+		break;
+	}
 }
 
 bool AWarriorSurvialGamemode::HasFinishedAllWaves() const
@@ -102,6 +197,8 @@ bool AWarriorSurvialGamemode::HasFinishedAllWaves() const
 
 void AWarriorSurvialGamemode::PreLoadNextWaveEnemies()
 {
+	LLM_SCOPE_BYTAG(Warrior_WaveArchetypes);
+
 	if (HasFinishedAllWaves()) 
 	{
 		return;
@@ -111,17 +208,27 @@ void AWarriorSurvialGamemode::PreLoadNextWaveEnemies()
 	{
 		if (SpawnInfo.SoftEnemyClassToSpawn.IsNull()) continue;
 
-		UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		WarriorStats::RequestTrackedAsyncLoad(
+			UAssetManager::GetStreamableManager(),
 			SpawnInfo.SoftEnemyClassToSpawn.ToSoftObjectPath(),
 			FStreamableDelegate::CreateLambda(
 				[SpawnInfo, this]() {
+					LLM_SCOPE_BYTAG(Warrior_WaveArchetypes);
+
 					if (UClass* LoadedEnemyClass = SpawnInfo.SoftEnemyClassToSpawn.Get()) {
 						PreLoadedEnemyClassMap.Emplace(SpawnInfo.SoftEnemyClassToSpawn, LoadedEnemyClass);
 
-						Debug::Print(LoadedEnemyClass->GetName() + TEXT(" is loaded"));
+						WARRIOR_LOG(Verbose, TEXT("%s is loaded"), *LoadedEnemyClass->GetName());
+
+						// Catch up on the spawns that were skipped while this class was still streaming in.
+						if (bIsWaveSpawnWaitingForPreload && CurrentSurvialGameModeState == EWarriorSurvialGameModeState::InProgress && ShouldKeepSpawnEnemies())
+						{
+							bIsWaveSpawnWaitingForPreload = false;
+							CurrentSpawnedEnemiesCounter += TrySpawnWaveEnemiesNum();
+						}
 					}
 				}
-			) 
+			)
 		);
 	}
 
@@ -141,6 +248,8 @@ FWarriorEnemyWaveSpawnerTableRow* AWarriorSurvialGamemode::GetCurrentWaveSpawner
 
 int32 AWarriorSurvialGamemode::TrySpawnWaveEnemiesNum()
 {
+	SCOPE_CYCLE_COUNTER(STAT_Warrior_SurvivalSpawn);
+
 	if (TargetPointsArray.IsEmpty())
 	{
 		UGameplayStatics::GetAllActorsOfClass(this, ATargetPoint::StaticClass(), TargetPointsArray);
@@ -150,16 +259,30 @@ int32 AWarriorSurvialGamemode::TrySpawnWaveEnemiesNum()
 
 	uint32 EnemiesSpawnedThisTime = 0;
 
-	FActorSpawnParameters SpawnParam;
-	SpawnParam.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+	ON_SCOPE_EXIT
+	{
+		if (EnemiesSpawnedThisTime > 0)
+		{
+			UWarriorTelemetrySubsystem::RecordMarker(this, EWarriorTelemetryMarker::SpawnBurst, EnemiesSpawnedThisTime);
+		}
+	};
 
 	for (const FWarriorEnemySpawnWaveInfo& SpawnerInfo : GetCurrentWaveSpawnerTableRow()->EnemyWaveSpawnerDefinitions)
 	{
 		if (SpawnerInfo.SoftEnemyClassToSpawn.IsNull()) continue;
 
-		const int32 NumToSpawn = FMath::RandRange(SpawnerInfo.MinPerSpawnToCount, SpawnerInfo.MaxPerSpawnToCount);
+		// Still streaming in, which happens when restored enemies die before the wave preload has finished.
+		UClass* const* FoundEnemyClass = PreLoadedEnemyClassMap.Find(SpawnerInfo.SoftEnemyClassToSpawn);
 
-		UClass* LoadedEnemyClass = PreLoadedEnemyClassMap.FindChecked(SpawnerInfo.SoftEnemyClassToSpawn);
+		if (!FoundEnemyClass)
+		{
+			bIsWaveSpawnWaitingForPreload = true;
+			continue;
+		}
+
+		UClass* LoadedEnemyClass = *FoundEnemyClass;
+
+		const int32 NumToSpawn = FMath::RandRange(SpawnerInfo.MinPerSpawnToCount, SpawnerInfo.MaxPerSpawnToCount);
 
 		for (int32 i = 0; i < NumToSpawn; i++)
 		{
@@ -172,12 +295,8 @@ int32 AWarriorSurvialGamemode::TrySpawnWaveEnemiesNum()
 
 			RandomLocation += FVector(0.f, 0.f, 150.f);
 
-			AWarriorEnemyCharacter* SpawnedEnemy = GetWorld()->SpawnActor<AWarriorEnemyCharacter>(LoadedEnemyClass, RandomLocation, SpawnRotation, SpawnParam);
-
-			if (SpawnedEnemy)
+			if (SpawnWaveEnemy(LoadedEnemyClass, RandomLocation, SpawnRotation))
 			{
-				SpawnedEnemy->OnDestroyed.AddUniqueDynamic(this, &ThisClass::OnEnemyDestroyed);
-
 				EnemiesSpawnedThisTime++;
 				TotalSpawnedEnemiesThisWaveCounter++;
 			}
@@ -193,6 +312,26 @@ int32 AWarriorSurvialGamemode::TrySpawnWaveEnemiesNum()
 
 }
 
+AWarriorEnemyCharacter* AWarriorSurvialGamemode::SpawnWaveEnemy(UClass* InEnemyClass, const FVector& InLocation, const FRotator& InRotation)
+{
+	LLM_SCOPE_BYTAG(Warrior_Enemies);
+	WARRIOR_HITCH_SCOPE(EnemySpawn);
+
+	FActorSpawnParameters SpawnParam;
+	SpawnParam.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	AWarriorEnemyCharacter* SpawnedEnemy = GetWorld()->SpawnActor<AWarriorEnemyCharacter>(InEnemyClass, InLocation, InRotation, SpawnParam);
+
+	if (SpawnedEnemy)
+	{
+		SpawnedEnemy->OnDestroyed.AddUniqueDynamic(this, &ThisClass::OnEnemyDestroyed);
+
+		EnemySpawnsInStatWindow++;
+	}
+
+	return SpawnedEnemy;
+}
+
 bool AWarriorSurvialGamemode::ShouldKeepSpawnEnemies() const
 {
 	return TotalSpawnedEnemiesThisWaveCounter < GetCurrentWaveSpawnerTableRow()->TotalEnemyToSpawnInThisWave;
@@ -202,7 +341,7 @@ void AWarriorSurvialGamemode::OnEnemyDestroyed(AActor* DestroyedActor)
 {
 	CurrentSpawnedEnemiesCounter--;
 
-	Debug::Print(FString::Printf(TEXT("CurrentSpawnedEnemiesCounter:%i, TotalSpawnedEnemiesThisWaveCounter:%i"), CurrentSpawnedEnemiesCounter, TotalSpawnedEnemiesThisWaveCounter));
+	WARRIOR_LOG_RATE_LIMITED(Verbose, 1.0, TEXT("CurrentSpawnedEnemiesCounter:%i, TotalSpawnedEnemiesThisWaveCounter:%i"), CurrentSpawnedEnemiesCounter, TotalSpawnedEnemiesThisWaveCounter);
 
 	if (ShouldKeepSpawnEnemies())
 	{
@@ -230,3 +369,128 @@ void AWarriorSurvialGamemode::RegisterSummonSpawnEnemies(const TArray<AWarriorEn
 	}
 }
 
+
+void AWarriorSurvialGamemode::CaptureSessionSnapshot(FWarriorSessionSnapshot& OutSnapshot) const
+{
+	OutSnapshot.WaveCount = CurrentWaveCount;
+	OutSnapshot.TotalSpawnedEnemiesThisWave = TotalSpawnedEnemiesThisWaveCounter;
+	OutSnapshot.GameDifficulty = static_cast<uint8>(WarriorGameplaydifficulty);
+
+	if (const AWarriorHeroCharacter* HeroCharacter = Cast<AWarriorHeroCharacter>(UGameplayStatics::GetPlayerPawn(this, 0)))
+	{
+		HeroCharacter->CaptureSessionSnapshot(OutSnapshot.Hero);
+	}
+
+	for (TActorIterator<AWarriorEnemyCharacter> It(GetWorld()); It; ++It)
+	{
+		AWarriorEnemyCharacter* Enemy = *It;
+
+		if (!IsValid(Enemy) || UWarriorFunctionLibrary::NativeDoesActorHaveTag(Enemy, WarriorGameplayTags::Shared_Status_Dead)) continue;
+
+		const UWarriorAttributeSet* EnemyAttributeSet = Enemy->GetWarriorAttributeSet();
+
+		FWarriorEnemySnapshot& EnemySnapshot = OutSnapshot.Enemies.AddDefaulted_GetRef();
+		EnemySnapshot.EnemyClass = FSoftClassPath(Enemy->GetClass());
+		EnemySnapshot.Location = Enemy->GetActorLocation();
+		EnemySnapshot.Yaw = Enemy->GetActorRotation().Yaw;
+		EnemySnapshot.HealthPercent = EnemyAttributeSet->GetCurrentHealth() / FMath::Max(EnemyAttributeSet->GetMaxHealth(), 1.f);
+	}
+}
+
+void AWarriorSurvialGamemode::WriteSessionCheckpoint(bool bWaveCompleted)
+{
+	UWarriorSaveGameSubsystem* SaveGameSubsystem = GetGameInstance()->GetSubsystem<UWarriorSaveGameSubsystem>();
+
+	if (!SaveGameSubsystem)
+	{
+		return;
+	}
+
+	FWarriorSessionSnapshot Snapshot;
+	CaptureSessionSnapshot(Snapshot);
+
+	// Once a wave is cleared the run picks up at the start of the next one.
+	if (bWaveCompleted)
+	{
+		Snapshot.WaveCount = CurrentWaveCount + 1;
+		Snapshot.TotalSpawnedEnemiesThisWave = 0;
+		Snapshot.Enemies.Reset();
+	}
+
+	SaveGameSubsystem->WriteSessionCheckpoint(MoveTemp(Snapshot));
+}
+
+void AWarriorSurvialGamemode::RestoreSessionCheckpoint()
+{
+	CurrentWaveCount = FMath::Max(PendingSessionCheckpoint.WaveCount, 1);
+
+	if (AWarriorHeroCharacter* HeroCharacter = Cast<AWarriorHeroCharacter>(UGameplayStatics::GetPlayerPawn(this, 0)))
+	{
+		HeroCharacter->RestoreFromSessionSnapshot(PendingSessionCheckpoint.Hero);
+	}
+
+	if (HasFinishedAllWaves())
+	{
+		bIsRestoringSessionCheckpoint = false;
+		SetCurrentSurvialGameModeState(EWarriorSurvialGameModeState::AllWavesDone);
+		return;
+	}
+
+	PreLoadNextWaveEnemies();
+
+	if (PendingSessionCheckpoint.Enemies.IsEmpty())
+	{
+		bIsRestoringSessionCheckpoint = false;
+		SetCurrentSurvialGameModeState(EWarriorSurvialGameModeState::WaitSpawnNewWave);
+		return;
+	}
+
+	TArray<FSoftObjectPath> EnemyClassesToLoad;
+
+	for (const FWarriorEnemySnapshot& EnemySnapshot : PendingSessionCheckpoint.Enemies)
+	{
+		EnemyClassesToLoad.AddUnique(EnemySnapshot.EnemyClass);
+	}
+
+	LLM_SCOPE_BYTAG(Warrior_WaveArchetypes);
+
+	SessionCheckpointStreamableHandle = WarriorStats::RequestTrackedAsyncLoad(
+		UAssetManager::GetStreamableManager(),
+		MoveTemp(EnemyClassesToLoad),
+		FStreamableDelegate::CreateUObject(this, &ThisClass::OnSessionCheckpointEnemiesLoaded),
+		FStreamableManager::AsyncLoadHighPriority
+	);
+}
+
+void AWarriorSurvialGamemode::OnSessionCheckpointEnemiesLoaded()
+{
+	TotalSpawnedEnemiesThisWaveCounter = PendingSessionCheckpoint.TotalSpawnedEnemiesThisWave;
+	CurrentSpawnedEnemiesCounter = 0;
+
+	for (const FWarriorEnemySnapshot& EnemySnapshot : PendingSessionCheckpoint.Enemies)
+	{
+		UClass* LoadedEnemyClass = EnemySnapshot.EnemyClass.ResolveClass();
+
+		if (!LoadedEnemyClass || !LoadedEnemyClass->IsChildOf<AWarriorEnemyCharacter>()) continue;
+
+		if (AWarriorEnemyCharacter* SpawnedEnemy = SpawnWaveEnemy(LoadedEnemyClass, EnemySnapshot.Location, FRotator(0.f, EnemySnapshot.Yaw, 0.f)))
+		{
+			SpawnedEnemy->RestoreHealthPercent(EnemySnapshot.HealthPercent);
+
+			CurrentSpawnedEnemiesCounter++;
+		}
+	}
+
+	bIsRestoringSessionCheckpoint = false;
+	PendingSessionCheckpoint = FWarriorSessionSnapshot();
+	SessionCheckpointStreamableHandle.Reset();
+
+	if (CurrentSpawnedEnemiesCounter == 0)
+	{
+		TotalSpawnedEnemiesThisWaveCounter = 0;
+		SetCurrentSurvialGameModeState(EWarriorSurvialGameModeState::WaitSpawnNewWave);
+		return;
+	}
+
+	SetCurrentSurvialGameModeState(EWarriorSurvialGameModeState::InProgress);
+}
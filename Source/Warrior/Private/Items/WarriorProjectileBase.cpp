@@ -8,12 +8,15 @@
 #include "WarriorFunctionLibrary.h"
 #include "WarriorGameplayTags.h"
 #include "AbilitySystemBlueprintLibrary.h"
+#include "WarriorStats.h"
 
 #include "WarriorDebugHelper.h"
 
 // Sets default values
 AWarriorProjectileBase::AWarriorProjectileBase()
 {
+	LLM_SCOPE_BYTAG(Warrior_Projectiles);
+
 	PrimaryActorTick.bCanEverTick = false;
 
 	ProjectileCollisionBox = CreateDefaultSubobject<UBoxComponent>(TEXT("ProjectileCollisionBox"));
@@ -40,6 +43,8 @@ AWarriorProjectileBase::AWarriorProjectileBase()
 
 void AWarriorProjectileBase::BeginPlay()
 {
+	LLM_SCOPE_BYTAG(Warrior_Projectiles);
+
 	Super::BeginPlay();
 	
 	if (ProjectileDamagePolicy == EProjectileDamagePolicy::OnBeginOverlap)
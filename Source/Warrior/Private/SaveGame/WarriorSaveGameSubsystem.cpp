@@ -0,0 +1,202 @@
+// ALL FREE
+
+
+#include "SaveGame/WarriorSaveGameSubsystem.h"
+#include "SaveGame/WarriorSaveGame.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/Paths.h"
+#include "Async/Async.h"
+#include "WarriorGameplayTags.h"
+#include "WarriorStats.h"
+
+#include "WarriorDebugHelper.h"
+
+void UWarriorSaveGameSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	SlotName = WarriorGameplayTags::GameData_SaveGame_Slot_1.GetTag().ToString();
+
+	LoadProfileFromSlot();
+
+	const double SessionLoadStartTime = FPlatformTime::Seconds();
+
+	SessionSnapshotWriter = MakeUnique<FWarriorSessionSnapshotWriter>(FPaths::ProjectSavedDir() / TEXT("SaveGames") / SlotName + TEXT("_Session.bin"));
+	bHasSessionCheckpoint = SessionSnapshotWriter->ReadLatestSnapshot(SessionCheckpoint);
+
+	WARRIOR_LOG(Log, TEXT("Session checkpoint %s in %.2f ms"), bHasSessionCheckpoint ? TEXT("restored") : TEXT("not found"), (FPlatformTime::Seconds() - SessionLoadStartTime) * 1000.0);
+}
+
+void UWarriorSaveGameSubsystem::Deinitialize()
+{
+	// The slot must not be written twice at once, so let the async write land before flushing on top of it.
+	InFlightSaveTask.Wait();
+
+	// Nothing will be around to pick up a pending write once we're gone, so flush it now.
+	if (bIsSaveDirty && CachedSaveGame)
+	{
+		UGameplayStatics::SaveGameToSlot(CachedSaveGame, SlotName, UserIndex);
+		bIsSaveDirty = false;
+	}
+
+	// Waits for any checkpoint still being written.
+	SessionSnapshotWriter.Reset();
+
+	Super::Deinitialize();
+}
+
+void UWarriorSaveGameSubsystem::SetSavedGameDifficulty(EWarriorGameplayDifficulty InGameDifficulty)
+{
+	check(CachedSaveGame);
+
+	if (bHasSavedProfile && CachedSaveGame->SavedCurrentGameDifficulty == InGameDifficulty)
+	{
+		return;
+	}
+
+	CachedSaveGame->SavedCurrentGameDifficulty = InGameDifficulty;
+	bHasSavedProfile = true;
+
+	RequestSave();
+}
+
+bool UWarriorSaveGameSubsystem::TryGetSavedGameDifficulty(EWarriorGameplayDifficulty& OutGameDifficulty) const
+{
+	if (!bHasSavedProfile || !CachedSaveGame)
+	{
+		return false;
+	}
+
+	OutGameDifficulty = CachedSaveGame->SavedCurrentGameDifficulty;
+
+	return true;
+}
+
+void UWarriorSaveGameSubsystem::RequestSave()
+{
+	bIsSaveDirty = true;
+
+	if (bIsSaveInFlight)
+	{
+		return;
+	}
+
+	BeginAsyncSave();
+}
+
+void UWarriorSaveGameSubsystem::WriteSessionCheckpoint(FWarriorSessionSnapshot&& InSnapshot)
+{
+	check(SessionSnapshotWriter);
+
+	SessionCheckpoint = InSnapshot;
+	bHasSessionCheckpoint = true;
+
+	SessionSnapshotWriter->EnqueueSnapshot(MoveTemp(InSnapshot));
+}
+
+bool UWarriorSaveGameSubsystem::TryGetSessionCheckpoint(FWarriorSessionSnapshot& OutSnapshot) const
+{
+	if (!bHasSessionCheckpoint)
+	{
+		return false;
+	}
+
+	OutSnapshot = SessionCheckpoint;
+
+	return true;
+}
+
+void UWarriorSaveGameSubsystem::ClearSessionCheckpoint()
+{
+	check(SessionSnapshotWriter);
+
+	if (!bHasSessionCheckpoint)
+	{
+		return;
+	}
+
+	SessionCheckpoint = FWarriorSessionSnapshot();
+	bHasSessionCheckpoint = false;
+
+	SessionSnapshotWriter->EnqueueClear();
+}
+
+void UWarriorSaveGameSubsystem::LoadProfileFromSlot()
+{
+	const double LoadStartTime = FPlatformTime::Seconds();
+
+	if (UGameplayStatics::DoesSaveGameExist(SlotName, UserIndex))
+	{
+		CachedSaveGame = Cast<UWarriorSaveGame>(UGameplayStatics::LoadGameFromSlot(SlotName, UserIndex));
+	}
+
+	bHasSavedProfile = CachedSaveGame != nullptr;
+
+	if (!CachedSaveGame)
+	{
+		CachedSaveGame = Cast<UWarriorSaveGame>(UGameplayStatics::CreateSaveGameObject(UWarriorSaveGame::StaticClass()));
+	}
+
+	LastLoadLatency = static_cast<float>(FPlatformTime::Seconds() - LoadStartTime);
+
+	SET_FLOAT_STAT(STAT_Warrior_SaveGameLoadLatencyMs, LastLoadLatency * 1000.f);
+
+	WARRIOR_LOG(Log, TEXT("Save profile %s %s in %.2f ms"), *SlotName, bHasSavedProfile ? TEXT("loaded") : TEXT("created"), LastLoadLatency * 1000.f);
+}
+
+void UWarriorSaveGameSubsystem::BeginAsyncSave()
+{
+	check(CachedSaveGame);
+
+	bIsSaveInFlight = true;
+	bIsSaveDirty = false;
+	SaveStartTime = FPlatformTime::Seconds();
+
+	// Same split as UGameplayStatics::AsyncSaveGameToSlot, but with a task Deinitialize can wait on.
+	// The save object is serialized to memory here, so the cache can keep changing while the file is written.
+	TArray<uint8> SaveData;
+
+	if (!UGameplayStatics::SaveGameToMemory(CachedSaveGame, SaveData))
+	{
+		OnAsyncSaveFinished(SlotName, UserIndex, false);
+		return;
+	}
+
+	InFlightSaveTask = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[WeakThis = TWeakObjectPtr<ThisClass>(this), SaveData = MoveTemp(SaveData), InSlotName = SlotName, InUserIndex = UserIndex]()
+		{
+			const bool bSuccess = UGameplayStatics::SaveDataToSlot(SaveData, InSlotName, InUserIndex);
+
+			AsyncTask(ENamedThreads::GameThread,
+				[WeakThis, InSlotName, InUserIndex, bSuccess]()
+				{
+					if (ThisClass* StrongThis = WeakThis.Get())
+					{
+						StrongThis->OnAsyncSaveFinished(InSlotName, InUserIndex, bSuccess);
+					}
+				}
+			);
+		}
+	);
+}
+
+void UWarriorSaveGameSubsystem::OnAsyncSaveFinished(const FString& InSlotName, const int32 InUserIndex, bool bSuccess)
+{
+	bIsSaveInFlight = false;
+
+	LastSaveLatency = static_cast<float>(FPlatformTime::Seconds() - SaveStartTime);
+
+	SET_FLOAT_STAT(STAT_Warrior_SaveGameSaveLatencyMs, LastSaveLatency * 1000.f);
+	INC_DWORD_STAT(STAT_Warrior_SaveGameWrites);
+
+	if (!bSuccess)
+	{
+		WARRIOR_LOG(Warning, TEXT("Failed to save profile %s"), *InSlotName);
+	}
+
+	// Everything that changed while this write was on disk goes out together in one more save.
+	if (bIsSaveDirty)
+	{
+		BeginAsyncSave();
+	}
+}
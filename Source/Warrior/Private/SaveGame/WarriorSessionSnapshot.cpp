@@ -0,0 +1,575 @@
+// ALL FREE
+
+
+#include "SaveGame/WarriorSessionSnapshot.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#include "WarriorDebugHelper.h"
+
+namespace WarriorSessionSnapshot
+{
+	constexpr uint32 Magic = 0x504E5357; // "WSNP"
+
+	enum class EVersion : uint16
+	{
+		Initial = 1,
+
+		VersionPlusOne,
+		Latest = VersionPlusOne - 1
+	};
+
+	enum ESection : uint8
+	{
+		Section_Session		= 0,
+		Section_StringTable	= 1,
+		Section_Hero		= 2,
+		Section_Enemies		= 3,
+
+		Section_Num
+	};
+
+	constexpr uint8 AllSectionsMask = (1 << Section_Num) - 1;
+
+	constexpr int32 MaxRecordsBeforeCompaction = 16;
+
+	/** Strings are stored as index + 1 so zero can mean "none" */
+	constexpr uint32 NoStringIndex = 0;
+
+	static void SerializePackedInt(FArchive& Ar, int32& Value)
+	{
+		// Zig-zag so small negative coordinates stay small once packed.
+		uint32 Encoded = (static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31);
+		Ar.SerializeIntPacked(Encoded);
+		Value = static_cast<int32>((Encoded >> 1) ^ (0u - (Encoded & 1)));
+	}
+
+	static void SerializeQuantizedLocation(FArchive& Ar, FVector& Location)
+	{
+		// Whole centimetres are plenty for putting actors back on the nav mesh.
+		int32 X = FMath::RoundToInt32(Location.X);
+		int32 Y = FMath::RoundToInt32(Location.Y);
+		int32 Z = FMath::RoundToInt32(Location.Z);
+
+		SerializePackedInt(Ar, X);
+		SerializePackedInt(Ar, Y);
+		SerializePackedInt(Ar, Z);
+
+		Location = FVector(X, Y, Z);
+	}
+
+	static void SerializeQuantizedYaw(FArchive& Ar, float& Yaw)
+	{
+		uint16 CompressedYaw = FRotator::CompressAxisToShort(Yaw);
+		Ar << CompressedYaw;
+		Yaw = FRotator::DecompressAxisFromShort(CompressedYaw);
+	}
+
+	static void SerializeQuantizedPercent(FArchive& Ar, float& Percent)
+	{
+		uint16 QuantizedPercent = static_cast<uint16>(FMath::RoundToInt32(FMath::Clamp(Percent, 0.f, 1.f) * MAX_uint16));
+		Ar << QuantizedPercent;
+		Percent = static_cast<float>(QuantizedPercent) / MAX_uint16;
+	}
+}
+
+FWarriorSessionSnapshotWriter::FWarriorSessionSnapshotWriter(const FString& InFilePath)
+	: FilePath(InFilePath)
+	, WritePipe(TEXT("WarriorSessionSnapshotPipe"))
+{
+	LastSectionBytes.SetNum(WarriorSessionSnapshot::Section_Num);
+}
+
+FWarriorSessionSnapshotWriter::~FWarriorSessionSnapshotWriter()
+{
+	Flush();
+}
+
+void FWarriorSessionSnapshotWriter::EnqueueSnapshot(FWarriorSessionSnapshot&& InSnapshot)
+{
+	WritePipe.Launch(UE_SOURCE_LOCATION,
+		[this, Snapshot = MoveTemp(InSnapshot)]()
+		{
+			WriteSnapshot(Snapshot);
+		}
+	);
+}
+
+void FWarriorSessionSnapshotWriter::EnqueueClear()
+{
+	WritePipe.Launch(UE_SOURCE_LOCATION,
+		[this]()
+		{
+			ClearSnapshot();
+		}
+	);
+}
+
+void FWarriorSessionSnapshotWriter::Flush()
+{
+	WritePipe.WaitUntilEmpty();
+}
+
+bool FWarriorSessionSnapshotWriter::ReadLatestSnapshot(FWarriorSessionSnapshot& OutSnapshot)
+{
+	using namespace WarriorSessionSnapshot;
+
+	check(!WritePipe.HasWork());
+
+	TArray<uint8> FileBytes;
+
+	if (!FFileHelper::LoadFileToArray(FileBytes, *FilePath, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(FileBytes);
+
+	uint32 FileMagic = 0;
+	uint16 FileVersion = 0;
+	Reader << FileMagic;
+	Reader << FileVersion;
+
+	if (Reader.IsError() || FileMagic != Magic || FileVersion == 0 || FileVersion > static_cast<uint16>(EVersion::Latest))
+	{
+		WARRIOR_LOG(Warning, TEXT("Ignoring session snapshot %s: unknown format or version %u"), *FilePath, FileVersion);
+		return false;
+	}
+
+	int32 NumRecords = 0;
+
+	while (!Reader.AtEnd())
+	{
+		uint32 RecordSize = 0;
+		uint32 RecordCrc = 0;
+		Reader << RecordSize;
+		Reader << RecordCrc;
+
+		// A record cut short by a crash mid write is dropped, everything before it still applies.
+		if (Reader.IsError() || RecordSize == 0 || Reader.Tell() + RecordSize > Reader.TotalSize())
+		{
+			break;
+		}
+
+		const uint8* RecordData = FileBytes.GetData() + Reader.Tell();
+
+		if (FCrc::MemCrc32(RecordData, RecordSize) != RecordCrc)
+		{
+			break;
+		}
+
+		TArray<uint8> RecordBytes(RecordData, RecordSize);
+		Reader.Seek(Reader.Tell() + RecordSize);
+
+		FMemoryReader RecordReader(RecordBytes);
+
+		uint8 SectionMask = 0;
+		RecordReader << SectionMask;
+
+		for (int32 SectionIndex = 0; SectionIndex < Section_Num; SectionIndex++)
+		{
+			if (SectionMask & (1 << SectionIndex))
+			{
+				RecordReader << LastSectionBytes[SectionIndex];
+			}
+		}
+
+		if (RecordReader.IsError())
+		{
+			break;
+		}
+
+		NumRecords++;
+	}
+
+	if (NumRecords == 0 || !DecodeSections(FileVersion, OutSnapshot))
+	{
+		StringTable.Reset();
+		StringTableLookup.Reset();
+
+		for (TArray<uint8>& SectionBytes : LastSectionBytes)
+		{
+			SectionBytes.Reset();
+		}
+
+		return false;
+	}
+
+	// Carry on appending to the same log from where it left off.
+	bLogHasHeader = FileVersion == static_cast<uint16>(EVersion::Latest);
+	NumRecordsSinceCompaction = NumRecords;
+
+	return true;
+}
+
+void FWarriorSessionSnapshotWriter::WriteSnapshot(const FWarriorSessionSnapshot& InSnapshot)
+{
+	using namespace WarriorSessionSnapshot;
+
+	const bool bShouldCompact = !bLogHasHeader || NumRecordsSinceCompaction >= MaxRecordsBeforeCompaction;
+
+	if (bShouldCompact)
+	{
+		StringTable.Reset();
+		StringTableLookup.Reset();
+	}
+
+	TArray<TArray<uint8>> SectionBytes;
+	SectionBytes.SetNum(Section_Num);
+
+	EncodeSessionSection(InSnapshot, SectionBytes[Section_Session]);
+	EncodeHeroSection(InSnapshot.Hero, SectionBytes[Section_Hero]);
+	EncodeEnemiesSection(InSnapshot.Enemies, SectionBytes[Section_Enemies]);
+	EncodeStringTableSection(SectionBytes[Section_StringTable]);
+
+	uint8 ChangedSectionMask = 0;
+
+	for (int32 SectionIndex = 0; SectionIndex < Section_Num; SectionIndex++)
+	{
+		if (bShouldCompact || SectionBytes[SectionIndex] != LastSectionBytes[SectionIndex])
+		{
+			ChangedSectionMask |= 1 << SectionIndex;
+		}
+	}
+
+	LastSectionBytes = MoveTemp(SectionBytes);
+
+	if (bShouldCompact)
+	{
+		WriteFullLog();
+	}
+	else if (ChangedSectionMask != 0)
+	{
+		if (AppendRecord(FilePath, ChangedSectionMask))
+		{
+			NumRecordsSinceCompaction++;
+		}
+		else
+		{
+			// LastSectionBytes already holds sections that never reached disk, the next write has to be a full compaction or its deltas would skip them.
+			bLogHasHeader = false;
+		}
+	}
+}
+
+void FWarriorSessionSnapshotWriter::ClearSnapshot()
+{
+	IFileManager::Get().Delete(*FilePath, false, false, true);
+
+	StringTable.Reset();
+	StringTableLookup.Reset();
+
+	for (TArray<uint8>& SectionBytes : LastSectionBytes)
+	{
+		SectionBytes.Reset();
+	}
+
+	NumRecordsSinceCompaction = 0;
+	bLogHasHeader = false;
+}
+
+void FWarriorSessionSnapshotWriter::EncodeSessionSection(const FWarriorSessionSnapshot& InSnapshot, TArray<uint8>& OutBytes) const
+{
+	FMemoryWriter Writer(OutBytes);
+
+	uint32 WaveCount = FMath::Max(InSnapshot.WaveCount, 0);
+	uint32 TotalSpawnedEnemiesThisWave = FMath::Max(InSnapshot.TotalSpawnedEnemiesThisWave, 0);
+	uint8 GameDifficulty = InSnapshot.GameDifficulty;
+
+	Writer.SerializeIntPacked(WaveCount);
+	Writer.SerializeIntPacked(TotalSpawnedEnemiesThisWave);
+	Writer << GameDifficulty;
+}
+
+void FWarriorSessionSnapshotWriter::EncodeHeroSection(const FWarriorHeroSnapshot& InHeroSnapshot, TArray<uint8>& OutBytes)
+{
+	using namespace WarriorSessionSnapshot;
+
+	FMemoryWriter Writer(OutBytes);
+
+	bool bIsValid = InHeroSnapshot.bIsValid;
+	Writer << bIsValid;
+
+	if (!bIsValid)
+	{
+		return;
+	}
+
+	FVector Location = InHeroSnapshot.Location;
+	float Yaw = InHeroSnapshot.Yaw;
+	float CurrentHealth = InHeroSnapshot.CurrentHealth;
+	float CurrentRage = InHeroSnapshot.CurrentRage;
+
+	SerializeQuantizedLocation(Writer, Location);
+	SerializeQuantizedYaw(Writer, Yaw);
+	Writer << CurrentHealth;
+	Writer << CurrentRage;
+
+	uint32 EquippedWeaponIndex = InHeroSnapshot.EquippedWeaponTag.IsValid() ? InternString(InHeroSnapshot.EquippedWeaponTag.ToString()) : NoStringIndex;
+	Writer.SerializeIntPacked(EquippedWeaponIndex);
+
+	uint32 NumCooldowns = InHeroSnapshot.Cooldowns.Num();
+	Writer.SerializeIntPacked(NumCooldowns);
+
+	for (const FWarriorCooldownSnapshot& CooldownSnapshot : InHeroSnapshot.Cooldowns)
+	{
+		uint32 CooldownTagIndex = InternString(CooldownSnapshot.CooldownTag.ToString());
+		uint32 RemainingTimeMs = static_cast<uint32>(FMath::Max(FMath::RoundToInt32(CooldownSnapshot.RemainingTime * 1000.f), 0));
+
+		Writer.SerializeIntPacked(CooldownTagIndex);
+		Writer.SerializeIntPacked(RemainingTimeMs);
+	}
+}
+
+void FWarriorSessionSnapshotWriter::EncodeEnemiesSection(const TArray<FWarriorEnemySnapshot>& InEnemySnapshots, TArray<uint8>& OutBytes)
+{
+	using namespace WarriorSessionSnapshot;
+
+	FMemoryWriter Writer(OutBytes);
+
+	uint32 NumEnemies = InEnemySnapshots.Num();
+	Writer.SerializeIntPacked(NumEnemies);
+
+	for (const FWarriorEnemySnapshot& EnemySnapshot : InEnemySnapshots)
+	{
+		uint32 EnemyClassIndex = InternString(EnemySnapshot.EnemyClass.ToString());
+		FVector Location = EnemySnapshot.Location;
+		float Yaw = EnemySnapshot.Yaw;
+		float HealthPercent = EnemySnapshot.HealthPercent;
+
+		Writer.SerializeIntPacked(EnemyClassIndex);
+		SerializeQuantizedLocation(Writer, Location);
+		SerializeQuantizedYaw(Writer, Yaw);
+		SerializeQuantizedPercent(Writer, HealthPercent);
+	}
+}
+
+void FWarriorSessionSnapshotWriter::EncodeStringTableSection(TArray<uint8>& OutBytes) const
+{
+	FMemoryWriter Writer(OutBytes);
+
+	uint32 NumStrings = StringTable.Num();
+	Writer.SerializeIntPacked(NumStrings);
+
+	for (const FString& String : StringTable)
+	{
+		FString StringToWrite = String;
+		Writer << StringToWrite;
+	}
+}
+
+bool FWarriorSessionSnapshotWriter::DecodeSections(uint16 InVersion, FWarriorSessionSnapshot& OutSnapshot)
+{
+	using namespace WarriorSessionSnapshot;
+
+	// Only one version exists so far. Older versions get their own branches here when the format changes.
+	check(InVersion >= static_cast<uint16>(EVersion::Initial));
+
+	StringTable.Reset();
+	StringTableLookup.Reset();
+
+	{
+		FMemoryReader Reader(LastSectionBytes[Section_StringTable]);
+
+		uint32 NumStrings = 0;
+		Reader.SerializeIntPacked(NumStrings);
+
+		for (uint32 StringIndex = 0; StringIndex < NumStrings && !Reader.IsError(); StringIndex++)
+		{
+			FString String;
+			Reader << String;
+
+			StringTableLookup.Emplace(String, StringTable.Add(String) + 1);
+		}
+
+		if (Reader.IsError())
+		{
+			return false;
+		}
+	}
+
+	auto ResolveString = [this](uint32 InIndex) -> FString
+	{
+		return StringTable.IsValidIndex(static_cast<int32>(InIndex) - 1) ? StringTable[InIndex - 1] : FString();
+	};
+
+	{
+		FMemoryReader Reader(LastSectionBytes[Section_Session]);
+
+		uint32 WaveCount = 1;
+		uint32 TotalSpawnedEnemiesThisWave = 0;
+
+		Reader.SerializeIntPacked(WaveCount);
+		Reader.SerializeIntPacked(TotalSpawnedEnemiesThisWave);
+		Reader << OutSnapshot.GameDifficulty;
+
+		if (Reader.IsError())
+		{
+			return false;
+		}
+
+		OutSnapshot.WaveCount = WaveCount;
+		OutSnapshot.TotalSpawnedEnemiesThisWave = TotalSpawnedEnemiesThisWave;
+	}
+
+	{
+		FMemoryReader Reader(LastSectionBytes[Section_Hero]);
+		FWarriorHeroSnapshot& HeroSnapshot = OutSnapshot.Hero;
+
+		Reader << HeroSnapshot.bIsValid;
+
+		if (HeroSnapshot.bIsValid)
+		{
+			SerializeQuantizedLocation(Reader, HeroSnapshot.Location);
+			SerializeQuantizedYaw(Reader, HeroSnapshot.Yaw);
+			Reader << HeroSnapshot.CurrentHealth;
+			Reader << HeroSnapshot.CurrentRage;
+
+			uint32 EquippedWeaponIndex = NoStringIndex;
+			Reader.SerializeIntPacked(EquippedWeaponIndex);
+
+			if (EquippedWeaponIndex != NoStringIndex)
+			{
+				HeroSnapshot.EquippedWeaponTag = FGameplayTag::RequestGameplayTag(FName(ResolveString(EquippedWeaponIndex)), false);
+			}
+
+			uint32 NumCooldowns = 0;
+			Reader.SerializeIntPacked(NumCooldowns);
+
+			for (uint32 CooldownIndex = 0; CooldownIndex < NumCooldowns && !Reader.IsError(); CooldownIndex++)
+			{
+				uint32 CooldownTagIndex = NoStringIndex;
+				uint32 RemainingTimeMs = 0;
+
+				Reader.SerializeIntPacked(CooldownTagIndex);
+				Reader.SerializeIntPacked(RemainingTimeMs);
+
+				const FGameplayTag CooldownTag = FGameplayTag::RequestGameplayTag(FName(ResolveString(CooldownTagIndex)), false);
+
+				if (CooldownTag.IsValid())
+				{
+					OutSnapshot.Hero.Cooldowns.Add({ CooldownTag, RemainingTimeMs / 1000.f });
+				}
+			}
+		}
+
+		if (Reader.IsError())
+		{
+			return false;
+		}
+	}
+
+	{
+		FMemoryReader Reader(LastSectionBytes[Section_Enemies]);
+
+		uint32 NumEnemies = 0;
+		Reader.SerializeIntPacked(NumEnemies);
+
+		for (uint32 EnemyIndex = 0; EnemyIndex < NumEnemies && !Reader.IsError(); EnemyIndex++)
+		{
+			uint32 EnemyClassIndex = NoStringIndex;
+			FWarriorEnemySnapshot EnemySnapshot;
+
+			Reader.SerializeIntPacked(EnemyClassIndex);
+			SerializeQuantizedLocation(Reader, EnemySnapshot.Location);
+			SerializeQuantizedYaw(Reader, EnemySnapshot.Yaw);
+			SerializeQuantizedPercent(Reader, EnemySnapshot.HealthPercent);
+
+			EnemySnapshot.EnemyClass = FSoftClassPath(ResolveString(EnemyClassIndex));
+
+			if (EnemySnapshot.EnemyClass.IsValid())
+			{
+				OutSnapshot.Enemies.Add(MoveTemp(EnemySnapshot));
+			}
+		}
+
+		if (Reader.IsError())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+uint32 FWarriorSessionSnapshotWriter::InternString(const FString& InString)
+{
+	if (const uint32* FoundIndex = StringTableLookup.Find(InString))
+	{
+		return *FoundIndex;
+	}
+
+	const uint32 NewIndex = StringTable.Add(InString) + 1;
+	StringTableLookup.Emplace(InString, NewIndex);
+
+	return NewIndex;
+}
+
+bool FWarriorSessionSnapshotWriter::WriteFullLog()
+{
+	using namespace WarriorSessionSnapshot;
+
+	const FString TempFilePath = FilePath + TEXT(".tmp");
+
+	{
+		TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*TempFilePath));
+
+		if (!FileWriter)
+		{
+			return false;
+		}
+
+		uint32 FileMagic = Magic;
+		uint16 FileVersion = static_cast<uint16>(EVersion::Latest);
+		*FileWriter << FileMagic;
+		*FileWriter << FileVersion;
+
+		FileWriter->Close();
+	}
+
+	// The full record goes into the temp file which is then swapped in, so a crash never leaves a half compacted log behind.
+	if (!AppendRecord(TempFilePath, AllSectionsMask) || !IFileManager::Get().Move(*FilePath, *TempFilePath, true, true))
+	{
+		bLogHasHeader = false;
+		return false;
+	}
+
+	bLogHasHeader = true;
+	NumRecordsSinceCompaction = 1;
+
+	return true;
+}
+
+bool FWarriorSessionSnapshotWriter::AppendRecord(const FString& InFilePath, uint8 InSectionMask)
+{
+	TArray<uint8> RecordBytes;
+	FMemoryWriter RecordWriter(RecordBytes);
+
+	RecordWriter << InSectionMask;
+
+	for (int32 SectionIndex = 0; SectionIndex < WarriorSessionSnapshot::Section_Num; SectionIndex++)
+	{
+		if (InSectionMask & (1 << SectionIndex))
+		{
+			RecordWriter << LastSectionBytes[SectionIndex];
+		}
+	}
+
+	TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*InFilePath, FILEWRITE_Append));
+
+	if (!FileWriter)
+	{
+		return false;
+	}
+
+	uint32 RecordSize = RecordBytes.Num();
+	uint32 RecordCrc = FCrc::MemCrc32(RecordBytes.GetData(), RecordBytes.Num());
+
+	*FileWriter << RecordSize;
+	*FileWriter << RecordCrc;
+	FileWriter->Serialize(RecordBytes.GetData(), RecordBytes.Num());
+
+	return FileWriter->Close();
+}
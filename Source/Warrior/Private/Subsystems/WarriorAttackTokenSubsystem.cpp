@@ -0,0 +1,223 @@
+// ALL FREE
+
+
+#include "Subsystems/WarriorAttackTokenSubsystem.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+#include "WarriorFunctionLibrary.h"
+#include "WarriorGameplayTags.h"
+#include "WarriorStats.h"
+
+static TAutoConsoleVariable<bool> CVarWarriorAttackTokensEnabled(
+	TEXT("Warrior.AttackTokens.Enabled"),
+	true,
+	TEXT("Limit how many enemies may attack the same target at once. Read when a game world starts."));
+
+static TAutoConsoleVariable<int32> CVarWarriorAttackTokensMaxPerTarget(
+	TEXT("Warrior.AttackTokens.MaxPerTarget"),
+	3,
+	TEXT("Attack slots per target. Abilities that require a token take AttackTokenCost of them."));
+
+static TAutoConsoleVariable<float> CVarWarriorAttackTokensWaitTimeout(
+	TEXT("Warrior.AttackTokens.WaitTimeout"),
+	1.f,
+	TEXT("Seconds a turned away attacker keeps its place in the queue without asking again."));
+
+static TAutoConsoleVariable<float> CVarWarriorAttackTokensMaxHoldSeconds(
+	TEXT("Warrior.AttackTokens.MaxHoldSeconds"),
+	6.f,
+	TEXT("Tokens held longer than this are taken back, in case the ability that owns one never ended."));
+
+bool UWarriorAttackTokenSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return CVarWarriorAttackTokensEnabled.GetValueOnGameThread() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UWarriorAttackTokenSubsystem::Deinitialize()
+{
+	PoolsByTarget.Empty();
+
+	SET_DWORD_STAT(STAT_Warrior_AttackTokensInUse, 0);
+
+	Super::Deinitialize();
+}
+
+bool UWarriorAttackTokenSubsystem::CanAcquireToken(const AActor* InAttacker, const AActor* InTarget, int32 InCost) const
+{
+	check(InAttacker && InTarget);
+
+	const FAttackTokenPool* Pool = PoolsByTarget.Find(InTarget);
+
+	return !Pool || HasRoomFor(*Pool, InAttacker, ClampCost(InCost));
+}
+
+bool UWarriorAttackTokenSubsystem::TryAcquireToken(AActor* InAttacker, FGameplayAbilitySpecHandle InAbilityHandle, const AActor* InTarget, int32 InCost)
+{
+	check(InAttacker && InTarget);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const int32 Cost = ClampCost(InCost);
+
+	FAttackTokenPool& Pool = PoolsByTarget.FindOrAdd(InTarget);
+	PrunePool(Pool, Now);
+
+	if (Pool.Holders.ContainsByPredicate([InAttacker, InAbilityHandle](const FAttackTokenHolder& InHolder) { return InHolder.Attacker == InAttacker && InHolder.AbilityHandle == InAbilityHandle; }))
+	{
+		return true;
+	}
+
+	if (!HasRoomFor(Pool, InAttacker, Cost))
+	{
+		if (FAttackTokenWaiter* ExistingWaiter = Pool.Waiters.FindByPredicate([InAttacker](const FAttackTokenWaiter& InWaiter) { return InWaiter.Attacker == InAttacker; }))
+		{
+			ExistingWaiter->Cost = Cost;
+			ExistingWaiter->LastRequestTime = Now;
+		}
+		else
+		{
+			FAttackTokenWaiter& NewWaiter = Pool.Waiters.AddDefaulted_GetRef();
+			NewWaiter.Attacker = InAttacker;
+			NewWaiter.Cost = Cost;
+			NewWaiter.LastRequestTime = Now;
+		}
+
+		INC_DWORD_STAT(STAT_Warrior_AttackTokensDenied);
+
+		return false;
+	}
+
+	// Keeps the queue order of everyone else, which is what makes it fair.
+	Pool.Waiters.RemoveAll([InAttacker](const FAttackTokenWaiter& InWaiter) { return InWaiter.Attacker == InAttacker; });
+
+	FAttackTokenHolder& NewHolder = Pool.Holders.AddDefaulted_GetRef();
+	NewHolder.Attacker = InAttacker;
+	NewHolder.AbilityHandle = InAbilityHandle;
+	NewHolder.Cost = Cost;
+	NewHolder.AcquiredTime = Now;
+
+	UpdateTokensInUseStat();
+
+	return true;
+}
+
+void UWarriorAttackTokenSubsystem::ReleaseToken(const AActor* InAttacker, FGameplayAbilitySpecHandle InAbilityHandle)
+{
+	for (auto It = PoolsByTarget.CreateIterator(); It; ++It)
+	{
+		FAttackTokenPool& Pool = It.Value();
+		Pool.Holders.RemoveAllSwap([InAttacker, InAbilityHandle](const FAttackTokenHolder& InHolder) { return InHolder.Attacker == InAttacker && InHolder.AbilityHandle == InAbilityHandle; });
+
+		if (Pool.Holders.IsEmpty() && Pool.Waiters.IsEmpty())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	UpdateTokensInUseStat();
+}
+
+bool UWarriorAttackTokenSubsystem::HasToken(const AActor* InAttacker) const
+{
+	for (const TPair<FObjectKey, FAttackTokenPool>& PoolPair : PoolsByTarget)
+	{
+		if (PoolPair.Value.Holders.ContainsByPredicate([InAttacker](const FAttackTokenHolder& InHolder) { return InHolder.Attacker == InAttacker; }))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool UWarriorAttackTokenSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UWarriorAttackTokenSubsystem::PrunePool(FAttackTokenPool& InPool, double InNow) const
+{
+	const float MaxHoldSeconds = CVarWarriorAttackTokensMaxHoldSeconds.GetValueOnGameThread();
+	const float WaitTimeout = CVarWarriorAttackTokensWaitTimeout.GetValueOnGameThread();
+
+	InPool.Holders.RemoveAllSwap([InNow, MaxHoldSeconds](const FAttackTokenHolder& InHolder)
+		{
+			return !InHolder.Attacker.IsValid() || InNow - InHolder.AcquiredTime > MaxHoldSeconds;
+		}
+	);
+
+	InPool.Waiters.RemoveAll([InNow, WaitTimeout](const FAttackTokenWaiter& InWaiter)
+		{
+			if (!InWaiter.Attacker.IsValid())
+			{
+				return true;
+			}
+
+			if (InNow - InWaiter.LastRequestTime <= WaitTimeout)
+			{
+				return false;
+			}
+
+			// Stopped asking, so it is no longer circling for a slot either.
+			UWarriorFunctionLibrary::RemoveGameplayTagFromActorIfFound(InWaiter.Attacker.Get(), WarriorGameplayTags::Enemy_Status_Strafing);
+
+			return true;
+		}
+	);
+}
+
+bool UWarriorAttackTokenSubsystem::HasRoomFor(const FAttackTokenPool& InPool, const AActor* InAttacker, int32 InCost) const
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	const float MaxHoldSeconds = CVarWarriorAttackTokensMaxHoldSeconds.GetValueOnGameThread();
+	const float WaitTimeout = CVarWarriorAttackTokensWaitTimeout.GetValueOnGameThread();
+
+	int32 NumTokensInUse = 0;
+
+	for (const FAttackTokenHolder& Holder : InPool.Holders)
+	{
+		if (Holder.Attacker.IsValid() && Now - Holder.AcquiredTime <= MaxHoldSeconds)
+		{
+			NumTokensInUse += Holder.Cost;
+		}
+	}
+
+	// Everyone queued ahead gets served first.
+	int32 NumTokensReservedAhead = 0;
+
+	for (const FAttackTokenWaiter& Waiter : InPool.Waiters)
+	{
+		if (Waiter.Attacker == InAttacker)
+		{
+			break;
+		}
+
+		if (Waiter.Attacker.IsValid() && Now - Waiter.LastRequestTime <= WaitTimeout)
+		{
+			NumTokensReservedAhead += Waiter.Cost;
+		}
+	}
+
+	return NumTokensInUse + NumTokensReservedAhead + InCost <= FMath::Max(CVarWarriorAttackTokensMaxPerTarget.GetValueOnGameThread(), 1);
+}
+
+int32 UWarriorAttackTokenSubsystem::ClampCost(int32 InCost)
+{
+	return FMath::Clamp(InCost, 1, FMath::Max(CVarWarriorAttackTokensMaxPerTarget.GetValueOnGameThread(), 1));
+}
+
+void UWarriorAttackTokenSubsystem::UpdateTokensInUseStat() const
+{
+#if STATS
+	int32 NumTokensInUse = 0;
+
+	for (const TPair<FObjectKey, FAttackTokenPool>& PoolPair : PoolsByTarget)
+	{
+		for (const FAttackTokenHolder& Holder : PoolPair.Value.Holders)
+		{
+			NumTokensInUse += Holder.Cost;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_Warrior_AttackTokensInUse, NumTokensInUse);
+#endif
+}
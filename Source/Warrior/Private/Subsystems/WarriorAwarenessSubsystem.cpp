@@ -0,0 +1,149 @@
+// ALL FREE
+
+
+#include "Subsystems/WarriorAwarenessSubsystem.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#include "GameControllers/WarriorAIController.h"
+#include "WarriorStats.h"
+
+static TAutoConsoleVariable<float> CVarWarriorAwarenessInterval(
+	TEXT("Warrior.Awareness.Interval"),
+	0.2f,
+	TEXT("Seconds between shared hero awareness passes. 0 runs a pass every frame."));
+
+void UWarriorAwarenessSubsystem::Deinitialize()
+{
+	AwareControllers.Empty();
+	PendingSightTraces.Empty();
+
+	SET_DWORD_STAT(STAT_Warrior_AwareEnemies, 0);
+
+	Super::Deinitialize();
+}
+
+void UWarriorAwarenessSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_Warrior_AwarenessPass);
+
+	UWorld* World = GetWorld();
+
+	ConsumePendingSightTraces(*World);
+
+	AccumulatedDeltaTime += DeltaTime;
+
+	if (AccumulatedDeltaTime < CVarWarriorAwarenessInterval.GetValueOnGameThread())
+	{
+		return;
+	}
+
+	AccumulatedDeltaTime = 0.f;
+
+	AwareControllers.RemoveAllSwap([](const FAwareController& InEntry) { return !InEntry.Controller.IsValid(); }, EAllowShrinking::No);
+
+	SET_DWORD_STAT(STAT_Warrior_AwareEnemies, AwareControllers.Num());
+
+	if (AActor* Hero = UGameplayStatics::GetPlayerPawn(World, 0))
+	{
+		QueueSightTraces(*World, Hero);
+	}
+}
+
+bool UWarriorAwarenessSubsystem::IsTickable() const
+{
+	return !AwareControllers.IsEmpty() || !PendingSightTraces.IsEmpty();
+}
+
+TStatId UWarriorAwarenessSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorAwarenessSubsystem, STATGROUP_Tickables);
+}
+
+void UWarriorAwarenessSubsystem::RegisterController(AWarriorAIController* InController, float InSightRadius)
+{
+	check(InController);
+
+	if (AwareControllers.ContainsByPredicate([InController](const FAwareController& InEntry) { return InEntry.Controller == InController; }))
+	{
+		return;
+	}
+
+	FAwareController& NewEntry = AwareControllers.AddDefaulted_GetRef();
+	NewEntry.Controller = InController;
+	NewEntry.SightRadiusSquared = FMath::Square(InSightRadius);
+}
+
+void UWarriorAwarenessSubsystem::UnregisterController(const AWarriorAIController* InController)
+{
+	AwareControllers.RemoveAllSwap([InController](const FAwareController& InEntry) { return InEntry.Controller == InController; }, EAllowShrinking::No);
+}
+
+bool UWarriorAwarenessSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UWarriorAwarenessSubsystem::ConsumePendingSightTraces(UWorld& InWorld)
+{
+	for (const FPendingSightTrace& PendingSightTrace : PendingSightTraces)
+	{
+		AWarriorAIController* Controller = PendingSightTrace.Controller.Get();
+		AActor* TargetActor = PendingSightTrace.TargetActor.Get();
+
+		FTraceDatum TraceDatum;
+
+		if (!Controller || !TargetActor || !InWorld.QueryTraceData(PendingSightTrace.TraceHandle, TraceDatum))
+		{
+			continue;
+		}
+
+		// Same rule as the sight sense, the view counts as clear if nothing blocks it or the first thing hit is the target itself.
+		const FHitResult* BlockingHit = TraceDatum.OutHits.FindByPredicate([](const FHitResult& InHit) { return InHit.bBlockingHit; });
+
+		if (!BlockingHit || BlockingHit->GetActor() == TargetActor)
+		{
+			Controller->TrySetTargetActor(TargetActor);
+		}
+	}
+
+	PendingSightTraces.Reset();
+}
+
+void UWarriorAwarenessSubsystem::QueueSightTraces(UWorld& InWorld, AActor* InHero)
+{
+	const FVector HeroLocation = InHero->GetActorLocation();
+
+	for (const FAwareController& AwareController : AwareControllers)
+	{
+		AWarriorAIController* Controller = AwareController.Controller.Get();
+		const APawn* EnemyPawn = Controller->GetPawn();
+
+		// Enemies already chasing someone keep their target, just like with their own sight sense.
+		if (!EnemyPawn || Controller->HasTargetActor())
+		{
+			continue;
+		}
+
+		FVector EyeLocation;
+		FRotator EyeRotation;
+		EnemyPawn->GetActorEyesViewPoint(EyeLocation, EyeRotation);
+
+		if (FVector::DistSquared(EyeLocation, HeroLocation) > AwareController.SightRadiusSquared
+			|| Controller->GetTeamAttitudeTowards(*InHero) != ETeamAttitude::Hostile)
+		{
+			continue;
+		}
+
+		const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(WarriorAwarenessSight), false, EnemyPawn);
+
+		FPendingSightTrace& PendingSightTrace = PendingSightTraces.AddDefaulted_GetRef();
+		PendingSightTrace.TraceHandle = InWorld.AsyncLineTraceByChannel(EAsyncTraceType::Single, EyeLocation, HeroLocation, ECC_Visibility, QueryParams);
+		PendingSightTrace.Controller = Controller;
+		PendingSightTrace.TargetActor = InHero;
+
+		INC_DWORD_STAT(STAT_Warrior_AwarenessTraces);
+	}
+}
@@ -0,0 +1,106 @@
+// ALL FREE
+
+
+#include "Subsystems/WarriorBehaviorTreeBudgetSubsystem.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "AIController.h"
+#include "WarriorStats.h"
+
+static TAutoConsoleVariable<bool> CVarWarriorAIBudgetEnabled(
+	TEXT("Warrior.AIBudget.Enabled"),
+	true,
+	TEXT("Spread behavior tree ticks of distant enemies across frames. Read when a game world starts."));
+
+static TAutoConsoleVariable<float> CVarWarriorAIBudgetFrameBudgetMs(
+	TEXT("Warrior.AIBudget.FrameBudgetMs"),
+	1.5f,
+	TEXT("Milliseconds per frame behavior trees may use before distant enemies start waiting for a later frame."));
+
+static TAutoConsoleVariable<float> CVarWarriorAIBudgetNearDistance(
+	TEXT("Warrior.AIBudget.NearDistance"),
+	2000.f,
+	TEXT("Enemies closer than this to the hero tick their behavior tree every frame."));
+
+static TAutoConsoleVariable<float> CVarWarriorAIBudgetMinInterval(
+	TEXT("Warrior.AIBudget.MinInterval"),
+	0.1f,
+	TEXT("Seconds between behavior tree ticks of distant enemies, even with budget to spare."));
+
+static TAutoConsoleVariable<float> CVarWarriorAIBudgetMaxDelay(
+	TEXT("Warrior.AIBudget.MaxDelay"),
+	0.5f,
+	TEXT("Seconds after which a behavior tree ticks even if the frame is over budget."));
+
+bool UWarriorBehaviorTreeBudgetSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return CVarWarriorAIBudgetEnabled.GetValueOnGameThread() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UWarriorBehaviorTreeBudgetSubsystem::Deinitialize()
+{
+	SET_FLOAT_STAT(STAT_Warrior_BehaviorTreeFrameMs, 0.f);
+	SET_DWORD_STAT(STAT_Warrior_BehaviorTreesTicked, 0);
+	SET_DWORD_STAT(STAT_Warrior_BehaviorTreesDeferred, 0);
+
+	Super::Deinitialize();
+}
+
+void UWarriorBehaviorTreeBudgetSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Tickables run after components, so this closes the frame the trees just ticked in.
+	SET_FLOAT_STAT(STAT_Warrior_BehaviorTreeFrameMs, FrameCostMs);
+	SET_DWORD_STAT(STAT_Warrior_BehaviorTreesTicked, NumTreesTicked);
+	SET_DWORD_STAT(STAT_Warrior_BehaviorTreesDeferred, NumTreesDeferred);
+
+	FrameCostMs = 0.0;
+	NumTreesTicked = 0;
+	NumTreesDeferred = 0;
+
+	const APawn* Hero = UGameplayStatics::GetPlayerPawn(this, 0);
+	HeroLocation = Hero ? Hero->GetActorLocation() : TOptional<FVector>();
+}
+
+TStatId UWarriorBehaviorTreeBudgetSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorBehaviorTreeBudgetSubsystem, STATGROUP_Tickables);
+}
+
+bool UWarriorBehaviorTreeBudgetSubsystem::ShouldTickTree(const UBehaviorTreeComponent& InTreeComponent, float InPendingDeltaTime)
+{
+	if (InPendingDeltaTime >= CVarWarriorAIBudgetMaxDelay.GetValueOnGameThread())
+	{
+		return true;
+	}
+
+	const AAIController* AIController = InTreeComponent.GetAIOwner();
+	const APawn* Pawn = AIController ? AIController->GetPawn() : nullptr;
+
+	if (!Pawn || !HeroLocation || FVector::DistSquared(Pawn->GetActorLocation(), *HeroLocation) < FMath::Square(CVarWarriorAIBudgetNearDistance.GetValueOnGameThread()))
+	{
+		return true;
+	}
+
+	if (InPendingDeltaTime < CVarWarriorAIBudgetMinInterval.GetValueOnGameThread() || FrameCostMs >= CVarWarriorAIBudgetFrameBudgetMs.GetValueOnGameThread())
+	{
+		NumTreesDeferred++;
+		return false;
+	}
+
+	return true;
+}
+
+void UWarriorBehaviorTreeBudgetSubsystem::AddTreeTickCost(double InMs)
+{
+	FrameCostMs += InMs;
+	NumTreesTicked++;
+}
+
+bool UWarriorBehaviorTreeBudgetSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
@@ -0,0 +1,154 @@
+// ALL FREE
+
+
+#include "Subsystems/WarriorCountDownSubsystem.h"
+
+namespace WarriorCountDown
+{
+	constexpr float TickResolution = 0.01f;
+}
+
+void UWarriorCountDownSubsystem::Deinitialize()
+{
+	CountDownActions.Empty();
+	CountDownLookup.Empty();
+	TimerWheel.Reset();
+
+	Super::Deinitialize();
+}
+
+void UWarriorCountDownSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	UnconsumedTime += DeltaTime;
+
+	const int32 TicksToAdvance = FMath::FloorToInt32(UnconsumedTime / WarriorCountDown::TickResolution);
+
+	if (TicksToAdvance <= 0)
+	{
+		return;
+	}
+
+	UnconsumedTime -= TicksToAdvance * WarriorCountDown::TickResolution;
+
+	ExpiredEntryIndices.Reset();
+	TimerWheel.Advance(TicksToAdvance, ExpiredEntryIndices);
+
+	// Every expired timer is already out of the wheel, so none of their ids may be removed again by a callback below.
+	for (const int32 EntryIndex : ExpiredEntryIndices)
+	{
+		if (CountDownActions.IsValidIndex(EntryIndex))
+		{
+			CountDownActions[EntryIndex].TimerId = INDEX_NONE;
+		}
+	}
+
+	const uint64 CurrentTick = TimerWheel.GetCurrentTick();
+
+	for (const int32 EntryIndex : ExpiredEntryIndices)
+	{
+		if (!CountDownActions.IsValidIndex(EntryIndex)) continue;
+
+		FWarriorCountDownAction* Action = CountDownActions[EntryIndex].Action.Get();
+
+		// The wheel wakes an action at most once per frame, so pass on the real time since the last wake rather than the interval.
+		const float ElapsedTime = (CurrentTick - CountDownActions[EntryIndex].LastWakeTick) * WarriorCountDown::TickResolution;
+		CountDownActions[EntryIndex].LastWakeTick = CurrentTick;
+
+		if (Action->UpdateOperation(ElapsedTime))
+		{
+			RemoveCountDown(EntryIndex);
+			continue;
+		}
+
+		// A cancel that came in from one of the callbacks is reported on the next tick rather than a whole interval later.
+		FCountDownEntry& Entry = CountDownActions[EntryIndex];
+		Entry.TimerId = TimerWheel.AddTimer(Action->IsCancelled() ? 1 : Entry.IntervalTicks, EntryIndex);
+	}
+
+	if (TimerWheel.IsEmpty())
+	{
+		UnconsumedTime = 0.f;
+	}
+}
+
+bool UWarriorCountDownSubsystem::IsTickable() const
+{
+	return !TimerWheel.IsEmpty();
+}
+
+TStatId UWarriorCountDownSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorCountDownSubsystem, STATGROUP_Tickables);
+}
+
+void UWarriorCountDownSubsystem::StartCountDown(float InTotalTime, float InUpdateInterval, float& OutRemainingTime, EWarriorCountDownActionOutput& OutCountDownOutput, const FLatentActionInfo& InLatentInfo)
+{
+	const FCountDownKey Key(FObjectKey(InLatentInfo.CallbackTarget), InLatentInfo.UUID);
+
+	if (CountDownLookup.Contains(Key))
+	{
+		return;
+	}
+
+	// Intervals of zero used to mean every frame, the wheel resolution is the closest thing to that.
+	const float UpdateInterval = FMath::Max(InUpdateInterval, WarriorCountDown::TickResolution);
+
+	FCountDownEntry NewEntry;
+	NewEntry.Action = MakeUnique<FWarriorCountDownAction>(InTotalTime, UpdateInterval, OutRemainingTime, OutCountDownOutput, InLatentInfo);
+	NewEntry.Key = Key;
+	NewEntry.IntervalTicks = FMath::Max<uint64>(FMath::RoundToInt64(UpdateInterval / WarriorCountDown::TickResolution), 1);
+	NewEntry.LastWakeTick = TimerWheel.GetCurrentTick();
+
+	const int32 EntryIndex = CountDownActions.Add(MoveTemp(NewEntry));
+
+	FCountDownEntry& Entry = CountDownActions[EntryIndex];
+	Entry.TimerId = TimerWheel.AddTimer(Entry.IntervalTicks, EntryIndex);
+
+	CountDownLookup.Emplace(Key, EntryIndex);
+}
+
+void UWarriorCountDownSubsystem::CancelCountDown(const FLatentActionInfo& InLatentInfo)
+{
+	const int32* FoundEntryIndex = CountDownLookup.Find(FCountDownKey(FObjectKey(InLatentInfo.CallbackTarget), InLatentInfo.UUID));
+
+	if (!FoundEntryIndex)
+	{
+		return;
+	}
+
+	FCountDownEntry& Entry = CountDownActions[*FoundEntryIndex];
+
+	if (Entry.Action->IsCancelled())
+	{
+		return;
+	}
+
+	Entry.Action->CancelAction();
+
+	// Cancelled fires on the next tick, never from inside the node that asked for it.
+	if (Entry.TimerId != INDEX_NONE)
+	{
+		TimerWheel.RemoveTimer(Entry.TimerId);
+		Entry.TimerId = TimerWheel.AddTimer(1, *FoundEntryIndex);
+	}
+}
+
+bool UWarriorCountDownSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UWarriorCountDownSubsystem::RemoveCountDown(int32 InEntryIndex)
+{
+	FCountDownEntry& Entry = CountDownActions[InEntryIndex];
+
+	if (Entry.TimerId != INDEX_NONE)
+	{
+		TimerWheel.RemoveTimer(Entry.TimerId);
+	}
+
+	CountDownLookup.Remove(Entry.Key);
+	CountDownActions.RemoveAt(InEntryIndex);
+}
@@ -0,0 +1,325 @@
+// ALL FREE
+
+
+#include "Subsystems/WarriorEnemyLODSubsystem.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#include "Navigation/CrowdFollowingComponent.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameControllers/WarriorAIController.h"
+#include "Subsystems/WarriorAttackTokenSubsystem.h"
+#include "Subsystems/WarriorTelemetrySubsystem.h"
+#include "WarriorFunctionLibrary.h"
+#include "WarriorGameplayTags.h"
+#include "WarriorStats.h"
+
+static TAutoConsoleVariable<bool> CVarWarriorEnemyLODEnabled(
+	TEXT("Warrior.EnemyLOD.Enabled"),
+	true,
+	TEXT("Scale enemy crowd avoidance with distance to the hero and crowd size. Read when a game world starts."));
+
+static TAutoConsoleVariable<float> CVarWarriorEnemyLODInterval(
+	TEXT("Warrior.EnemyLOD.Interval"),
+	0.25f,
+	TEXT("Seconds between enemy level of detail passes."));
+
+static TAutoConsoleVariable<float> CVarWarriorEnemyLODNearDistance(
+	TEXT("Warrior.EnemyLOD.NearDistance"),
+	1500.f,
+	TEXT("Moving enemies closer than this to the hero may keep full crowd avoidance quality."));
+
+static TAutoConsoleVariable<float> CVarWarriorEnemyLODFarDistance(
+	TEXT("Warrior.EnemyLOD.FarDistance"),
+	4000.f,
+	TEXT("Moving enemies further than this from the hero drop to low crowd avoidance quality."));
+
+static TAutoConsoleVariable<int32> CVarWarriorEnemyLODMaxFullQualityAgents(
+	TEXT("Warrior.EnemyLOD.MaxFullQualityAgents"),
+	12,
+	TEXT("How many of the closest moving enemies keep full crowd avoidance quality. Detour cost climbs steeply with the number of agents at high quality."));
+
+static TAutoConsoleVariable<float> CVarWarriorEnemyLODMovementNearDistance(
+	TEXT("Warrior.EnemyLOD.MovementNearDistance"),
+	2500.f,
+	TEXT("Enemies closer than this to the hero always run full walking physics."));
+
+static TAutoConsoleVariable<float> CVarWarriorEnemyLODMovementFarDistance(
+	TEXT("Warrior.EnemyLOD.MovementFarDistance"),
+	5000.f,
+	TEXT("Enemies further than this from the hero nav walk even while on screen."));
+
+static TAutoConsoleVariable<float> CVarWarriorEnemyLODOffscreenMovementTickInterval(
+	TEXT("Warrior.EnemyLOD.OffscreenMovementTickInterval"),
+	0.1f,
+	TEXT("Seconds between movement updates of nav walking enemies nobody can see. 0 keeps them at every frame."));
+
+bool UWarriorEnemyLODSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return CVarWarriorEnemyLODEnabled.GetValueOnGameThread() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UWarriorEnemyLODSubsystem::Deinitialize()
+{
+	Entries.Empty();
+	MovingEnemies.Empty();
+
+	SET_DWORD_STAT(STAT_Warrior_CrowdAgentsSimulated, 0);
+	SET_DWORD_STAT(STAT_Warrior_CrowdAgentsFullQuality, 0);
+	SET_DWORD_STAT(STAT_Warrior_EnemiesNavWalking, 0);
+
+	Super::Deinitialize();
+}
+
+void UWarriorEnemyLODSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	AccumulatedDeltaTime += DeltaTime;
+
+	if (AccumulatedDeltaTime < CVarWarriorEnemyLODInterval.GetValueOnGameThread())
+	{
+		return;
+	}
+
+	AccumulatedDeltaTime = 0.f;
+
+	SCOPE_CYCLE_COUNTER(STAT_Warrior_EnemyLODPass);
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	Entries.RemoveAllSwap([](const FEnemyLODEntry& InEntry) { return !InEntry.Controller.IsValid() || (InEntry.bScaleCrowdAvoidance && !InEntry.CrowdComp.IsValid()); }, EAllowShrinking::No);
+
+	const APawn* Hero = UGameplayStatics::GetPlayerPawn(this, 0);
+
+	UpdateCrowdLOD(Hero);
+	UpdateMovementLOD(Hero);
+
+	TotalPassMs += FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+}
+
+bool UWarriorEnemyLODSubsystem::IsTickable() const
+{
+	return !Entries.IsEmpty();
+}
+
+TStatId UWarriorEnemyLODSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorEnemyLODSubsystem, STATGROUP_Tickables);
+}
+
+void UWarriorEnemyLODSubsystem::RegisterEnemy(AWarriorAIController* InController, bool bInScaleCrowdAvoidance, ECrowdAvoidanceQuality::Type InFullQuality, float InFullQueryRange)
+{
+	check(InController);
+
+	UCrowdFollowingComponent* CrowdComp = Cast<UCrowdFollowingComponent>(InController->GetPathFollowingComponent());
+
+	if (Entries.ContainsByPredicate([InController](const FEnemyLODEntry& InEntry) { return InEntry.Controller == InController; }))
+	{
+		return;
+	}
+
+	FEnemyLODEntry& NewEntry = Entries.AddDefaulted_GetRef();
+	NewEntry.CrowdComp = CrowdComp;
+	NewEntry.Controller = InController;
+	NewEntry.bScaleCrowdAvoidance = bInScaleCrowdAvoidance && CrowdComp;
+	NewEntry.FullQuality = InFullQuality;
+	NewEntry.FullQueryRange = InFullQueryRange;
+}
+
+void UWarriorEnemyLODSubsystem::UnregisterEnemy(const AWarriorAIController* InController)
+{
+	Entries.RemoveAllSwap([InController](const FEnemyLODEntry& InEntry) { return InEntry.Controller == InController; }, EAllowShrinking::No);
+}
+
+bool UWarriorEnemyLODSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UWarriorEnemyLODSubsystem::UpdateCrowdLOD(const APawn* InHero)
+{
+	const FVector HeroLocation = InHero ? InHero->GetActorLocation() : FVector::ZeroVector;
+
+	MovingEnemies.Reset();
+
+	for (int32 Index = 0; Index < Entries.Num(); Index++)
+	{
+		FEnemyLODEntry& Entry = Entries[Index];
+		const APawn* EnemyPawn = Entry.Controller->GetPawn();
+
+		if (!Entry.bScaleCrowdAvoidance)
+		{
+			continue;
+		}
+
+		// Standing enemies only need to be avoided, not to avoid. They rejoin in AWarriorAIController::RequestMove.
+		if (!EnemyPawn || Entry.CrowdComp->GetStatus() == EPathFollowingStatus::Idle)
+		{
+			ApplyCrowdLOD(Entry, ECrowdLOD::Idle);
+			continue;
+		}
+
+		// Without a hero there is nothing to be near, so only the crowd size budget applies.
+		const float DistanceSquared = InHero ? FVector::DistSquared(EnemyPawn->GetActorLocation(), HeroLocation) : 0.f;
+		MovingEnemies.Emplace(DistanceSquared, Index);
+	}
+
+	MovingEnemies.Sort([](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Key < B.Key; });
+
+	const float NearDistanceSquared = FMath::Square(CVarWarriorEnemyLODNearDistance.GetValueOnGameThread());
+	const float FarDistanceSquared = FMath::Square(CVarWarriorEnemyLODFarDistance.GetValueOnGameThread());
+	const int32 MaxFullQualityAgents = CVarWarriorEnemyLODMaxFullQualityAgents.GetValueOnGameThread();
+
+	int32 NumFullQuality = 0;
+
+	for (const TPair<float, int32>& MovingEnemy : MovingEnemies)
+	{
+		ECrowdLOD CrowdLOD = ECrowdLOD::Minimal;
+
+		if (MovingEnemy.Key < NearDistanceSquared && NumFullQuality < MaxFullQualityAgents)
+		{
+			CrowdLOD = ECrowdLOD::Full;
+			NumFullQuality++;
+		}
+		else if (MovingEnemy.Key < FarDistanceSquared)
+		{
+			CrowdLOD = ECrowdLOD::Reduced;
+		}
+
+		ApplyCrowdLOD(Entries[MovingEnemy.Value], CrowdLOD);
+	}
+
+	const int32 NumSimulatedAgents = MovingEnemies.Num();
+
+	SET_DWORD_STAT(STAT_Warrior_CrowdAgentsSimulated, NumSimulatedAgents);
+	SET_DWORD_STAT(STAT_Warrior_CrowdAgentsFullQuality, NumFullQuality);
+
+	// Lets the telemetry analyzer line frame times up with the size of the simulated crowd.
+	if (NumSimulatedAgents != LastRecordedSimulatedAgents)
+	{
+		LastRecordedSimulatedAgents = NumSimulatedAgents;
+		UWarriorTelemetrySubsystem::RecordMarker(this, EWarriorTelemetryMarker::CrowdAgents, NumSimulatedAgents);
+	}
+}
+
+void UWarriorEnemyLODSubsystem::ApplyCrowdLOD(FEnemyLODEntry& InEntry, ECrowdLOD InCrowdLOD)
+{
+	UCrowdFollowingComponent* CrowdComp = InEntry.CrowdComp.Get();
+
+	// Checked against the component, a move may have put the agent back into the crowd since the last pass.
+	if (InCrowdLOD == ECrowdLOD::Idle)
+	{
+		// The simulation state can only change while the agent is idle, which is the only time this is asked for.
+		if (CrowdComp->IsCrowdSimulationEnabled())
+		{
+			CrowdComp->SetCrowdSimulationState(ECrowdSimulationState::ObstacleOnly);
+		}
+
+		InEntry.AppliedCrowdLOD = InCrowdLOD;
+		return;
+	}
+
+	if (InEntry.AppliedCrowdLOD == InCrowdLOD)
+	{
+		return;
+	}
+
+	switch (InCrowdLOD)
+	{
+	case ECrowdLOD::Full:
+		CrowdComp->SetCrowdAvoidanceQuality(InEntry.FullQuality);
+		CrowdComp->SetCrowdCollisionQueryRange(InEntry.FullQueryRange);
+		break;
+	case ECrowdLOD::Reduced:
+		CrowdComp->SetCrowdAvoidanceQuality(FMath::Min(InEntry.FullQuality, ECrowdAvoidanceQuality::Medium));
+		CrowdComp->SetCrowdCollisionQueryRange(InEntry.FullQueryRange * 0.5f);
+		break;
+	case ECrowdLOD::Minimal:
+		CrowdComp->SetCrowdAvoidanceQuality(ECrowdAvoidanceQuality::Low);
+		CrowdComp->SetCrowdCollisionQueryRange(InEntry.FullQueryRange * 0.25f);
+		break;
+	default:
+		break;
+	}
+
+	InEntry.AppliedCrowdLOD = InCrowdLOD;
+}
+
+void UWarriorEnemyLODSubsystem::UpdateMovementLOD(const APawn* InHero)
+{
+	const float MovementNearDistanceSquared = FMath::Square(CVarWarriorEnemyLODMovementNearDistance.GetValueOnGameThread());
+	const float MovementFarDistanceSquared = FMath::Square(CVarWarriorEnemyLODMovementFarDistance.GetValueOnGameThread());
+	const UWarriorAttackTokenSubsystem* AttackTokenSubsystem = GetWorld()->GetSubsystem<UWarriorAttackTokenSubsystem>();
+
+	int32 NumNavWalking = 0;
+
+	for (FEnemyLODEntry& Entry : Entries)
+	{
+		ACharacter* EnemyCharacter = Cast<ACharacter>(Entry.Controller->GetPawn());
+
+		if (!EnemyCharacter)
+		{
+			continue;
+		}
+
+		EMovementLOD MovementLOD = EMovementLOD::Full;
+
+		if (InHero)
+		{
+			const float DistanceSquared = FVector::DistSquared(EnemyCharacter->GetActorLocation(), InHero->GetActorLocation());
+
+			// Anything fighting needs real collision, whatever its distance.
+			const bool bInCombat = (AttackTokenSubsystem && AttackTokenSubsystem->HasToken(EnemyCharacter))
+				|| UWarriorFunctionLibrary::NativeDoesActorHaveTag(EnemyCharacter, WarriorGameplayTags::Enemy_Status_UnderAttack);
+
+			if (DistanceSquared >= MovementNearDistanceSquared && !bInCombat)
+			{
+				if (!EnemyCharacter->WasRecentlyRendered(0.25f))
+				{
+					MovementLOD = EMovementLOD::NavWalkingThrottled;
+				}
+				else if (DistanceSquared >= MovementFarDistanceSquared)
+				{
+					MovementLOD = EMovementLOD::NavWalking;
+				}
+			}
+		}
+
+		ApplyMovementLOD(Entry, *EnemyCharacter, MovementLOD);
+
+		NumNavWalking += MovementLOD != EMovementLOD::Full;
+	}
+
+	SET_DWORD_STAT(STAT_Warrior_EnemiesNavWalking, NumNavWalking);
+}
+
+void UWarriorEnemyLODSubsystem::ApplyMovementLOD(FEnemyLODEntry& InEntry, ACharacter& InCharacter, EMovementLOD InMovementLOD)
+{
+	UCharacterMovementComponent* MovementComp = InCharacter.GetCharacterMovement();
+
+	// Falling, flying and custom modes are left alone, only walking swaps with nav walking.
+	if (InMovementLOD == EMovementLOD::Full)
+	{
+		if (MovementComp->MovementMode == MOVE_NavWalking)
+		{
+			MovementComp->SetMovementMode(MOVE_Walking);
+		}
+	}
+	else if (MovementComp->MovementMode == MOVE_Walking)
+	{
+		MovementComp->SetMovementMode(MOVE_NavWalking);
+	}
+
+	if (InEntry.AppliedMovementLOD == InMovementLOD)
+	{
+		return;
+	}
+
+	// Ticks at an interval get the whole time since their last tick, so the enemy still covers the same ground.
+	const float MovementTickInterval = InMovementLOD == EMovementLOD::NavWalkingThrottled ? CVarWarriorEnemyLODOffscreenMovementTickInterval.GetValueOnGameThread() : 0.f;
+	MovementComp->SetComponentTickInterval(MovementTickInterval);
+
+	InEntry.AppliedMovementLOD = InMovementLOD;
+}
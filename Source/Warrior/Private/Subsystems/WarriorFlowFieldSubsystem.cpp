@@ -0,0 +1,398 @@
+// ALL FREE
+
+
+#include "Subsystems/WarriorFlowFieldSubsystem.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Pawn.h"
+#include "Kismet/GameplayStatics.h"
+#include "NavigationSystem.h"
+#include "NavMesh/NavMeshBoundsVolume.h"
+#include "WarriorStats.h"
+
+#include "WarriorDebugHelper.h"
+
+static TAutoConsoleVariable<bool> CVarWarriorFlowFieldEnabled(
+	TEXT("Warrior.FlowField.Enabled"),
+	true,
+	TEXT("Build a shared flow field towards the hero for BTTask_FollowFlowField. Read when a game world starts."));
+
+static TAutoConsoleVariable<float> CVarWarriorFlowFieldCellSize(
+	TEXT("Warrior.FlowField.CellSize"),
+	200.f,
+	TEXT("Grid cell size. Grows on its own when the nav mesh bounds would need more than Warrior.FlowField.MaxCellsPerAxis cells. Read when a game world starts."));
+
+static TAutoConsoleVariable<int32> CVarWarriorFlowFieldMaxCellsPerAxis(
+	TEXT("Warrior.FlowField.MaxCellsPerAxis"),
+	256,
+	TEXT("Upper bound on the grid size along X and Y. Read when a game world starts."));
+
+static TAutoConsoleVariable<int32> CVarWarriorFlowFieldGridCellsPerFrame(
+	TEXT("Warrior.FlowField.GridCellsPerFrame"),
+	128,
+	TEXT("Nav mesh projections or raycasts per frame while the grid is being set up."));
+
+static TAutoConsoleVariable<int32> CVarWarriorFlowFieldFieldCellsPerFrame(
+	TEXT("Warrior.FlowField.FieldCellsPerFrame"),
+	2048,
+	TEXT("Cells the distance field expands per frame while it is being rebuilt."));
+
+namespace WarriorFlowField
+{
+	/** East, north, west, south, then the diagonals in the same turning order */
+	constexpr int32 NumDirections = 8;
+	constexpr int32 NumStraightDirections = 4;
+	constexpr int32 DirectionX[NumDirections] = { 1, 0, -1, 0, 1, -1, -1, 1 };
+	constexpr int32 DirectionY[NumDirections] = { 0, 1, 0, -1, 1, 1, -1, -1 };
+
+	/** The two straight directions a diagonal is made of */
+	constexpr int32 DiagonalParts[NumDirections - NumStraightDirections][2] = { { 0, 1 }, { 2, 1 }, { 2, 3 }, { 0, 3 } };
+
+	constexpr float Unreachable = TNumericLimits<float>::Max();
+}
+
+bool UWarriorFlowFieldSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return CVarWarriorFlowFieldEnabled.GetValueOnGameThread() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UWarriorFlowFieldSubsystem::Deinitialize()
+{
+	CellHeights.Empty();
+	CellConnections.Empty();
+	CellDistances.Empty();
+	BuildingCellDistances.Empty();
+	OpenCells.Empty();
+	Followers.Empty();
+
+	SET_DWORD_STAT(STAT_Warrior_FlowFieldFollowers, 0);
+
+	Super::Deinitialize();
+}
+
+void UWarriorFlowFieldSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	FBox NavBounds(ForceInit);
+
+	for (TActorIterator<ANavMeshBoundsVolume> It(&InWorld); It; ++It)
+	{
+		NavBounds += It->GetComponentsBoundingBox();
+	}
+
+	if (!NavBounds.IsValid)
+	{
+		return;
+	}
+
+	const FVector NavExtent = NavBounds.GetSize();
+	const int32 MaxCellsPerAxis = FMath::Max(CVarWarriorFlowFieldMaxCellsPerAxis.GetValueOnGameThread(), 1);
+
+	CellSize = FMath::Max3(CVarWarriorFlowFieldCellSize.GetValueOnGameThread(), NavExtent.X / MaxCellsPerAxis, NavExtent.Y / MaxCellsPerAxis);
+	NumCellsX = FMath::Max(FMath::CeilToInt32(NavExtent.X / CellSize), 1);
+	NumCellsY = FMath::Max(FMath::CeilToInt32(NavExtent.Y / CellSize), 1);
+	GridOrigin = FVector2D(NavBounds.Min);
+	GridZ = NavBounds.GetCenter().Z;
+	GridHalfHeight = NavExtent.Z * 0.5f;
+
+	const int32 NumCells = NumCellsX * NumCellsY;
+	CellHeights.SetNum(NumCells);
+	CellConnections.SetNumZeroed(NumCells);
+
+	GridBuildPhase = EGridBuildPhase::ProjectingCells;
+	NextCellToBuild = 0;
+
+	WARRIOR_LOG(Log, TEXT("Flow field grid %dx%d, cells of %.0f"), NumCellsX, NumCellsY, CellSize);
+}
+
+void UWarriorFlowFieldSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_Warrior_FlowFieldUpdate);
+
+	if (GridBuildPhase != EGridBuildPhase::Done)
+	{
+		int32 GridBudget = CVarWarriorFlowFieldGridCellsPerFrame.GetValueOnGameThread();
+		StepGridBuild(GridBudget);
+		return;
+	}
+
+	const APawn* Hero = UGameplayStatics::GetPlayerPawn(this, 0);
+	TargetLocation = Hero ? Hero->GetActorLocation() : TOptional<FVector>();
+
+	if (OpenCells.IsEmpty() && TargetLocation)
+	{
+		// A hero off the nav mesh, mid jump for example, keeps the field it had.
+		const int32 HeroCellIndex = WorldToCellIndex(*TargetLocation);
+
+		if (HeroCellIndex != INDEX_NONE && HeroCellIndex != FieldTargetCellIndex && CellHeights[HeroCellIndex].IsSet())
+		{
+			StartFieldBuild(HeroCellIndex);
+		}
+	}
+
+	if (!OpenCells.IsEmpty())
+	{
+		int32 FieldBudget = CVarWarriorFlowFieldFieldCellsPerFrame.GetValueOnGameThread();
+		StepFieldBuild(FieldBudget);
+	}
+
+	Followers.RemoveAllSwap([](const TWeakObjectPtr<APawn>& InFollower) { return !InFollower.IsValid(); }, EAllowShrinking::No);
+
+	SET_DWORD_STAT(STAT_Warrior_FlowFieldFollowers, Followers.Num());
+
+	MoveFollowers();
+}
+
+bool UWarriorFlowFieldSubsystem::IsTickable() const
+{
+	return GridBuildPhase != EGridBuildPhase::None;
+}
+
+TStatId UWarriorFlowFieldSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorFlowFieldSubsystem, STATGROUP_Tickables);
+}
+
+bool UWarriorFlowFieldSubsystem::GetFlowDirection(const FVector& InLocation, FVector& OutDirection) const
+{
+	const int32 CellIndex = WorldToCellIndex(InLocation);
+
+	if (CellIndex == INDEX_NONE || CellDistances.IsEmpty() || CellDistances[CellIndex] == WarriorFlowField::Unreachable)
+	{
+		return false;
+	}
+
+	int32 BestCellIndex = CellIndex;
+
+	for (int32 Direction = 0; Direction < WarriorFlowField::NumDirections; Direction++)
+	{
+		const int32 NeighbourIndex = GetConnectedNeighbour(CellIndex, Direction);
+
+		if (NeighbourIndex != INDEX_NONE && CellDistances[NeighbourIndex] < CellDistances[BestCellIndex])
+		{
+			BestCellIndex = NeighbourIndex;
+		}
+	}
+
+	// Heading for the next cell's centre rather than along a fixed direction keeps followers off the walls.
+	const FVector NextLocation = BestCellIndex != CellIndex ? GetCellLocation(BestCellIndex) : TargetLocation.Get(InLocation);
+	OutDirection = (NextLocation - InLocation).GetSafeNormal2D();
+
+	return !OutDirection.IsNearlyZero();
+}
+
+void UWarriorFlowFieldSubsystem::RegisterFollower(APawn* InPawn)
+{
+	check(InPawn);
+
+	Followers.AddUnique(InPawn);
+}
+
+void UWarriorFlowFieldSubsystem::UnregisterFollower(const APawn* InPawn)
+{
+	Followers.RemoveAllSwap([InPawn](const TWeakObjectPtr<APawn>& InFollower) { return InFollower == InPawn; }, EAllowShrinking::No);
+}
+
+bool UWarriorFlowFieldSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UWarriorFlowFieldSubsystem::StepGridBuild(int32& InOutBudget)
+{
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+
+	if (!NavSys)
+	{
+		return;
+	}
+
+	const int32 NumCells = CellHeights.Num();
+	const FVector ProjectionExtent(CellSize * 0.5f, CellSize * 0.5f, GridHalfHeight);
+
+	while (InOutBudget > 0 && GridBuildPhase == EGridBuildPhase::ProjectingCells)
+	{
+		const int32 CellIndex = NextCellToBuild++;
+		const FVector2D CellCenter = GridOrigin + FVector2D(CellIndex % NumCellsX + 0.5f, CellIndex / NumCellsX + 0.5f) * CellSize;
+
+		FNavLocation NavLocation;
+
+		if (NavSys->ProjectPointToNavigation(FVector(CellCenter, GridZ), NavLocation, ProjectionExtent))
+		{
+			CellHeights[CellIndex] = NavLocation.Location.Z;
+		}
+
+		InOutBudget--;
+
+		if (NextCellToBuild == NumCells)
+		{
+			GridBuildPhase = EGridBuildPhase::ConnectingCells;
+			NextCellToBuild = 0;
+		}
+	}
+
+	// Each cell raycasts east and north and fills in its neighbours' west and south, so every edge is tested once.
+	while (InOutBudget > 0 && GridBuildPhase == EGridBuildPhase::ConnectingCells)
+	{
+		const int32 CellIndex = NextCellToBuild++;
+
+		for (int32 Direction = 0; Direction < 2 && CellHeights[CellIndex].IsSet(); Direction++)
+		{
+			const int32 NeighbourX = CellIndex % NumCellsX + WarriorFlowField::DirectionX[Direction];
+			const int32 NeighbourY = CellIndex / NumCellsX + WarriorFlowField::DirectionY[Direction];
+
+			if (NeighbourX >= NumCellsX || NeighbourY >= NumCellsY)
+			{
+				continue;
+			}
+
+			const int32 NeighbourIndex = NeighbourY * NumCellsX + NeighbourX;
+
+			FVector HitLocation;
+
+			if (!CellHeights[NeighbourIndex].IsSet() || UNavigationSystemV1::NavigationRaycast(GetWorld(), GetCellLocation(CellIndex), GetCellLocation(NeighbourIndex), HitLocation))
+			{
+				continue;
+			}
+
+			CellConnections[CellIndex] |= 1 << Direction;
+			CellConnections[NeighbourIndex] |= 1 << (Direction + 2);
+
+			InOutBudget--;
+		}
+
+		InOutBudget--;
+
+		if (NextCellToBuild == NumCells)
+		{
+			GridBuildPhase = EGridBuildPhase::Done;
+		}
+	}
+}
+
+void UWarriorFlowFieldSubsystem::StepFieldBuild(int32& InOutBudget)
+{
+	const auto OpenCellPredicate = [](const FOpenCell& A, const FOpenCell& B) { return A.Distance < B.Distance; };
+
+	while (InOutBudget > 0 && !OpenCells.IsEmpty())
+	{
+		FOpenCell OpenCell;
+		OpenCells.HeapPop(OpenCell, OpenCellPredicate, EAllowShrinking::No);
+
+		// Cells are pushed again when a shorter way turns up, the stale entries are skipped here.
+		if (OpenCell.Distance > BuildingCellDistances[OpenCell.CellIndex])
+		{
+			continue;
+		}
+
+		for (int32 Direction = 0; Direction < WarriorFlowField::NumDirections; Direction++)
+		{
+			const int32 NeighbourIndex = GetConnectedNeighbour(OpenCell.CellIndex, Direction);
+
+			if (NeighbourIndex == INDEX_NONE)
+			{
+				continue;
+			}
+
+			const float StepLength = Direction < WarriorFlowField::NumStraightDirections ? CellSize : CellSize * UE_SQRT_2;
+			const float NeighbourDistance = OpenCell.Distance + StepLength;
+
+			if (NeighbourDistance < BuildingCellDistances[NeighbourIndex])
+			{
+				BuildingCellDistances[NeighbourIndex] = NeighbourDistance;
+				OpenCells.HeapPush({ NeighbourDistance, NeighbourIndex }, OpenCellPredicate);
+			}
+		}
+
+		InOutBudget--;
+	}
+
+	if (OpenCells.IsEmpty())
+	{
+		Swap(CellDistances, BuildingCellDistances);
+		FieldTargetCellIndex = BuildingTargetCellIndex;
+	}
+}
+
+void UWarriorFlowFieldSubsystem::StartFieldBuild(int32 InTargetCellIndex)
+{
+	BuildingCellDistances.Init(WarriorFlowField::Unreachable, CellHeights.Num());
+	BuildingCellDistances[InTargetCellIndex] = 0.f;
+	BuildingTargetCellIndex = InTargetCellIndex;
+
+	OpenCells.Reset();
+	OpenCells.Add({ 0.f, InTargetCellIndex });
+}
+
+void UWarriorFlowFieldSubsystem::MoveFollowers() const
+{
+	for (const TWeakObjectPtr<APawn>& Follower : Followers)
+	{
+		APawn* Pawn = Follower.Get();
+
+		FVector FlowDirection;
+
+		if (GetFlowDirection(Pawn->GetActorLocation(), FlowDirection))
+		{
+			Pawn->AddMovementInput(FlowDirection);
+		}
+	}
+}
+
+int32 UWarriorFlowFieldSubsystem::WorldToCellIndex(const FVector& InLocation) const
+{
+	if (CellSize <= 0.f)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 CellX = FMath::FloorToInt32((InLocation.X - GridOrigin.X) / CellSize);
+	const int32 CellY = FMath::FloorToInt32((InLocation.Y - GridOrigin.Y) / CellSize);
+
+	if (CellX < 0 || CellY < 0 || CellX >= NumCellsX || CellY >= NumCellsY)
+	{
+		return INDEX_NONE;
+	}
+
+	return CellY * NumCellsX + CellX;
+}
+
+FVector UWarriorFlowFieldSubsystem::GetCellLocation(int32 InCellIndex) const
+{
+	const FVector2D CellCenter = GridOrigin + FVector2D(InCellIndex % NumCellsX + 0.5f, InCellIndex / NumCellsX + 0.5f) * CellSize;
+
+	return FVector(CellCenter, CellHeights[InCellIndex].Get(GridZ));
+}
+
+int32 UWarriorFlowFieldSubsystem::GetConnectedNeighbour(int32 InCellIndex, int32 InDirection) const
+{
+	if (InDirection < WarriorFlowField::NumStraightDirections)
+	{
+		if (!(CellConnections[InCellIndex] & (1 << InDirection)))
+		{
+			return INDEX_NONE;
+		}
+
+		return InCellIndex + WarriorFlowField::DirectionY[InDirection] * NumCellsX + WarriorFlowField::DirectionX[InDirection];
+	}
+
+	// A diagonal needs both straight routes around the corner to be open, so followers never cut through a wall's edge.
+	const int32 FirstPart = WarriorFlowField::DiagonalParts[InDirection - WarriorFlowField::NumStraightDirections][0];
+	const int32 SecondPart = WarriorFlowField::DiagonalParts[InDirection - WarriorFlowField::NumStraightDirections][1];
+
+	const int32 FirstNeighbourIndex = GetConnectedNeighbour(InCellIndex, FirstPart);
+	const int32 SecondNeighbourIndex = GetConnectedNeighbour(InCellIndex, SecondPart);
+
+	if (FirstNeighbourIndex == INDEX_NONE || SecondNeighbourIndex == INDEX_NONE)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 ViaFirstIndex = GetConnectedNeighbour(FirstNeighbourIndex, SecondPart);
+
+	return ViaFirstIndex != INDEX_NONE && ViaFirstIndex == GetConnectedNeighbour(SecondNeighbourIndex, FirstPart) ? ViaFirstIndex : INDEX_NONE;
+}
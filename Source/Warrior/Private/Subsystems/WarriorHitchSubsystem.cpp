@@ -0,0 +1,202 @@
+// ALL FREE
+
+
+#include "Subsystems/WarriorHitchSubsystem.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "ProfilingDebugging/TraceAuxiliary.h"
+#include "Tasks/Task.h"
+#include "EngineUtils.h"
+#include "Characters/WarriorEnemyCharacter.h"
+#include "GameModes/WarriorSurvialGamemode.h"
+#include "WarriorFunctionLibrary.h"
+#include "WarriorGameplayTags.h"
+
+#include "WarriorDebugHelper.h"
+
+static TAutoConsoleVariable<bool> CVarWarriorHitchEnabled(
+	TEXT("Warrior.Hitch.Enabled"),
+	true,
+	TEXT("Report game frames over Warrior.Hitch.ThresholdMs. Read when a game world starts."));
+
+static TAutoConsoleVariable<float> CVarWarriorHitchThresholdMs(
+	TEXT("Warrior.Hitch.ThresholdMs"),
+	50.f,
+	TEXT("Frames longer than this are reported as hitches."));
+
+static TAutoConsoleVariable<float> CVarWarriorHitchMinSecondsBetweenReports(
+	TEXT("Warrior.Hitch.MinSecondsBetweenReports"),
+	5.f,
+	TEXT("Hitches closer together than this are only logged, so a bad patch does not flood the disk."));
+
+static TAutoConsoleVariable<int32> CVarWarriorHitchTraceSnapshotDelayFrames(
+	TEXT("Warrior.Hitch.TraceSnapshotDelayFrames"),
+	30,
+	TEXT("Frames to wait after a hitch before saving the trace snapshot, so it also shows what followed. Negative disables snapshots."));
+
+bool UWarriorHitchSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return WARRIOR_ENABLE_HITCH_SCOPES && CVarWarriorHitchEnabled.GetValueOnGameThread() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UWarriorHitchSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PreGarbageCollectDelegateHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddUObject(this, &ThisClass::OnPreGarbageCollect);
+	PostGarbageCollectDelegateHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(this, &ThisClass::OnPostGarbageCollect);
+}
+
+void UWarriorHitchSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGarbageCollectDelegateHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectDelegateHandle);
+
+	Super::Deinitialize();
+}
+
+void UWarriorHitchSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Measured between our own ticks rather than from DeltaTime, which is clamped and dilated.
+	const double CurrentTime = FPlatformTime::Seconds();
+	const double FrameMs = LastTickTime > 0.0 ? (CurrentTime - LastTickTime) * 1000.0 : 0.0;
+	LastTickTime = CurrentTime;
+
+	WarriorStats::FHitchScopeTimings ScopeTimings;
+	WarriorStats::ConsumeHitchScopeTimings(ScopeTimings);
+
+	if (FrameMs >= CVarWarriorHitchThresholdMs.GetValueOnGameThread())
+	{
+		ReportHitch(FrameMs, ScopeTimings);
+	}
+
+	if (!PendingTraceSnapshotPath.IsEmpty() && GFrameCounter >= PendingTraceSnapshotFrame)
+	{
+		WritePendingTraceSnapshot();
+	}
+}
+
+TStatId UWarriorHitchSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorHitchSubsystem, STATGROUP_Tickables);
+}
+
+bool UWarriorHitchSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UWarriorHitchSubsystem::ReportHitch(double InFrameMs, const WarriorStats::FHitchScopeTimings& InScopeTimings)
+{
+	const AWarriorSurvialGamemode* SurvialGamemode = GetWorld()->GetAuthGameMode<AWarriorSurvialGamemode>();
+	const int32 WaveCount = SurvialGamemode ? SurvialGamemode->GetCurrentWaveCount() : INDEX_NONE;
+	const int32 NumAliveEnemies = CountAliveEnemies();
+
+	TArray<int32, TInlineAllocator<static_cast<uint8>(EWarriorHitchScope::Num)>> ActiveScopeIndices;
+
+	for (int32 ScopeIndex = 0; ScopeIndex < static_cast<uint8>(EWarriorHitchScope::Num); ScopeIndex++)
+	{
+		if (InScopeTimings[ScopeIndex].Count > 0)
+		{
+			ActiveScopeIndices.Add(ScopeIndex);
+		}
+	}
+
+	ActiveScopeIndices.Sort([&InScopeTimings](int32 A, int32 B) { return InScopeTimings[A].TotalMs > InScopeTimings[B].TotalMs; });
+
+	const FString TopScope = ActiveScopeIndices.IsEmpty() ? TEXT("none") : LexToString(static_cast<EWarriorHitchScope>(ActiveScopeIndices[0]));
+
+	WARRIOR_LOG(Warning, TEXT("Hitch: %.1f ms at frame %llu, wave %d, %d alive enemies, top scope %s"), InFrameMs, GFrameCounter, WaveCount, NumAliveEnemies, *TopScope);
+
+	const double CurrentTime = FPlatformTime::Seconds();
+
+	if (CurrentTime - LastReportTime < CVarWarriorHitchMinSecondsBetweenReports.GetValueOnGameThread())
+	{
+		return;
+	}
+
+	LastReportTime = CurrentTime;
+
+	const FString ReportDir = FPaths::ProjectSavedDir() / TEXT("Profiling") / TEXT("Hitches");
+	const FString ReportBaseName = FString::Printf(TEXT("Hitch_%s_%s_F%llu"), *GetWorld()->GetMapName(), *FDateTime::Now().ToString(), GFrameCounter);
+
+	FString TraceSnapshotPath;
+
+#if UE_TRACE_ENABLED
+	const int32 TraceSnapshotDelayFrames = CVarWarriorHitchTraceSnapshotDelayFrames.GetValueOnGameThread();
+
+	if (TraceSnapshotDelayFrames >= 0 && PendingTraceSnapshotPath.IsEmpty())
+	{
+		TraceSnapshotPath = ReportDir / ReportBaseName + TEXT(".utrace");
+
+		PendingTraceSnapshotPath = TraceSnapshotPath;
+		PendingTraceSnapshotFrame = GFrameCounter + TraceSnapshotDelayFrames;
+	}
+#endif
+
+	FString Report;
+	Report += FString::Printf(TEXT("Frame: %llu\n"), GFrameCounter);
+	Report += FString::Printf(TEXT("FrameMs: %.2f\n"), InFrameMs);
+	Report += FString::Printf(TEXT("ThresholdMs: %.2f\n"), CVarWarriorHitchThresholdMs.GetValueOnGameThread());
+	Report += FString::Printf(TEXT("Map: %s\n"), *GetWorld()->GetMapName());
+	Report += FString::Printf(TEXT("Wave: %d\n"), WaveCount);
+	Report += FString::Printf(TEXT("AliveEnemies: %d\n"), NumAliveEnemies);
+	Report += FString::Printf(TEXT("TraceSnapshot: %s\n"), TraceSnapshotPath.IsEmpty() ? TEXT("none") : *FPaths::GetCleanFilename(TraceSnapshotPath));
+	Report += TEXT("Scopes (inclusive game thread ms, count):\n");
+
+	for (const int32 ScopeIndex : ActiveScopeIndices)
+	{
+		Report += FString::Printf(TEXT("  %-20s %8.2f %4d\n"), LexToString(static_cast<EWarriorHitchScope>(ScopeIndex)), InScopeTimings[ScopeIndex].TotalMs, InScopeTimings[ScopeIndex].Count);
+	}
+
+	// Keep the disk write out of a frame that is already late.
+	UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[ReportPath = ReportDir / ReportBaseName + TEXT(".txt"), ReportText = MoveTemp(Report)]()
+		{
+			FFileHelper::SaveStringToFile(ReportText, *ReportPath);
+		}
+	);
+}
+
+void UWarriorHitchSubsystem::WritePendingTraceSnapshot()
+{
+#if UE_TRACE_ENABLED
+	if (!FTraceAuxiliary::WriteSnapshot(*PendingTraceSnapshotPath))
+	{
+		WARRIOR_LOG(Verbose, TEXT("No trace snapshot for %s, Unreal Trace is not running"), *PendingTraceSnapshotPath);
+	}
+#endif
+
+	PendingTraceSnapshotPath.Reset();
+	PendingTraceSnapshotFrame = 0;
+}
+
+int32 UWarriorHitchSubsystem::CountAliveEnemies() const
+{
+	int32 NumAliveEnemies = 0;
+
+	for (TActorIterator<AWarriorEnemyCharacter> EnemyIt(GetWorld()); EnemyIt; ++EnemyIt)
+	{
+		if (!UWarriorFunctionLibrary::NativeDoesActorHaveTag(*EnemyIt, WarriorGameplayTags::Shared_Status_Dead))
+		{
+			NumAliveEnemies++;
+		}
+	}
+
+	return NumAliveEnemies;
+}
+
+void UWarriorHitchSubsystem::OnPreGarbageCollect()
+{
+	GarbageCollectStartTime = FPlatformTime::Seconds();
+}
+
+void UWarriorHitchSubsystem::OnPostGarbageCollect()
+{
+	if (IsInGameThread())
+	{
+		WarriorStats::AddHitchScopeTiming(EWarriorHitchScope::GarbageCollection, (FPlatformTime::Seconds() - GarbageCollectStartTime) * 1000.0);
+	}
+}
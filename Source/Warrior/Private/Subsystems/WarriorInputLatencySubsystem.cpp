@@ -0,0 +1,228 @@
+// ALL FREE
+
+
+#include "Subsystems/WarriorInputLatencySubsystem.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+#include "AbilitySystem/Abilities/WarriorGameplayAbility.h"
+#include "WarriorStats.h"
+
+#include "WarriorDebugHelper.h"
+
+static TAutoConsoleVariable<bool> CVarWarriorInputLatencyEnabled(
+	TEXT("Warrior.InputLatency.Enabled"),
+	true,
+	TEXT("Measure input to activation, montage start and first hit for hero abilities. Read when a game world starts."));
+
+static TAutoConsoleVariable<float> CVarWarriorInputLatencyMaxSampleSeconds(
+	TEXT("Warrior.InputLatency.MaxSampleSeconds"),
+	1.5f,
+	TEXT("A press whose ability has not landed a hit after this long stops collecting samples."));
+
+static FAutoConsoleCommandWithWorld CmdWarriorInputLatencyDump(
+	TEXT("Warrior.InputLatency.Dump"),
+	TEXT("Logs the input latency histograms collected so far in this world."),
+	FConsoleCommandWithWorldDelegate::CreateLambda(
+		[](UWorld* InWorld)
+		{
+			if (const UWarriorInputLatencySubsystem* InputLatencySubsystem = InWorld ? InWorld->GetSubsystem<UWarriorInputLatencySubsystem>() : nullptr)
+			{
+				InputLatencySubsystem->DumpToLog();
+			}
+		}
+	)
+);
+
+UWarriorInputLatencySubsystem::FAbilityLatencyHistograms::FAbilityLatencyHistograms()
+{
+	// The hitch buckets start at 5 ms and widen from there, which suits frame bound latencies.
+	InputToActivation.InitHitchTracking();
+	InputToMontageStart.InitHitchTracking();
+	InputToFirstHit.InitHitchTracking();
+}
+
+bool UWarriorInputLatencySubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return WARRIOR_ENABLE_LOGGING && CVarWarriorInputLatencyEnabled.GetValueOnGameThread() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UWarriorInputLatencySubsystem::Deinitialize()
+{
+	DumpToLog();
+
+	Super::Deinitialize();
+}
+
+void UWarriorInputLatencySubsystem::MarkInputPressed(const UObject* WorldContextObject, const FGameplayTag& InInputTag)
+{
+	if (UWarriorInputLatencySubsystem* InputLatencySubsystem = Get(WorldContextObject))
+	{
+		InputLatencySubsystem->OnInputPressed(InInputTag);
+	}
+}
+
+void UWarriorInputLatencySubsystem::MarkAbilityActivated(const UObject* WorldContextObject, const UGameplayAbility* InAbility)
+{
+	if (UWarriorInputLatencySubsystem* InputLatencySubsystem = Get(WorldContextObject))
+	{
+		InputLatencySubsystem->OnAbilityActivated(InAbility);
+	}
+}
+
+void UWarriorInputLatencySubsystem::MarkMontageStarted(const UObject* WorldContextObject, const UGameplayAbility* InAnimatingAbility)
+{
+	if (UWarriorInputLatencySubsystem* InputLatencySubsystem = Get(WorldContextObject))
+	{
+		InputLatencySubsystem->OnMontageStarted(InAnimatingAbility);
+	}
+}
+
+void UWarriorInputLatencySubsystem::MarkHitLanded(const UObject* WorldContextObject)
+{
+	if (UWarriorInputLatencySubsystem* InputLatencySubsystem = Get(WorldContextObject))
+	{
+		InputLatencySubsystem->OnHitLanded();
+	}
+}
+
+void UWarriorInputLatencySubsystem::DumpToLog() const
+{
+	if (AbilityHistograms.IsEmpty())
+	{
+		return;
+	}
+
+	WARRIOR_LOG(Display, TEXT("Input latency for %s (ms)"), *GetWorld()->GetMapName());
+
+	for (const TPair<FGameplayTag, FAbilityLatencyHistograms>& AbilityHistogramPair : AbilityHistograms)
+	{
+		WARRIOR_LOG(Display, TEXT("%s"), *AbilityHistogramPair.Key.ToString());
+
+		DumpHistogramToLog(TEXT("Activation"), AbilityHistogramPair.Value.InputToActivation);
+		DumpHistogramToLog(TEXT("MontageStart"), AbilityHistogramPair.Value.InputToMontageStart);
+		DumpHistogramToLog(TEXT("FirstHit"), AbilityHistogramPair.Value.InputToFirstHit);
+	}
+}
+
+bool UWarriorInputLatencySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UWarriorInputLatencySubsystem::OnInputPressed(const FGameplayTag& InInputTag)
+{
+	// A newer press supersedes the previous one, whatever stages it still had left.
+	FPendingSample& NewSample = PendingSample.Emplace();
+	NewSample.InputPressedTime = FPlatformTime::Seconds();
+	NewSample.InputTag = InInputTag;
+}
+
+void UWarriorInputLatencySubsystem::OnAbilityActivated(const UGameplayAbility* InAbility)
+{
+	const TOptional<double> ElapsedMs = GetPendingSampleMs();
+
+	// Only the first ability a press activates is followed.
+	if (!ElapsedMs || !InAbility || PendingSample->AbilityClass.IsValid())
+	{
+		return;
+	}
+
+	FGameplayTag AbilityTag = PendingSample->InputTag;
+
+	if (const UWarriorGameplayAbility* WarriorAbility = Cast<UWarriorGameplayAbility>(InAbility))
+	{
+		if (!WarriorAbility->GetWarriorAbilityTags().IsEmpty())
+		{
+			AbilityTag = WarriorAbility->GetWarriorAbilityTags().First();
+		}
+	}
+
+	PendingSample->AbilityTag = AbilityTag;
+	PendingSample->AbilityClass = InAbility->GetClass();
+
+	AbilityHistograms.FindOrAdd(AbilityTag).InputToActivation.AddMeasurement(*ElapsedMs);
+	SET_FLOAT_STAT(STAT_Warrior_InputToActivationMs, *ElapsedMs);
+}
+
+void UWarriorInputLatencySubsystem::OnMontageStarted(const UGameplayAbility* InAnimatingAbility)
+{
+	const TOptional<double> ElapsedMs = GetPendingSampleMs();
+
+	if (!ElapsedMs || !InAnimatingAbility || PendingSample->bMontageStarted || PendingSample->AbilityClass.Get() != InAnimatingAbility->GetClass())
+	{
+		return;
+	}
+
+	PendingSample->bMontageStarted = true;
+
+	AbilityHistograms.FindOrAdd(PendingSample->AbilityTag).InputToMontageStart.AddMeasurement(*ElapsedMs);
+	SET_FLOAT_STAT(STAT_Warrior_InputToMontageStartMs, *ElapsedMs);
+}
+
+void UWarriorInputLatencySubsystem::OnHitLanded()
+{
+	const TOptional<double> ElapsedMs = GetPendingSampleMs();
+
+	if (!ElapsedMs || !PendingSample->AbilityClass.IsValid())
+	{
+		return;
+	}
+
+	AbilityHistograms.FindOrAdd(PendingSample->AbilityTag).InputToFirstHit.AddMeasurement(*ElapsedMs);
+	SET_FLOAT_STAT(STAT_Warrior_InputToFirstHitMs, *ElapsedMs);
+
+	// The first hit is the last stage, later hits of the same swing are not latency.
+	PendingSample.Reset();
+}
+
+TOptional<double> UWarriorInputLatencySubsystem::GetPendingSampleMs()
+{
+	if (!PendingSample)
+	{
+		return {};
+	}
+
+	const double ElapsedSeconds = FPlatformTime::Seconds() - PendingSample->InputPressedTime;
+
+	if (ElapsedSeconds > CVarWarriorInputLatencyMaxSampleSeconds.GetValueOnGameThread())
+	{
+		PendingSample.Reset();
+		return {};
+	}
+
+	return ElapsedSeconds * 1000.0;
+}
+
+UWarriorInputLatencySubsystem* UWarriorInputLatencySubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+
+	return World ? World->GetSubsystem<UWarriorInputLatencySubsystem>() : nullptr;
+}
+
+void UWarriorInputLatencySubsystem::DumpHistogramToLog(const TCHAR* InStageName, const FHistogram& InHistogram)
+{
+	if (InHistogram.GetNumMeasurements() == 0)
+	{
+		return;
+	}
+
+	FString Buckets;
+
+	for (int32 BinIndex = 0; BinIndex < InHistogram.GetNumBins(); BinIndex++)
+	{
+		if (const int32 BinCount = InHistogram.GetBinObservationsCount(BinIndex))
+		{
+			Buckets += FString::Printf(TEXT(" [%.0f-%.0f): %d"), InHistogram.GetBinLowerBound(BinIndex), InHistogram.GetBinUpperBound(BinIndex), BinCount);
+		}
+	}
+
+	WARRIOR_LOG(Display, TEXT("  %-12s n=%lld avg=%.1f min=%.1f max=%.1f%s"),
+		InStageName,
+		static_cast<int64>(InHistogram.GetNumMeasurements()),
+		InHistogram.GetAverageOfAllMeasures(),
+		InHistogram.GetMinOfAllMeasures(),
+		InHistogram.GetMaxOfAllMeasures(),
+		*Buckets
+	);
+}
@@ -0,0 +1,202 @@
+// ALL FREE
+
+
+#include "Subsystems/WarriorOrientationSubsystem.h"
+#include "HAL/IConsoleManager.h"
+#include "GameFramework/Pawn.h"
+#include "WarriorStats.h"
+
+static TAutoConsoleVariable<float> CVarWarriorOrientationFarDistance(
+	TEXT("Warrior.Orientation.FarDistance"),
+	3000.f,
+	TEXT("Pawns further than this from their target turn at Warrior.Orientation.FarInterval instead of every frame."));
+
+static TAutoConsoleVariable<float> CVarWarriorOrientationFarInterval(
+	TEXT("Warrior.Orientation.FarInterval"),
+	0.1f,
+	TEXT("Seconds between orientation updates for far pawns. 0 updates them every frame."));
+
+void UWarriorOrientationSubsystem::Deinitialize()
+{
+	Pawns.Empty();
+	RequestStacks.Empty();
+	TargetActors.Empty();
+	RotationInterpSpeeds.Empty();
+	AccumulatedDeltaTimes.Empty();
+
+	SET_DWORD_STAT(STAT_Warrior_OrientedPawns, 0);
+
+	Super::Deinitialize();
+}
+
+void UWarriorOrientationSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_Warrior_OrientationBatch);
+
+	for (int32 Index = Pawns.Num() - 1; Index >= 0; Index--)
+	{
+		if (TargetActors[Index].IsValid())
+		{
+			continue;
+		}
+
+		// The active target is gone, fall back to whichever request is still alive.
+		RequestStacks[Index].RemoveAll([](const FOrientationRequest& InRequest) { return !InRequest.TargetActor.IsValid(); });
+
+		if (RequestStacks[Index].IsEmpty())
+		{
+			RemoveAtSwap(Index);
+		}
+		else
+		{
+			ApplyTopRequest(Index);
+		}
+	}
+
+	for (int32 Index = Pawns.Num() - 1; Index >= 0; Index--)
+	{
+		if (!Pawns[Index].IsValid())
+		{
+			RemoveAtSwap(Index);
+		}
+	}
+
+	SET_DWORD_STAT(STAT_Warrior_OrientedPawns, Pawns.Num());
+
+	const float FarDistanceSquared = FMath::Square(CVarWarriorOrientationFarDistance.GetValueOnGameThread());
+	const float FarInterval = CVarWarriorOrientationFarInterval.GetValueOnGameThread();
+
+	DueIndices.Reset();
+	CurrentYaws.Reset();
+	DeltaXs.Reset();
+	DeltaYs.Reset();
+	InterpAlphas.Reset();
+
+	// Gather everything the math needs, so the pass below never touches an actor.
+	for (int32 Index = 0; Index < Pawns.Num(); Index++)
+	{
+		const APawn* Pawn = Pawns[Index].Get();
+		const FVector ToTarget = TargetActors[Index]->GetActorLocation() - Pawn->GetActorLocation();
+
+		AccumulatedDeltaTimes[Index] += DeltaTime;
+
+		if (ToTarget.SizeSquared2D() > FarDistanceSquared && AccumulatedDeltaTimes[Index] < FarInterval)
+		{
+			continue;
+		}
+
+		DueIndices.Add(Index);
+		CurrentYaws.Add(Pawn->GetActorRotation().Yaw);
+		DeltaXs.Add(ToTarget.X);
+		DeltaYs.Add(ToTarget.Y);
+
+		// Same clamp as FMath::RInterpTo, a speed of 0 or less snaps straight to the target.
+		const float InterpSpeed = RotationInterpSpeeds[Index];
+		InterpAlphas.Add(InterpSpeed > 0.f ? FMath::Clamp(AccumulatedDeltaTimes[Index] * InterpSpeed, 0.f, 1.f) : 1.f);
+
+		AccumulatedDeltaTimes[Index] = 0.f;
+	}
+
+	const int32 NumDue = DueIndices.Num();
+	NewYaws.SetNumUninitialized(NumDue, EAllowShrinking::No);
+
+	for (int32 DueIndex = 0; DueIndex < NumDue; DueIndex++)
+	{
+		const float LookAtYaw = FMath::RadiansToDegrees(FMath::Atan2(DeltaYs[DueIndex], DeltaXs[DueIndex]));
+		const float DeltaYaw = FRotator::NormalizeAxis(LookAtYaw - CurrentYaws[DueIndex]);
+
+		NewYaws[DueIndex] = FRotator::NormalizeAxis(CurrentYaws[DueIndex] + DeltaYaw * InterpAlphas[DueIndex]);
+	}
+
+	for (int32 DueIndex = 0; DueIndex < NumDue; DueIndex++)
+	{
+		// Pawns already facing their target skip the transform update entirely.
+		if (FMath::IsNearlyEqual(NewYaws[DueIndex], CurrentYaws[DueIndex], UE_KINDA_SMALL_NUMBER))
+		{
+			continue;
+		}
+
+		APawn* Pawn = Pawns[DueIndices[DueIndex]].Get();
+
+		FRotator NewRotation = Pawn->GetActorRotation();
+		NewRotation.Yaw = NewYaws[DueIndex];
+
+		Pawn->SetActorRotation(NewRotation);
+	}
+}
+
+bool UWarriorOrientationSubsystem::IsTickable() const
+{
+	return !Pawns.IsEmpty();
+}
+
+TStatId UWarriorOrientationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorOrientationSubsystem, STATGROUP_Tickables);
+}
+
+void UWarriorOrientationSubsystem::RegisterPawn(APawn* InPawn, AActor* InTargetActor, float InRotationInterpSpeed, const UObject* InRequester)
+{
+	check(InPawn && InTargetActor);
+
+	int32 Index = Pawns.IndexOfByKey(InPawn);
+
+	if (Index == INDEX_NONE)
+	{
+		Index = Pawns.Add(InPawn);
+		RequestStacks.AddDefaulted();
+		TargetActors.AddDefaulted();
+		RotationInterpSpeeds.Add(0.f);
+		AccumulatedDeltaTimes.Add(0.f);
+	}
+
+	FOrientationRequestStack& RequestStack = RequestStacks[Index];
+	RequestStack.RemoveAll([InRequester](const FOrientationRequest& InRequest) { return InRequest.Requester == FObjectKey(InRequester); });
+
+	FOrientationRequest& NewRequest = RequestStack.AddDefaulted_GetRef();
+	NewRequest.Requester = InRequester;
+	NewRequest.TargetActor = InTargetActor;
+	NewRequest.RotationInterpSpeed = InRotationInterpSpeed;
+
+	ApplyTopRequest(Index);
+}
+
+void UWarriorOrientationSubsystem::UnregisterPawn(const APawn* InPawn, const UObject* InRequester)
+{
+	const int32 Index = Pawns.IndexOfByKey(InPawn);
+
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	RequestStacks[Index].RemoveAll([InRequester](const FOrientationRequest& InRequest) { return InRequest.Requester == FObjectKey(InRequester); });
+
+	if (RequestStacks[Index].IsEmpty())
+	{
+		RemoveAtSwap(Index);
+	}
+	else
+	{
+		ApplyTopRequest(Index);
+	}
+}
+
+void UWarriorOrientationSubsystem::ApplyTopRequest(int32 InIndex)
+{
+	const FOrientationRequest& TopRequest = RequestStacks[InIndex].Last();
+
+	TargetActors[InIndex] = TopRequest.TargetActor;
+	RotationInterpSpeeds[InIndex] = TopRequest.RotationInterpSpeed;
+}
+
+void UWarriorOrientationSubsystem::RemoveAtSwap(int32 InIndex)
+{
+	Pawns.RemoveAtSwap(InIndex, 1, EAllowShrinking::No);
+	RequestStacks.RemoveAtSwap(InIndex, 1, EAllowShrinking::No);
+	TargetActors.RemoveAtSwap(InIndex, 1, EAllowShrinking::No);
+	RotationInterpSpeeds.RemoveAtSwap(InIndex, 1, EAllowShrinking::No);
+	AccumulatedDeltaTimes.RemoveAtSwap(InIndex, 1, EAllowShrinking::No);
+}
@@ -0,0 +1,137 @@
+// ALL FREE
+
+
+#include "Subsystems/WarriorTaskTickSubsystem.h"
+#include "AbilitySystem/AbilityTasks/AbilityTask_ExecuteTaskOnTick.h"
+
+void UWarriorTaskTickSubsystem::Deinitialize()
+{
+	TickTaskBuckets.Empty();
+	NumRegisteredTasks = 0;
+
+	Super::Deinitialize();
+}
+
+void UWarriorTaskTickSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	TGuardValue<bool> TickingGuard(bIsTickingTasks, true);
+
+	// Callbacks may register new tasks and grow these arrays, so everything below goes through indices.
+	const int32 NumBucketsToTick = TickTaskBuckets.Num();
+
+	for (int32 BucketIndex = 0; BucketIndex < NumBucketsToTick; BucketIndex++)
+	{
+		FTickTaskBucket& Bucket = TickTaskBuckets[BucketIndex];
+		Bucket.AccumulatedDeltaTime += DeltaTime;
+
+		if (Bucket.AccumulatedDeltaTime < Bucket.TickInterval)
+		{
+			continue;
+		}
+
+		const float BucketDeltaTime = Bucket.AccumulatedDeltaTime;
+		const int32 NumEntriesToTick = Bucket.Entries.Num();
+		Bucket.AccumulatedDeltaTime = 0.f;
+
+		for (int32 EntryIndex = 0; EntryIndex < NumEntriesToTick; EntryIndex++)
+		{
+			FTickTaskEntry& Entry = TickTaskBuckets[BucketIndex].Entries[EntryIndex];
+
+			// Tasks that joined part way through the interval only get the time they were actually around for.
+			const float TaskDeltaTime = BucketDeltaTime - Entry.JoinedAtDeltaTime;
+			Entry.JoinedAtDeltaTime = 0.f;
+
+			if (UAbilityTask_ExecuteTaskOnTick* Task = Entry.Task.Get())
+			{
+				Task->ExecuteTick(TaskDeltaTime);
+			}
+		}
+	}
+
+	if (bHasPendingRemovals)
+	{
+		RemoveEndedTasks();
+	}
+}
+
+bool UWarriorTaskTickSubsystem::IsTickable() const
+{
+	return NumRegisteredTasks > 0;
+}
+
+TStatId UWarriorTaskTickSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorTaskTickSubsystem, STATGROUP_Tickables);
+}
+
+void UWarriorTaskTickSubsystem::RegisterTickTask(UAbilityTask_ExecuteTaskOnTick* InTask)
+{
+	check(InTask);
+
+	FTickTaskBucket& Bucket = FindOrAddBucket(InTask->GetTickInterval());
+
+	FTickTaskEntry NewEntry;
+	NewEntry.Task = InTask;
+	NewEntry.JoinedAtDeltaTime = Bucket.AccumulatedDeltaTime;
+
+	Bucket.Entries.Add(NewEntry);
+
+	NumRegisteredTasks++;
+}
+
+void UWarriorTaskTickSubsystem::UnregisterTickTask(UAbilityTask_ExecuteTaskOnTick* InTask)
+{
+	for (FTickTaskBucket& Bucket : TickTaskBuckets)
+	{
+		for (FTickTaskEntry& Entry : Bucket.Entries)
+		{
+			if (Entry.Task != InTask) continue;
+
+			// Entries can't move while the buckets are being walked, so just drop the reference and compact after.
+			Entry.Task.Reset();
+			bHasPendingRemovals = true;
+
+			if (!bIsTickingTasks)
+			{
+				RemoveEndedTasks();
+			}
+
+			return;
+		}
+	}
+}
+
+void UWarriorTaskTickSubsystem::RemoveEndedTasks()
+{
+	for (int32 BucketIndex = TickTaskBuckets.Num() - 1; BucketIndex >= 0; BucketIndex--)
+	{
+		FTickTaskBucket& Bucket = TickTaskBuckets[BucketIndex];
+
+		NumRegisteredTasks -= Bucket.Entries.RemoveAllSwap([](const FTickTaskEntry& InEntry) { return !InEntry.Task.IsValid(); });
+
+		if (Bucket.Entries.IsEmpty())
+		{
+			TickTaskBuckets.RemoveAtSwap(BucketIndex);
+		}
+	}
+
+	bHasPendingRemovals = false;
+}
+
+UWarriorTaskTickSubsystem::FTickTaskBucket& UWarriorTaskTickSubsystem::FindOrAddBucket(float InTickInterval)
+{
+	for (FTickTaskBucket& Bucket : TickTaskBuckets)
+	{
+		if (FMath::IsNearlyEqual(Bucket.TickInterval, InTickInterval))
+		{
+			return Bucket;
+		}
+	}
+
+	FTickTaskBucket& NewBucket = TickTaskBuckets.AddDefaulted_GetRef();
+	NewBucket.TickInterval = InTickInterval;
+
+	return NewBucket;
+}
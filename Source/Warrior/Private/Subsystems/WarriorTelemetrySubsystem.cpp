@@ -0,0 +1,130 @@
+// ALL FREE
+
+
+#include "Subsystems/WarriorTelemetrySubsystem.h"
+#include "HAL/IConsoleManager.h"
+#include "RenderCore.h"
+#include "RHI.h"
+#include "UObject/UObjectGlobals.h"
+#include "Engine/World.h"
+
+#include "WarriorDebugHelper.h"
+
+static TAutoConsoleVariable<bool> CVarWarriorTelemetryEnabled(
+	TEXT("Warrior.Telemetry.Enabled"),
+	false,
+	TEXT("Record frame timings and gameplay markers to Saved/Profiling/Telemetry. Read when a game world starts."));
+
+static TAutoConsoleVariable<int32> CVarWarriorTelemetryRingRecords(
+	TEXT("Warrior.Telemetry.RingRecords"),
+	1 << 18,
+	TEXT("How many 16 byte records the telemetry ring file holds before it wraps."));
+
+namespace WarriorTelemetry
+{
+	/** Frames between hand offs to the writer, roughly a second at 60 fps */
+	constexpr int32 FramesPerSubmit = 60;
+}
+
+bool UWarriorTelemetrySubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return CVarWarriorTelemetryEnabled.GetValueOnGameThread() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UWarriorTelemetrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const FString FileName = FString::Printf(TEXT("%s_%s.wtlm"), *GetWorld()->GetMapName(), *FDateTime::Now().ToString());
+	const FString FilePath = FPaths::ProjectSavedDir() / TEXT("Profiling") / TEXT("Telemetry") / FileName;
+
+	RingWriter = MakeUnique<FWarriorTelemetryRingWriter>(FilePath, static_cast<uint32>(FMath::Max(CVarWarriorTelemetryRingRecords.GetValueOnGameThread(), 1)));
+
+	PreGarbageCollectDelegateHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddUObject(this, &ThisClass::OnPreGarbageCollect);
+	PostGarbageCollectDelegateHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(this, &ThisClass::OnPostGarbageCollect);
+
+	WARRIOR_LOG(Log, TEXT("Recording telemetry to %s"), *FilePath);
+}
+
+void UWarriorTelemetrySubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGarbageCollectDelegateHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectDelegateHandle);
+
+	// Waits for the writer, so the file is complete once the world is gone.
+	RingWriter.Reset();
+
+	Super::Deinitialize();
+}
+
+void UWarriorTelemetrySubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	FWarriorTelemetryFrame Frame;
+	Frame.FrameNumber = static_cast<uint32>(GFrameCounter);
+	Frame.FrameMs = static_cast<float>(FApp::GetDeltaTime() * 1000.0);
+	Frame.GameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+	Frame.RenderThreadMs = FPlatformTime::ToMilliseconds(GRenderThreadTime);
+	Frame.GPUMs = FPlatformTime::ToMilliseconds(RHIGetGPUFrameCycles());
+	Frame.GCMs = static_cast<float>(PendingGarbageCollectMs);
+
+	PendingGarbageCollectMs = 0.0;
+
+	RingWriter->AppendFrame(Frame);
+
+	if (RingWriter->GetNumPendingRecords() >= WarriorTelemetry::FramesPerSubmit)
+	{
+		RingWriter->Submit();
+	}
+}
+
+bool UWarriorTelemetrySubsystem::IsTickable() const
+{
+	return RingWriter.IsValid();
+}
+
+TStatId UWarriorTelemetrySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorTelemetrySubsystem, STATGROUP_Tickables);
+}
+
+void UWarriorTelemetrySubsystem::RecordMarker(EWarriorTelemetryMarker InMarker, int32 InValue)
+{
+	if (!RingWriter)
+	{
+		return;
+	}
+
+	FWarriorTelemetryMarker Marker;
+	Marker.FrameNumber = static_cast<uint32>(GFrameCounter);
+	Marker.Marker = InMarker;
+	Marker.Value = InValue;
+
+	RingWriter->AppendMarker(Marker);
+}
+
+void UWarriorTelemetrySubsystem::RecordMarker(const UObject* WorldContextObject, EWarriorTelemetryMarker InMarker, int32 InValue)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+
+	if (UWarriorTelemetrySubsystem* TelemetrySubsystem = World ? World->GetSubsystem<UWarriorTelemetrySubsystem>() : nullptr)
+	{
+		TelemetrySubsystem->RecordMarker(InMarker, InValue);
+	}
+}
+
+bool UWarriorTelemetrySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UWarriorTelemetrySubsystem::OnPreGarbageCollect()
+{
+	GarbageCollectStartTime = FPlatformTime::Seconds();
+}
+
+void UWarriorTelemetrySubsystem::OnPostGarbageCollect()
+{
+	PendingGarbageCollectMs += (FPlatformTime::Seconds() - GarbageCollectStartTime) * 1000.0;
+}
@@ -0,0 +1,254 @@
+// ALL FREE
+
+
+#include "Subsystems/WarriorUtilityBrainSubsystem.h"
+#include "HAL/IConsoleManager.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+#include "AbilitySystemBlueprintLibrary.h"
+#include "AbilitySystemComponent.h"
+#include "AbilitySystem/WarriorAttributeSet.h"
+#include "AbilitySystem/Abilities/WarriorGameplayAbility.h"
+#include "GameControllers/WarriorAIController.h"
+#include "Subsystems/WarriorAttackTokenSubsystem.h"
+#include "WarriorGameplayTags.h"
+#include "WarriorStats.h"
+
+static TAutoConsoleVariable<float> CVarWarriorUtilityBrainInterval(
+	TEXT("Warrior.UtilityBrain.Interval"),
+	0.2f,
+	TEXT("Seconds between utility brain passes."));
+
+static TAutoConsoleVariable<int32> CVarWarriorUtilityBrainMinBatchSize(
+	TEXT("Warrior.UtilityBrain.MinBatchSize"),
+	4,
+	TEXT("Fewest enemies a worker scores at once. Each one is weighed against the whole crowd, so a handful already outweighs the dispatch."));
+
+static TAutoConsoleVariable<int32> CVarWarriorUtilityBrainMaxEngagedPerTarget(
+	TEXT("Warrior.UtilityBrain.MaxEngagedPerTarget"),
+	4,
+	TEXT("How many of the enemies closest to a target score attacking normally. The rest prefer circling outside until one of them drops back."));
+
+void UWarriorUtilityBrainSubsystem::Deinitialize()
+{
+	Entries.Empty();
+	DecisionInputs.Empty();
+	Decisions.Empty();
+	PassTargets.Empty();
+
+	SET_DWORD_STAT(STAT_Warrior_UtilityBrainEnemies, 0);
+
+	Super::Deinitialize();
+}
+
+void UWarriorUtilityBrainSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	AccumulatedDeltaTime += DeltaTime;
+
+	if (AccumulatedDeltaTime < CVarWarriorUtilityBrainInterval.GetValueOnGameThread())
+	{
+		return;
+	}
+
+	AccumulatedDeltaTime = 0.f;
+
+	SCOPE_CYCLE_COUNTER(STAT_Warrior_UtilityBrainPass);
+
+	Entries.RemoveAllSwap([](const FBrainEntry& InEntry) { return !InEntry.Controller.IsValid(); }, EAllowShrinking::No);
+
+	SET_DWORD_STAT(STAT_Warrior_UtilityBrainEnemies, Entries.Num());
+
+	GatherDecisionInputs();
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_Warrior_UtilityBrainScoring);
+
+		Decisions.SetNumUninitialized(DecisionInputs.Num(), EAllowShrinking::No);
+
+		const TConstArrayView<FDecisionInput> Crowd = DecisionInputs;
+		const int32 MaxEngagedPerTarget = CVarWarriorUtilityBrainMaxEngagedPerTarget.GetValueOnGameThread();
+
+		ParallelFor(TEXT("WarriorUtilityBrain"), DecisionInputs.Num(), FMath::Max(CVarWarriorUtilityBrainMinBatchSize.GetValueOnGameThread(), 1),
+			[this, Crowd, MaxEngagedPerTarget](int32 Index)
+			{
+				Decisions[Index] = ChooseAction(Crowd[Index], Crowd, MaxEngagedPerTarget);
+			}
+		);
+	}
+
+	ApplyDecisions();
+}
+
+bool UWarriorUtilityBrainSubsystem::IsTickable() const
+{
+	return !Entries.IsEmpty();
+}
+
+TStatId UWarriorUtilityBrainSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorUtilityBrainSubsystem, STATGROUP_Tickables);
+}
+
+void UWarriorUtilityBrainSubsystem::RegisterController(AWarriorAIController* InController)
+{
+	check(InController);
+
+	if (!Entries.ContainsByPredicate([InController](const FBrainEntry& InEntry) { return InEntry.Controller == InController; }))
+	{
+		Entries.AddDefaulted_GetRef().Controller = InController;
+	}
+}
+
+void UWarriorUtilityBrainSubsystem::UnregisterController(const AWarriorAIController* InController)
+{
+	Entries.RemoveAllSwap([InController](const FBrainEntry& InEntry) { return InEntry.Controller == InController; }, EAllowShrinking::No);
+}
+
+bool UWarriorUtilityBrainSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UWarriorUtilityBrainSubsystem::GatherDecisionInputs()
+{
+	const UWarriorAttackTokenSubsystem* AttackTokenSubsystem = GetWorld()->GetSubsystem<UWarriorAttackTokenSubsystem>();
+
+	DecisionInputs.Reset();
+	PassTargets.Reset();
+
+	for (FBrainEntry& Entry : Entries)
+	{
+		const AWarriorAIController* Controller = Entry.Controller.Get();
+
+		FDecisionInput& Input = DecisionInputs.AddDefaulted_GetRef();
+		Input.AttackRange = Controller->GetUtilityAttackRange();
+		Input.RetreatHealthRatio = Controller->GetUtilityRetreatHealthRatio();
+
+		APawn* EnemyPawn = Controller->GetPawn();
+		const UAbilitySystemComponent* ASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(EnemyPawn);
+
+		if (!EnemyPawn || !ASC)
+		{
+			continue;
+		}
+
+		Input.Location = EnemyPawn->GetActorLocation();
+
+		if (const AActor* TargetActor = Controller->GetTargetActor())
+		{
+			Input.TargetIndex = PassTargets.AddUnique(TargetActor);
+			Input.DistanceToTarget = FVector::Dist(Input.Location, TargetActor->GetActorLocation());
+		}
+
+		const float MaxHealth = ASC->GetNumericAttribute(UWarriorAttributeSet::GetMaxHealthAttribute());
+		Input.HealthRatio = MaxHealth > 0.f ? ASC->GetNumericAttribute(UWarriorAttributeSet::GetCurrentHealthAttribute()) / MaxHealth : 1.f;
+
+		if (ASC->GetActivatableAbilities().Num() != Entry.NumAbilitySpecs)
+		{
+			CacheMeleeCooldownTags(Entry, *ASC);
+		}
+
+		Input.bAttackOnCooldown = ASC->HasAnyMatchingGameplayTags(Entry.MeleeCooldownTags);
+		Input.bHoldsAttackToken = AttackTokenSubsystem && AttackTokenSubsystem->HasToken(EnemyPawn);
+		Input.bUnderAttack = ASC->HasMatchingGameplayTag(WarriorGameplayTags::Enemy_Status_UnderAttack);
+		Input.bStrafing = ASC->HasMatchingGameplayTag(WarriorGameplayTags::Enemy_Status_Strafing);
+		Input.bDead = ASC->HasMatchingGameplayTag(WarriorGameplayTags::Shared_Status_Dead);
+	}
+}
+
+void UWarriorUtilityBrainSubsystem::ApplyDecisions()
+{
+	for (int32 Index = 0; Index < Entries.Num(); Index++)
+	{
+		Entries[Index].Controller->SetChosenAction(Decisions[Index]);
+	}
+}
+
+void UWarriorUtilityBrainSubsystem::CacheMeleeCooldownTags(FBrainEntry& InEntry, const UAbilitySystemComponent& InASC)
+{
+	InEntry.MeleeCooldownTags.Reset();
+	InEntry.NumAbilitySpecs = InASC.GetActivatableAbilities().Num();
+
+	for (const FGameplayAbilitySpec& AbilitySpec : InASC.GetActivatableAbilities())
+	{
+		const UWarriorGameplayAbility* WarriorAbility = Cast<UWarriorGameplayAbility>(AbilitySpec.Ability);
+
+		if (!WarriorAbility || !WarriorAbility->GetWarriorAbilityTags().HasTag(WarriorGameplayTags::Enemy_Ability_Melee))
+		{
+			continue;
+		}
+
+		if (const FGameplayTagContainer* CooldownTags = WarriorAbility->GetCooldownTags())
+		{
+			InEntry.MeleeCooldownTags.AppendTags(*CooldownTags);
+		}
+	}
+}
+
+EWarriorEnemyAction UWarriorUtilityBrainSubsystem::ChooseAction(const FDecisionInput& InInput, TConstArrayView<FDecisionInput> InCrowd, int32 InMaxEngagedPerTarget)
+{
+	if (InInput.TargetIndex == INDEX_NONE || InInput.bDead)
+	{
+		return EWarriorEnemyAction::None;
+	}
+
+	const float RangeRatio = InInput.DistanceToTarget / FMath::Max(InInput.AttackRange, 1.f);
+	const bool bAttackReady = !InInput.bAttackOnCooldown;
+
+	// How many living allies on the same target are closer to it, i.e. already stand in the ring this enemy would have to push into.
+	int32 NumAlliesCloser = 0;
+	float NearestAllyDistSquared = TNumericLimits<float>::Max();
+
+	for (const FDecisionInput& Ally : InCrowd)
+	{
+		if (&Ally == &InInput || Ally.TargetIndex != InInput.TargetIndex || Ally.bDead)
+		{
+			continue;
+		}
+
+		NumAlliesCloser += Ally.DistanceToTarget < InInput.DistanceToTarget;
+		NearestAllyDistSquared = FMath::Min(NearestAllyDistSquared, FVector::DistSquared(Ally.Location, InInput.Location));
+	}
+
+	const bool bRingIsFull = NumAlliesCloser >= InMaxEngagedPerTarget;
+
+	// Two enemies on top of each other make a poor silhouette and block each other's swings, the one further out backs off into a circle.
+	const bool bIsCrowded = NearestAllyDistSquared < FMath::Square(InInput.AttackRange * 0.5f) && NumAlliesCloser > 0;
+
+	// Full score inside attack range, fading out by twice the range. Enemies already turned away by the token scheduler rarely win it.
+	const float TokenFactor = InInput.bHoldsAttackToken ? 1.f : InInput.bStrafing ? 0.3f : 0.8f;
+	const float CrowdFactor = InInput.bHoldsAttackToken ? 1.f : bRingIsFull ? 0.2f : bIsCrowded ? 0.6f : 1.f;
+	const float AttackScore = bAttackReady ? FMath::Clamp(2.f - RangeRatio, 0.f, 1.f) * TokenFactor * CrowdFactor : 0.f;
+
+	// Nothing at attack range, everything at four times the range. No point running in to wait outside a full ring.
+	const float ChaseScore = FMath::Max(FMath::Clamp((RangeRatio - 1.f) / 3.f, 0.f, 1.f) * (bRingIsFull ? 0.5f : 1.f), 0.05f);
+
+	// Circling only makes sense close by, mostly while waiting on a slot, a cooldown or room in the ring.
+	const float StrafeScore = RangeRatio < 3.f ? (InInput.bStrafing || bRingIsFull ? 0.7f : !bAttackReady ? 0.5f : bIsCrowded ? 0.4f : 0.1f) : 0.f;
+
+	const bool bShouldRetreat = InInput.bUnderAttack && InInput.HealthRatio < InInput.RetreatHealthRatio;
+	const float RetreatScore = bShouldRetreat ? 0.95f : 0.f;
+
+	EWarriorEnemyAction BestAction = EWarriorEnemyAction::Chase;
+	float BestScore = ChaseScore;
+
+	const TPair<EWarriorEnemyAction, float> Candidates[] =
+	{
+		{ EWarriorEnemyAction::Attack, AttackScore },
+		{ EWarriorEnemyAction::Strafe, StrafeScore },
+		{ EWarriorEnemyAction::Retreat, RetreatScore }
+	};
+
+	for (const TPair<EWarriorEnemyAction, float>& Candidate : Candidates)
+	{
+		if (Candidate.Value > BestScore)
+		{
+			BestAction = Candidate.Key;
+			BestScore = Candidate.Value;
+		}
+	}
+
+	return BestAction;
+}
@@ -0,0 +1,78 @@
+// ALL FREE
+
+
+#include "Misc/AutomationTest.h"
+#include "AI/BTTask_RotateToFaceTarget.h"
+#include "BehaviorTree/BehaviorTree.h"
+#include "Kismet/KismetMathLibrary.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWarriorRotateToFaceTargetPrecisionTest, "Warrior.AI.RotateToFaceTarget.Precision", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FWarriorRotateToFaceTargetPrecisionTest::RunTest(const FString& Parameters)
+{
+	const float AnglePrecisions[] = { 0.f, 1.f, 10.f, 45.f, 90.f, 135.f, 180.f };
+
+	FFloatProperty* AnglePrecisionProperty = FindFProperty<FFloatProperty>(UBTTask_RotateToFaceTarget::StaticClass(), TEXT("AnglePrecision"));
+
+	if (!TestNotNull(TEXT("AnglePrecision property"), AnglePrecisionProperty))
+	{
+		return false;
+	}
+
+	UBehaviorTree* BehaviorTree = NewObject<UBehaviorTree>();
+
+	int32 MismatchCount = 0;
+
+	for (const float AnglePrecision : AnglePrecisions)
+	{
+		// Set up the way a behavior tree asset sets it up, so the threshold under test is the one the task computes.
+		UBTTask_RotateToFaceTarget* Task = NewObject<UBTTask_RotateToFaceTarget>(BehaviorTree);
+		AnglePrecisionProperty->SetPropertyValue_InContainer(Task, AnglePrecision);
+		static_cast<UBTNode*>(Task)->InitializeFromAsset(*BehaviorTree);
+
+		// Targets all around the pawn, including above and below it.
+		for (int32 Pitch = -80; Pitch <= 80; Pitch += 20)
+		{
+			for (int32 Yaw = -180; Yaw < 180; Yaw += 3)
+			{
+				const FVector OwnerForward = FRotator(0.f, 0.f, 0.f).Vector();
+				const FVector OwnerToTarget = FRotator(Pitch, Yaw, 0.f).Vector() * 750.f;
+
+				// The check the task used before the cosine threshold, in the ground plane the orientation subsystem turns in.
+				const float OldAngle = UKismetMathLibrary::DegAcos(FVector::DotProduct(OwnerForward, OwnerToTarget.GetSafeNormal2D()));
+
+				// Float rounding can only flip the answer right on the threshold.
+				if (FMath::IsNearlyEqual(OldAngle, AnglePrecision, 0.01f))
+				{
+					continue;
+				}
+
+				const bool bOldReached = OldAngle <= AnglePrecision;
+				const bool bNewReached = Task->IsFacingWithinPrecision(OwnerForward, OwnerToTarget);
+
+				if (bOldReached != bNewReached)
+				{
+					AddError(FString::Printf(TEXT("Precision %.0f, pitch %d, yaw %d: was %d, now %d"), AnglePrecision, Pitch, Yaw, bOldReached, bNewReached));
+					++MismatchCount;
+				}
+			}
+		}
+	}
+
+	TestEqual(TEXT("Finishes at the same angles as the acos check"), MismatchCount, 0);
+
+	UBTTask_RotateToFaceTarget* Task = NewObject<UBTTask_RotateToFaceTarget>(BehaviorTree);
+	static_cast<UBTNode*>(Task)->InitializeFromAsset(*BehaviorTree);
+
+	// Turning only the yaw has to be able to finish, whatever the height difference.
+	TestTrue(TEXT("Target 17 degrees below is faced"), Task->IsFacingWithinPrecision(FVector::ForwardVector, FVector(200.f, 0.f, -60.f)));
+	TestTrue(TEXT("Target 60 degrees above is faced"), Task->IsFacingWithinPrecision(FVector::ForwardVector, FRotator(60.f, 5.f, 0.f).Vector() * 500.f));
+	TestTrue(TEXT("Target straight overhead is faced"), Task->IsFacingWithinPrecision(FVector::ForwardVector, FVector::UpVector * 500.f));
+	TestFalse(TEXT("Target behind and above is not faced"), Task->IsFacingWithinPrecision(FVector::ForwardVector, FVector(-200.f, 0.f, 300.f)));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
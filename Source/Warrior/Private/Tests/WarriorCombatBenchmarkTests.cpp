@@ -0,0 +1,72 @@
+// ALL FREE
+
+
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "Commandlets/WarriorCombatBenchmarkCommandlet.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWarriorCombatBenchmarkGateTest, "Warrior.Combat.Benchmark.Gate", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FWarriorCombatBenchmarkGateTest::RunTest(const FString& Parameters)
+{
+	using FBenchmarkResult = UWarriorCombatBenchmarkCommandlet::FBenchmarkResult;
+
+	FBenchmarkResult BaselineResult;
+	BaselineResult.Name = TEXT("IsValidBlock");
+	BaselineResult.NumActors = 16;
+	BaselineResult.NsPerOp = 100.0;
+	BaselineResult.AllocsPerOp = 1.0;
+
+	// What -UpdateBaseline writes is what the gate reads back.
+	const FString BaselineFilePath = FPaths::AutomationTransientDir() / TEXT("WarriorCombatBenchmarkGateTest.csv");
+	TestTrue(TEXT("Baseline written"), UWarriorCombatBenchmarkCommandlet::WriteCsv(BaselineFilePath, { BaselineResult }));
+
+	TMap<FString, FBenchmarkResult> Baseline;
+	TestTrue(TEXT("Baseline loaded"), UWarriorCombatBenchmarkCommandlet::LoadBaseline(BaselineFilePath, Baseline));
+
+	IFileManager::Get().Delete(*BaselineFilePath);
+
+	const FBenchmarkResult* LoadedResult = Baseline.Find(UWarriorCombatBenchmarkCommandlet::GetBaselineKey(BaselineResult));
+
+	if (!TestNotNull(TEXT("Baseline keyed by name and actor count"), LoadedResult))
+	{
+		return false;
+	}
+
+	TestEqual(TEXT("ns/op round trips"), LoadedResult->NsPerOp, 100.0, 0.01);
+	TestEqual(TEXT("allocs/op round trips"), LoadedResult->AllocsPerOp, 1.0, 0.001);
+
+	FBenchmarkResult Result = BaselineResult;
+
+	Result.NsPerOp = 120.0;
+	TestFalse(TEXT("Within the tolerance"), UWarriorCombatBenchmarkCommandlet::IsRegression(Result, *LoadedResult, 0.25f));
+
+	Result.NsPerOp = 130.0;
+	TestTrue(TEXT("Slower than the tolerance"), UWarriorCombatBenchmarkCommandlet::IsRegression(Result, *LoadedResult, 0.25f));
+
+	Result.NsPerOp = 100.0;
+	Result.AllocsPerOp = 2.0;
+	TestTrue(TEXT("One more allocation per op"), UWarriorCombatBenchmarkCommandlet::IsRegression(Result, *LoadedResult, 0.25f));
+
+	Result.AllocsPerOp = -1.0;
+	TestFalse(TEXT("Allocations not counted in this build"), UWarriorCombatBenchmarkCommandlet::IsRegression(Result, *LoadedResult, 0.25f));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWarriorCombatBenchmarkTest, "Warrior.Combat.Benchmark.Baseline", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FWarriorCombatBenchmarkTest::RunTest(const FString& Parameters)
+{
+	// Same run the build machine does, fails on any regression past Build/Benchmarks/WarriorCombatBaseline.csv. Entries it doesn't have yet only warn.
+	UWarriorCombatBenchmarkCommandlet* BenchmarkCommandlet = NewObject<UWarriorCombatBenchmarkCommandlet>();
+
+	TestEqual(TEXT("No combat benchmark regressed"), BenchmarkCommandlet->Main(TEXT("-Actors=1,16,128")), 0);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,81 @@
+// ALL FREE
+
+
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+#include "WarriorTypes/WarriorTimerWheel.h"
+#include "WarriorTypes/WarriorCountDownAction.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWarriorTimerWheelExpiryTest, "Warrior.TimerWheel.Expiry", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FWarriorTimerWheelExpiryTest::RunTest(const FString& Parameters)
+{
+	FWarriorTimerWheel TimerWheel;
+	TArray<int32> ExpiredPayloads;
+
+	// One delay per level of the wheel plus one in the overflow list.
+	TimerWheel.AddTimer(300, 1);
+	TimerWheel.AddTimer(5, 0);
+	TimerWheel.AddTimer(70000, 2);
+	TimerWheel.AddTimer((1ull << 24) + 10, 3);
+	const int32 RemovedTimerId = TimerWheel.AddTimer(10, 4);
+	TimerWheel.AddTimer(0, 5);
+
+	TimerWheel.RemoveTimer(RemovedTimerId);
+	TestEqual(TEXT("Timers after removal"), TimerWheel.Num(), 5);
+
+	TimerWheel.Advance(1, ExpiredPayloads);
+	TestTrue(TEXT("A zero delay waits for the next tick"), ExpiredPayloads == TArray<int32>({ 5 }));
+
+	ExpiredPayloads.Reset();
+	TimerWheel.Advance(3, ExpiredPayloads);
+	TestTrue(TEXT("Nothing is due before its tick"), ExpiredPayloads.IsEmpty());
+
+	TimerWheel.Advance(1, ExpiredPayloads);
+	TestTrue(TEXT("Due on the exact tick"), ExpiredPayloads == TArray<int32>({ 0 }));
+
+	// Crossing level boundaries in one big step still reports timers in expiry order.
+	ExpiredPayloads.Reset();
+	TimerWheel.Advance(69995, ExpiredPayloads);
+	TestTrue(TEXT("Cascaded from the upper levels"), ExpiredPayloads == TArray<int32>({ 1, 2 }));
+
+	ExpiredPayloads.Reset();
+	TimerWheel.Advance((1ull << 24) + 10 - 70000 - 1, ExpiredPayloads);
+	TestTrue(TEXT("Overflow timer not due yet"), ExpiredPayloads.IsEmpty());
+
+	TimerWheel.Advance(1, ExpiredPayloads);
+	TestTrue(TEXT("Overflow timer due"), ExpiredPayloads == TArray<int32>({ 3 }));
+	TestTrue(TEXT("Wheel is empty"), TimerWheel.IsEmpty());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWarriorCountDownTimingTest, "Warrior.TimerWheel.CountDownTiming", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FWarriorCountDownTimingTest::RunTest(const FString& Parameters)
+{
+	// No execution function, so the outputs are only written, never sent to Blueprint.
+	FLatentActionInfo LatentInfo;
+	LatentInfo.CallbackTarget = GetTransientPackage();
+
+	float RemainingTime = 0.f;
+	EWarriorCountDownActionOutput CountDownOutput = EWarriorCountDownActionOutput::Cancelled;
+
+	FWarriorCountDownAction CountDownAction(1.f, 0.01f, RemainingTime, CountDownOutput, LatentInfo);
+
+	// Each wake adds the time that really passed, not the interval it was scheduled for.
+	TestFalse(TEXT("Running after a 30ms wake"), CountDownAction.UpdateOperation(0.03f));
+	TestEqual(TEXT("Remaining after a 30ms wake"), RemainingTime, 0.97f, UE_KINDA_SMALL_NUMBER);
+	TestTrue(TEXT("Updated output"), CountDownOutput == EWarriorCountDownActionOutput::Updated);
+
+	// A hitch covers the rest of the count down in a single wake.
+	TestTrue(TEXT("Done after a hitch"), CountDownAction.UpdateOperation(2.f));
+	TestEqual(TEXT("Nothing remaining"), RemainingTime, 0.f);
+	TestTrue(TEXT("Completed output"), CountDownOutput == EWarriorCountDownActionOutput::Completed);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
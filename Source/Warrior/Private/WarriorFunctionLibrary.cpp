@@ -8,10 +8,11 @@
 #include "GenericTeamAgentInterface.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "WarriorGameplayTags.h"
-#include "WarriorTypes/WarriorCountDownAction.h"
+#include "Subsystems/WarriorCountDownSubsystem.h"
 #include "GameInstance/WarriorGameInstance.h"
 #include "Kismet/GameplayStatics.h"
-#include "SaveGame/WarriorSaveGame.h"
+#include "SaveGame/WarriorSaveGameSubsystem.h"
+#include "WarriorStats.h"
 
 #include "WarriorDebugHelper.h"
 
@@ -44,6 +45,8 @@ void UWarriorFunctionLibrary::RemoveGameplayTagFromActorIfFound(AActor* InActor,
 
 bool UWarriorFunctionLibrary::NativeDoesActorHaveTag(AActor* InActor, FGameplayTag TagToCheck)
 {
+	INC_DWORD_STAT(STAT_Warrior_TagQueries);
+
 	UWarriorAbilitySystemComponent* ASC = NativeGetWarriorASCFromActor(InActor);
 
 	return ASC->HasMatchingGameplayTag(TagToCheck);
@@ -169,26 +172,22 @@ void UWarriorFunctionLibrary::CountDown(const UObject* WorldContextObject, float
 		return;
 	}
 
-	FLatentActionManager& LatentActionManager = World->GetLatentActionManager();
+	UWarriorCountDownSubsystem* CountDownSubsystem = World->GetSubsystem<UWarriorCountDownSubsystem>();
 
-	FWarriorCountDownAction* FoundAction = LatentActionManager.FindExistingAction<FWarriorCountDownAction>(LatentInfo.CallbackTarget, LatentInfo.UUID);
+	if (!CountDownSubsystem)
+	{
+		return;
+	}
 
 	if (CountDownInput == EWarriorCountDownActionInput::Start)
 	{
-		if (!FoundAction)
-		{
-			LatentActionManager.AddNewAction(LatentInfo.CallbackTarget, LatentInfo.UUID, new FWarriorCountDownAction(TotalTime, UpdateInterval, OutRemainingTime, CountDownOutput, LatentInfo));
-		}
+		CountDownSubsystem->StartCountDown(TotalTime, UpdateInterval, OutRemainingTime, CountDownOutput, LatentInfo);
 	}
 
 	if (CountDownInput == EWarriorCountDownActionInput::Cancel)
 	{
-		if (FoundAction)
-		{
-			FoundAction->CancelAction();
-		}
+		CountDownSubsystem->CancelCountDown(LatentInfo);
 	}
-
 }
 
 UWarriorGameInstance* UWarriorFunctionLibrary::GetWorldGameInstance(UObject* WorldContextObject)
@@ -245,34 +244,23 @@ void UWarriorFunctionLibrary::ToggleInputMode(const UObject* WorldContextObject,
 	}
 }
 
-void UWarriorFunctionLibrary::SaveCurrentGameDifficulty(EWarriorGameplayDifficulty ToSaveGameDifficulty)
+void UWarriorFunctionLibrary::SaveCurrentGameDifficulty(const UObject* WorldContextObject, EWarriorGameplayDifficulty ToSaveGameDifficulty)
 {
-	USaveGame* SaveGameObject = UGameplayStatics::CreateSaveGameObject(UWarriorSaveGame::StaticClass());
+	UGameInstance* GameInstance = UGameplayStatics::GetGameInstance(WorldContextObject);
 
-	if (UWarriorSaveGame* WarriorSaveGameObject = Cast<UWarriorSaveGame>(SaveGameObject))
+	if (UWarriorSaveGameSubsystem* SaveGameSubsystem = GameInstance ? GameInstance->GetSubsystem<UWarriorSaveGameSubsystem>() : nullptr)
 	{
-		WarriorSaveGameObject->SavedCurrentGameDifficulty = ToSaveGameDifficulty;
-
-		const bool bWasSaved = UGameplayStatics::SaveGameToSlot(SaveGameObject, WarriorGameplayTags::GameData_SaveGame_Slot_1.GetTag().ToString(), 0);
-
-		Debug::Print(bWasSaved ? TEXT("Difficulty Saved") : TEXT("Difficulty NOT Saved"));
+		SaveGameSubsystem->SetSavedGameDifficulty(ToSaveGameDifficulty);
 	}
 }
 
-bool UWarriorFunctionLibrary::TryLoadSavedGameDifficulty(EWarriorGameplayDifficulty& OutSavedGameplayDifficulty)
+bool UWarriorFunctionLibrary::TryLoadSavedGameDifficulty(const UObject* WorldContextObject, EWarriorGameplayDifficulty& OutSavedGameplayDifficulty)
 {
-	if (UGameplayStatics::DoesSaveGameExist(WarriorGameplayTags::GameData_SaveGame_Slot_1.GetTag().ToString(), 0))
-	{
-		USaveGame* SavedGameObject = UGameplayStatics::LoadGameFromSlot(WarriorGameplayTags::GameData_SaveGame_Slot_1.GetTag().ToString(), 0);
-
-		if (UWarriorSaveGame* WarriorSavedGameObject = Cast<UWarriorSaveGame>(SavedGameObject))
-		{
-			OutSavedGameplayDifficulty = WarriorSavedGameObject->SavedCurrentGameDifficulty;
-
-			Debug::Print(TEXT("Loading Successful"), FColor::Green);
+	UGameInstance* GameInstance = UGameplayStatics::GetGameInstance(WorldContextObject);
 
-			return true;
-		}
+	if (UWarriorSaveGameSubsystem* SaveGameSubsystem = GameInstance ? GameInstance->GetSubsystem<UWarriorSaveGameSubsystem>() : nullptr)
+	{
+		return SaveGameSubsystem->TryGetSavedGameDifficulty(OutSavedGameplayDifficulty);
 	}
 
 	return false;
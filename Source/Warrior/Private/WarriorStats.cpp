@@ -0,0 +1,160 @@
+// ALL FREE
+
+
+#include "WarriorStats.h"
+#include "HAL/LowLevelMemStats.h"
+
+/** Level Transition **/
+DEFINE_STAT(STAT_Warrior_LastLevelTransitionMs);
+DEFINE_STAT(STAT_Warrior_LastLevelTransitionPrefetched);
+DEFINE_STAT(STAT_Warrior_LastLoadToFirstInputMs);
+
+/** Save Game **/
+DEFINE_STAT(STAT_Warrior_SaveGameLoadLatencyMs);
+DEFINE_STAT(STAT_Warrior_SaveGameSaveLatencyMs);
+DEFINE_STAT(STAT_Warrior_SaveGameWrites);
+
+/** Gameplay Counters **/
+DEFINE_STAT(STAT_Warrior_AliveEnemies);
+DEFINE_STAT(STAT_Warrior_EnemySpawnsPerSecond);
+DEFINE_STAT(STAT_Warrior_PendingAsyncLoads);
+DEFINE_STAT(STAT_Warrior_GameplayEffectsApplied);
+DEFINE_STAT(STAT_Warrior_MeleeOverlaps);
+DEFINE_STAT(STAT_Warrior_TagQueries);
+DEFINE_STAT(STAT_Warrior_TargetLockCandidates);
+DEFINE_STAT(STAT_Warrior_OrientedPawns);
+DEFINE_STAT(STAT_Warrior_AwareEnemies);
+DEFINE_STAT(STAT_Warrior_AwarenessTraces);
+DEFINE_STAT(STAT_Warrior_CrowdAgentsSimulated);
+DEFINE_STAT(STAT_Warrior_CrowdAgentsFullQuality);
+DEFINE_STAT(STAT_Warrior_EnemiesNavWalking);
+DEFINE_STAT(STAT_Warrior_AttackTokensInUse);
+DEFINE_STAT(STAT_Warrior_AttackTokensDenied);
+DEFINE_STAT(STAT_Warrior_FlowFieldFollowers);
+DEFINE_STAT(STAT_Warrior_UtilityBrainEnemies);
+DEFINE_STAT(STAT_Warrior_EnemyHealthBarsShown);
+
+/** Gameplay Cycles **/
+DEFINE_STAT(STAT_Warrior_SurvivalSpawn);
+DEFINE_STAT(STAT_Warrior_TargetLockTick);
+DEFINE_STAT(STAT_Warrior_TargetLockAcquire);
+DEFINE_STAT(STAT_Warrior_DamageExecution);
+DEFINE_STAT(STAT_Warrior_AttributePostExecute);
+DEFINE_STAT(STAT_Warrior_CombatHitTarget);
+DEFINE_STAT(STAT_Warrior_AIServiceTick);
+DEFINE_STAT(STAT_Warrior_OrientationBatch);
+DEFINE_STAT(STAT_Warrior_AwarenessPass);
+DEFINE_STAT(STAT_Warrior_EnemyLODPass);
+DEFINE_STAT(STAT_Warrior_FlowFieldUpdate);
+DEFINE_STAT(STAT_Warrior_UtilityBrainPass);
+DEFINE_STAT(STAT_Warrior_UtilityBrainScoring);
+
+/** Input Latency **/
+DEFINE_STAT(STAT_Warrior_InputToActivationMs);
+DEFINE_STAT(STAT_Warrior_InputToMontageStartMs);
+DEFINE_STAT(STAT_Warrior_InputToFirstHitMs);
+
+/** AI Budget **/
+DEFINE_STAT(STAT_Warrior_BehaviorTreeTick);
+DEFINE_STAT(STAT_Warrior_BehaviorTreeFrameMs);
+DEFINE_STAT(STAT_Warrior_BehaviorTreesTicked);
+DEFINE_STAT(STAT_Warrior_BehaviorTreesDeferred);
+
+/** Memory **/
+DECLARE_LLM_MEMORY_STAT(TEXT("Warrior"), STAT_Warrior_SummaryLLM, STATGROUP_LLM);
+DECLARE_LLM_MEMORY_STAT(TEXT("Warrior Enemies"), STAT_Warrior_EnemiesLLM, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("Warrior Abilities"), STAT_Warrior_AbilitiesLLM, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("Warrior Widgets"), STAT_Warrior_WidgetsLLM, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("Warrior Projectiles"), STAT_Warrior_ProjectilesLLM, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("Warrior Wave Archetypes"), STAT_Warrior_WaveArchetypesLLM, STATGROUP_LLMFULL);
+
+LLM_DEFINE_TAG(Warrior_Enemies, NAME_None, NAME_None, GET_STATFNAME(STAT_Warrior_EnemiesLLM), GET_STATFNAME(STAT_Warrior_SummaryLLM));
+LLM_DEFINE_TAG(Warrior_Abilities, NAME_None, NAME_None, GET_STATFNAME(STAT_Warrior_AbilitiesLLM), GET_STATFNAME(STAT_Warrior_SummaryLLM));
+LLM_DEFINE_TAG(Warrior_Widgets, NAME_None, NAME_None, GET_STATFNAME(STAT_Warrior_WidgetsLLM), GET_STATFNAME(STAT_Warrior_SummaryLLM));
+LLM_DEFINE_TAG(Warrior_Projectiles, NAME_None, NAME_None, GET_STATFNAME(STAT_Warrior_ProjectilesLLM), GET_STATFNAME(STAT_Warrior_SummaryLLM));
+LLM_DEFINE_TAG(Warrior_WaveArchetypes, NAME_None, NAME_None, GET_STATFNAME(STAT_Warrior_WaveArchetypesLLM), GET_STATFNAME(STAT_Warrior_SummaryLLM));
+
+TSharedPtr<FStreamableHandle> WarriorStats::RequestTrackedAsyncLoad(FStreamableManager& InStreamableManager, TArray<FSoftObjectPath> InTargetsToStream, FStreamableDelegate InDelegate, TAsyncLoadPriority InPriority)
+{
+	INC_DWORD_STAT(STAT_Warrior_PendingAsyncLoads);
+
+	// A handle can be cancelled after it completed, or complete without ever being handed out, only the first of them stops counting the load.
+	TSharedRef<bool> bIsPending = MakeShared<bool>(true);
+
+	auto StopCounting = [bIsPending]()
+	{
+		if (*bIsPending)
+		{
+			*bIsPending = false;
+			DEC_DWORD_STAT(STAT_Warrior_PendingAsyncLoads);
+		}
+	};
+
+	TSharedPtr<FStreamableHandle> Handle = InStreamableManager.RequestAsyncLoad(
+		MoveTemp(InTargetsToStream),
+		FStreamableDelegate::CreateLambda(
+			[StopCounting, InDelegate = MoveTemp(InDelegate)]()
+			{
+				StopCounting();
+
+				WARRIOR_HITCH_SCOPE(AsyncLoadCompletion);
+				InDelegate.ExecuteIfBound();
+			}
+		),
+		InPriority
+	);
+
+	if (Handle.IsValid())
+	{
+		Handle->BindCancelDelegate(FStreamableDelegate::CreateLambda(StopCounting));
+	}
+	else
+	{
+		// Nothing was requested, so nothing is pending either.
+		StopCounting();
+	}
+
+	return Handle;
+}
+
+TSharedPtr<FStreamableHandle> WarriorStats::RequestTrackedAsyncLoad(FStreamableManager& InStreamableManager, const FSoftObjectPath& InTargetToStream, FStreamableDelegate InDelegate, TAsyncLoadPriority InPriority)
+{
+	return RequestTrackedAsyncLoad(InStreamableManager, TArray<FSoftObjectPath>{ InTargetToStream }, MoveTemp(InDelegate), InPriority);
+}
+
+static WarriorStats::FHitchScopeTimings GHitchScopeTimings;
+
+const TCHAR* LexToString(EWarriorHitchScope InScope)
+{
+	switch (InScope)
+	{
+	case EWarriorHitchScope::EnemySpawn:			return TEXT("EnemySpawn");
+	case EWarriorHitchScope::AsyncLoadCompletion:	return TEXT("AsyncLoadCompletion");
+	case EWarriorHitchScope::GarbageCollection:		return TEXT("GarbageCollection");
+	case EWarriorHitchScope::DamageResolution:		return TEXT("DamageResolution");
+	case EWarriorHitchScope::WidgetCreation:		return TEXT("WidgetCreation");
+	case EWarriorHitchScope::AbilityActivation:		return TEXT("AbilityActivation");
+	case EWarriorHitchScope::InputMappingChange:	return TEXT("InputMappingChange");
+	default:										return TEXT("Unknown");
+	}
+}
+
+void WarriorStats::AddHitchScopeTiming(EWarriorHitchScope InScope, double InMs)
+{
+	check(IsInGameThread());
+
+	FHitchScopeTiming& Timing = GHitchScopeTimings[static_cast<uint8>(InScope)];
+	Timing.TotalMs += InMs;
+	Timing.Count++;
+}
+
+void WarriorStats::ConsumeHitchScopeTimings(FHitchScopeTimings& OutTimings)
+{
+	check(IsInGameThread());
+
+	for (int32 ScopeIndex = 0; ScopeIndex < UE_ARRAY_COUNT(GHitchScopeTimings); ScopeIndex++)
+	{
+		OutTimings[ScopeIndex] = GHitchScopeTimings[ScopeIndex];
+		GHitchScopeTimings[ScopeIndex] = FHitchScopeTiming();
+	}
+}
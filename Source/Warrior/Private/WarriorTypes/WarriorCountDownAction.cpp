@@ -3,46 +3,57 @@
 
 #include "WarriorTypes/WarriorCountDownAction.h"
 
-void FWarriorCountDownAction::UpdateOperation(FLatentResponse& Response)
+bool FWarriorCountDownAction::UpdateOperation(float InElapsedTime)
 {
-	if (bNeedToCancel)
+	// The output references live in the callback target's frame, so they must not be touched once it is gone.
+	if (!CallbackTarget.IsValid())
 	{
-		CountDownOutput = EWarriorCountDownActionOutput::Cancelled;
-
-		Response.FinishAndTriggerIf(true, ExecutionFunction, OutputLink, CallbackTarget);
-
-		return;
+		return true;
 	}
 
-	if (ElapsedTimeSinceStart >= TotalCountDownTime)
+	if (bNeedToCancel)
 	{
-		CountDownOutput = EWarriorCountDownActionOutput::Completed;
-
-		Response.FinishAndTriggerIf(true, ExecutionFunction, OutputLink, CallbackTarget);
+		TriggerOutput(EWarriorCountDownActionOutput::Cancelled);
 
-		return;
-	}
-
-	if (ElapsedInterval < UpdateInterval)
-	{
-		ElapsedInterval += Response.ElapsedTime();
+		return true;
 	}
 
-	else
-	{
-		ElapsedTimeSinceStart += UpdateInterval > 0.f ? UpdateInterval : Response.ElapsedTime();
+	ElapsedTimeSinceStart += InElapsedTime;
 
-		OutRemainingTime = TotalCountDownTime - ElapsedTimeSinceStart;
+	OutRemainingTime = FMath::Max(TotalCountDownTime - ElapsedTimeSinceStart, 0.f);
 
-		CountDownOutput = EWarriorCountDownActionOutput::Updated;
+	TriggerOutput(EWarriorCountDownActionOutput::Updated);
 
-		Response.TriggerLink(ExecutionFunction, OutputLink, CallbackTarget);
+	if (ElapsedTimeSinceStart >= TotalCountDownTime && CallbackTarget.IsValid() && !bNeedToCancel)
+	{
+		TriggerOutput(EWarriorCountDownActionOutput::Completed);
 
-		ElapsedInterval = 0.f;
+		return true;
 	}
+
+	return !CallbackTarget.IsValid();
 }
 
 void FWarriorCountDownAction::CancelAction()
 {
 	bNeedToCancel = true;
 }
+
+void FWarriorCountDownAction::TriggerOutput(EWarriorCountDownActionOutput InOutput)
+{
+	UObject* Target = CallbackTarget.Get();
+
+	if (!Target)
+	{
+		return;
+	}
+
+	CountDownOutput = InOutput;
+
+	// Same call the latent action manager makes to resume a latent node.
+	if (UFunction* Function = Target->FindFunction(ExecutionFunction))
+	{
+		int32 Link = OutputLink;
+		Target->ProcessEvent(Function, &Link);
+	}
+}
@@ -0,0 +1,277 @@
+// ALL FREE
+
+
+#include "WarriorTypes/WarriorTelemetryLog.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#include "WarriorDebugHelper.h"
+
+namespace WarriorTelemetryLog
+{
+	constexpr uint32 Magic = 0x4D4C5457; // "WTLM"
+
+	enum class EVersion : uint16
+	{
+		Initial = 1,
+
+		VersionPlusOne,
+		Latest = VersionPlusOne - 1
+	};
+
+	enum class ERecordType : uint8
+	{
+		Frame,
+		Marker
+	};
+
+	constexpr int64 HeaderSize = 32;
+
+	static void SerializeHeader(FArchive& Ar, uint16& Version, uint32& Capacity, uint64& NumRecordsWritten)
+	{
+		uint32 FileMagic = Magic;
+		uint16 RecordSize = FWarriorTelemetryRingWriter::RecordSize;
+		uint32 Reserved32 = 0;
+		uint64 Reserved64 = 0;
+
+		Ar << FileMagic;
+		Ar << Version;
+		Ar << RecordSize;
+		Ar << Capacity;
+		Ar << Reserved32;
+		Ar << NumRecordsWritten;
+		Ar << Reserved64;
+
+		if (Ar.IsLoading() && (FileMagic != Magic || RecordSize != FWarriorTelemetryRingWriter::RecordSize))
+		{
+			Ar.SetError();
+		}
+	}
+
+	/** Hundredths of a millisecond, which keeps frames up to 655 ms exact enough for percentiles */
+	static uint16 QuantizeMs(float InMs)
+	{
+		return static_cast<uint16>(FMath::Clamp(FMath::RoundToInt32(InMs * 100.f), 0, static_cast<int32>(MAX_uint16)));
+	}
+
+	static float DequantizeMs(uint16 InQuantizedMs)
+	{
+		return InQuantizedMs / 100.f;
+	}
+}
+
+const TCHAR* LexToString(EWarriorTelemetryMarker InMarker)
+{
+	switch (InMarker)
+	{
+	case EWarriorTelemetryMarker::WaveStarted:		return TEXT("WaveStarted");
+	case EWarriorTelemetryMarker::WaveCompleted:	return TEXT("WaveCompleted");
+	case EWarriorTelemetryMarker::SpawnBurst:		return TEXT("SpawnBurst");
+	case EWarriorTelemetryMarker::TargetLockOn:		return TEXT("TargetLockOn");
+	case EWarriorTelemetryMarker::TargetLockOff:	return TEXT("TargetLockOff");
+	case EWarriorTelemetryMarker::WeaponEquipped:	return TEXT("WeaponEquipped");
+	case EWarriorTelemetryMarker::WeaponUnequipped:	return TEXT("WeaponUnequipped");
+	case EWarriorTelemetryMarker::CrowdAgents:		return TEXT("CrowdAgents");
+	default:										return TEXT("Unknown");
+	}
+}
+
+FWarriorTelemetryRingWriter::FWarriorTelemetryRingWriter(const FString& InFilePath, uint32 InCapacity)
+	: FilePath(InFilePath)
+	, Capacity(FMath::Max(InCapacity, 1u))
+	, WritePipe(TEXT("WarriorTelemetryPipe"))
+{
+	PendingBytes.Reserve(RecordSize * 128);
+}
+
+FWarriorTelemetryRingWriter::~FWarriorTelemetryRingWriter()
+{
+	Flush();
+
+	FileHandle.Reset();
+}
+
+void FWarriorTelemetryRingWriter::AppendFrame(const FWarriorTelemetryFrame& InFrame)
+{
+	using namespace WarriorTelemetryLog;
+
+	FMemoryWriter Writer(PendingBytes, false, true);
+
+	uint32 FrameNumber = InFrame.FrameNumber;
+	uint8 RecordType = static_cast<uint8>(ERecordType::Frame);
+	uint8 Padding = 0;
+	uint16 FrameMs = QuantizeMs(InFrame.FrameMs);
+	uint16 GameThreadMs = QuantizeMs(InFrame.GameThreadMs);
+	uint16 RenderThreadMs = QuantizeMs(InFrame.RenderThreadMs);
+	uint16 GPUMs = QuantizeMs(InFrame.GPUMs);
+	uint16 GCMs = QuantizeMs(InFrame.GCMs);
+
+	Writer << FrameNumber << RecordType << Padding << FrameMs << GameThreadMs << RenderThreadMs << GPUMs << GCMs;
+}
+
+void FWarriorTelemetryRingWriter::AppendMarker(const FWarriorTelemetryMarker& InMarker)
+{
+	using namespace WarriorTelemetryLog;
+
+	FMemoryWriter Writer(PendingBytes, false, true);
+
+	uint32 FrameNumber = InMarker.FrameNumber;
+	uint8 RecordType = static_cast<uint8>(ERecordType::Marker);
+	uint8 Marker = static_cast<uint8>(InMarker.Marker);
+	uint16 Padding16 = 0;
+	int32 Value = InMarker.Value;
+	uint32 Padding32 = 0;
+
+	Writer << FrameNumber << RecordType << Marker << Padding16 << Value << Padding32;
+}
+
+void FWarriorTelemetryRingWriter::Submit()
+{
+	if (PendingBytes.IsEmpty())
+	{
+		return;
+	}
+
+	const uint64 FirstRecordIndex = NumRecordsSubmitted;
+	NumRecordsSubmitted += PendingBytes.Num() / RecordSize;
+
+	WritePipe.Launch(UE_SOURCE_LOCATION,
+		[this, Batch = MoveTemp(PendingBytes), FirstRecordIndex]()
+		{
+			WriteBatch(Batch, FirstRecordIndex);
+		}
+	);
+
+	PendingBytes.Reset(RecordSize * 128);
+}
+
+void FWarriorTelemetryRingWriter::Flush()
+{
+	Submit();
+
+	WritePipe.WaitUntilEmpty();
+}
+
+void FWarriorTelemetryRingWriter::WriteBatch(const TArray<uint8>& InBatch, uint64 InFirstRecordIndex)
+{
+	using namespace WarriorTelemetryLog;
+
+	if (!FileHandle)
+	{
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+		PlatformFile.CreateDirectoryTree(*FPaths::GetPath(FilePath));
+
+		FileHandle.Reset(PlatformFile.OpenWrite(*FilePath, false, true));
+
+		if (!FileHandle)
+		{
+			WARRIOR_LOG(Warning, TEXT("Could not open telemetry file %s"), *FilePath);
+			return;
+		}
+	}
+
+	const int32 NumRecords = InBatch.Num() / RecordSize;
+	int32 RecordIndex = 0;
+
+	// Write the batch in at most two contiguous runs, one up to the end of the ring and one from its start.
+	while (RecordIndex < NumRecords)
+	{
+		const uint32 Slot = static_cast<uint32>((InFirstRecordIndex + RecordIndex) % Capacity);
+		const int32 NumContiguous = FMath::Min<int32>(NumRecords - RecordIndex, Capacity - Slot);
+
+		FileHandle->Seek(HeaderSize + static_cast<int64>(Slot) * RecordSize);
+		FileHandle->Write(InBatch.GetData() + RecordIndex * RecordSize, static_cast<int64>(NumContiguous) * RecordSize);
+
+		RecordIndex += NumContiguous;
+	}
+
+	// The header goes last, so a crash mid batch leaves a file that still describes the records before it.
+	TArray<uint8> HeaderBytes;
+	FMemoryWriter HeaderWriter(HeaderBytes);
+
+	uint16 Version = static_cast<uint16>(EVersion::Latest);
+	uint32 FileCapacity = Capacity;
+	uint64 NumRecordsWritten = InFirstRecordIndex + NumRecords;
+	SerializeHeader(HeaderWriter, Version, FileCapacity, NumRecordsWritten);
+
+	FileHandle->Seek(0);
+	FileHandle->Write(HeaderBytes.GetData(), HeaderBytes.Num());
+	FileHandle->Flush();
+}
+
+bool FWarriorTelemetryRingWriter::ReadRingFile(const FString& InFilePath, TArray<FWarriorTelemetryFrame>& OutFrames, TArray<FWarriorTelemetryMarker>& OutMarkers)
+{
+	using namespace WarriorTelemetryLog;
+
+	TArray<uint8> FileBytes;
+
+	if (!FFileHelper::LoadFileToArray(FileBytes, *InFilePath, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(FileBytes);
+
+	uint16 Version = 0;
+	uint32 FileCapacity = 0;
+	uint64 NumRecordsWritten = 0;
+	SerializeHeader(Reader, Version, FileCapacity, NumRecordsWritten);
+
+	if (Reader.IsError() || Version == 0 || Version > static_cast<uint16>(EVersion::Latest) || FileCapacity == 0)
+	{
+		WARRIOR_LOG(Warning, TEXT("%s is not a telemetry file this build can read"), *InFilePath);
+		return false;
+	}
+
+	const uint64 NumRecords = FMath::Min<uint64>(NumRecordsWritten, FileCapacity);
+	const uint64 FirstRecordIndex = NumRecordsWritten - NumRecords;
+
+	if (HeaderSize + static_cast<int64>(NumRecords) * RecordSize > FileBytes.Num())
+	{
+		WARRIOR_LOG(Warning, TEXT("%s is truncated"), *InFilePath);
+		return false;
+	}
+
+	for (uint64 RecordIndex = FirstRecordIndex; RecordIndex < NumRecordsWritten; RecordIndex++)
+	{
+		Reader.Seek(HeaderSize + static_cast<int64>(RecordIndex % FileCapacity) * RecordSize);
+
+		uint32 FrameNumber = 0;
+		uint8 RecordType = 0;
+		Reader << FrameNumber << RecordType;
+
+		if (RecordType == static_cast<uint8>(ERecordType::Frame))
+		{
+			uint8 Padding = 0;
+			uint16 FrameMs = 0, GameThreadMs = 0, RenderThreadMs = 0, GPUMs = 0, GCMs = 0;
+			Reader << Padding << FrameMs << GameThreadMs << RenderThreadMs << GPUMs << GCMs;
+
+			FWarriorTelemetryFrame& Frame = OutFrames.AddDefaulted_GetRef();
+			Frame.FrameNumber = FrameNumber;
+			Frame.FrameMs = DequantizeMs(FrameMs);
+			Frame.GameThreadMs = DequantizeMs(GameThreadMs);
+			Frame.RenderThreadMs = DequantizeMs(RenderThreadMs);
+			Frame.GPUMs = DequantizeMs(GPUMs);
+			Frame.GCMs = DequantizeMs(GCMs);
+		}
+		else if (RecordType == static_cast<uint8>(ERecordType::Marker))
+		{
+			uint8 Marker = 0;
+			uint16 Padding16 = 0;
+			int32 Value = 0;
+			Reader << Marker << Padding16 << Value;
+
+			if (Marker < static_cast<uint8>(EWarriorTelemetryMarker::Num))
+			{
+				FWarriorTelemetryMarker& MarkerRecord = OutMarkers.AddDefaulted_GetRef();
+				MarkerRecord.FrameNumber = FrameNumber;
+				MarkerRecord.Marker = static_cast<EWarriorTelemetryMarker>(Marker);
+				MarkerRecord.Value = Value;
+			}
+		}
+	}
+
+	return !Reader.IsError();
+}
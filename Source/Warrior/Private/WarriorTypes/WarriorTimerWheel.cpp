@@ -0,0 +1,164 @@
+// ALL FREE
+
+
+#include "WarriorTypes/WarriorTimerWheel.h"
+
+FWarriorTimerWheel::FWarriorTimerWheel()
+{
+	Reset();
+}
+
+int32 FWarriorTimerWheel::AddTimer(uint64 InDelayTicks, int32 InPayload)
+{
+	FTimer NewTimer;
+	NewTimer.ExpireTick = CurrentTick + FMath::Max<uint64>(InDelayTicks, 1);
+	NewTimer.Payload = InPayload;
+
+	const int32 TimerId = Timers.Add(NewTimer);
+
+	LinkTimer(TimerId);
+
+	return TimerId;
+}
+
+void FWarriorTimerWheel::RemoveTimer(int32 InTimerId)
+{
+	if (!Timers.IsValidIndex(InTimerId))
+	{
+		return;
+	}
+
+	UnlinkTimer(InTimerId);
+
+	Timers.RemoveAt(InTimerId);
+}
+
+void FWarriorTimerWheel::Advance(uint64 InNumTicks, TArray<int32>& OutExpiredPayloads)
+{
+	for (uint64 TickIndex = 0; TickIndex < InNumTicks; TickIndex++)
+	{
+		CurrentTick++;
+
+		// Once a lower level wraps around, the next slot of the level above is due and gets spread over the levels below.
+		if ((CurrentTick & SlotMask) == 0)
+		{
+			const uint64 LevelOneIndex = (CurrentTick >> SlotBits) & SlotMask;
+
+			if (LevelOneIndex == 0)
+			{
+				const uint64 LevelTwoIndex = (CurrentTick >> (SlotBits * 2)) & SlotMask;
+
+				if (LevelTwoIndex == 0)
+				{
+					CascadeSlot(OverflowSlot);
+				}
+
+				CascadeSlot(SlotsPerLevel * 2 + static_cast<int32>(LevelTwoIndex));
+			}
+
+			CascadeSlot(SlotsPerLevel + static_cast<int32>(LevelOneIndex));
+		}
+
+		const int32 DueSlot = static_cast<int32>(CurrentTick & SlotMask);
+
+		while (SlotHeads[DueSlot] != INDEX_NONE)
+		{
+			const int32 TimerId = SlotHeads[DueSlot];
+
+			OutExpiredPayloads.Add(Timers[TimerId].Payload);
+
+			RemoveTimer(TimerId);
+		}
+
+		if (Timers.IsEmpty())
+		{
+			// Nothing left to wake up, so skip straight to the end instead of walking empty slots.
+			CurrentTick += InNumTicks - TickIndex - 1;
+			break;
+		}
+	}
+}
+
+void FWarriorTimerWheel::Reset()
+{
+	Timers.Empty();
+
+	for (int32& SlotHead : SlotHeads)
+	{
+		SlotHead = INDEX_NONE;
+	}
+
+	CurrentTick = 0;
+}
+
+void FWarriorTimerWheel::LinkTimer(int32 InTimerId)
+{
+	FTimer& Timer = Timers[InTimerId];
+
+	const uint64 TicksUntilExpire = Timer.ExpireTick - CurrentTick;
+
+	if (TicksUntilExpire < (1ull << SlotBits))
+	{
+		Timer.Slot = static_cast<int32>(Timer.ExpireTick & SlotMask);
+	}
+	else if (TicksUntilExpire < (1ull << (SlotBits * 2)))
+	{
+		Timer.Slot = SlotsPerLevel + static_cast<int32>((Timer.ExpireTick >> SlotBits) & SlotMask);
+	}
+	else if (TicksUntilExpire < (1ull << (SlotBits * 3)))
+	{
+		Timer.Slot = SlotsPerLevel * 2 + static_cast<int32>((Timer.ExpireTick >> (SlotBits * 2)) & SlotMask);
+	}
+	else
+	{
+		Timer.Slot = OverflowSlot;
+	}
+
+	Timer.Prev = INDEX_NONE;
+	Timer.Next = SlotHeads[Timer.Slot];
+
+	if (Timer.Next != INDEX_NONE)
+	{
+		Timers[Timer.Next].Prev = InTimerId;
+	}
+
+	SlotHeads[Timer.Slot] = InTimerId;
+}
+
+void FWarriorTimerWheel::UnlinkTimer(int32 InTimerId)
+{
+	FTimer& Timer = Timers[InTimerId];
+
+	if (Timer.Prev != INDEX_NONE)
+	{
+		Timers[Timer.Prev].Next = Timer.Next;
+	}
+	else
+	{
+		SlotHeads[Timer.Slot] = Timer.Next;
+	}
+
+	if (Timer.Next != INDEX_NONE)
+	{
+		Timers[Timer.Next].Prev = Timer.Prev;
+	}
+
+	Timer.Slot = INDEX_NONE;
+	Timer.Prev = INDEX_NONE;
+	Timer.Next = INDEX_NONE;
+}
+
+void FWarriorTimerWheel::CascadeSlot(int32 InSlot)
+{
+	int32 TimerId = SlotHeads[InSlot];
+	SlotHeads[InSlot] = INDEX_NONE;
+
+	while (TimerId != INDEX_NONE)
+	{
+		const int32 NextTimerId = Timers[TimerId].Next;
+
+		LinkTimer(TimerId);
+
+		TimerId = NextTimerId;
+	}
+}
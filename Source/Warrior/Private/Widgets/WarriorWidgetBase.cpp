@@ -3,9 +3,13 @@
 
 #include "Widgets/WarriorWidgetBase.h"
 #include "Interfaces/PawnUIInterface.h"
+#include "WarriorStats.h"
 
 void UWarriorWidgetBase::NativeOnInitialized()
 {
+	LLM_SCOPE_BYTAG(Warrior_Widgets);
+	WARRIOR_HITCH_SCOPE(WidgetCreation);
+
 	Super::NativeOnInitialized();
 
 	if (IPawnUIInterface* PawnUIInterface = Cast<IPawnUIInterface>(GetOwningPlayerPawn()))
@@ -19,6 +23,8 @@ void UWarriorWidgetBase::NativeOnInitialized()
 
 void UWarriorWidgetBase::InitEnemyCreatedWidget(AActor* OwningEnemyActor)
 {
+	LLM_SCOPE_BYTAG(Warrior_Widgets);
+
 	if (IPawnUIInterface* PawnUIInterface = Cast<IPawnUIInterface>(OwningEnemyActor))
 	{
 		UEnemyUIComponent* EnemyUIComponent = PawnUIInterface->GetEnemyUIComponent();
@@ -0,0 +1,35 @@
+// ALL FREE
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/Decorators/BTDecorator_BlackboardBase.h"
+#include "WarriorTypes/WarriorEnumTypes.h"
+#include "BTDecorator_IsChosenAction.generated.h"
+
+/**
+ * Lets its branch run only while the utility brain's ChosenAction key holds Action, and aborts it as soon as the brain picks something else.
+ * Put one above each action branch of an enemy tree whose controller sets bUseUtilityBrain.
+ */
+UCLASS()
+class WARRIOR_API UBTDecorator_IsChosenAction : public UBTDecorator_BlackboardBase
+{
+	GENERATED_BODY()
+
+	UBTDecorator_IsChosenAction();
+
+	//~ Begin UBTNode Interface
+	virtual FString GetStaticDescription() const override;
+	//~ End UBTNode Interface
+
+	//~ Begin UBTDecorator Interface
+	virtual bool CalculateRawConditionValue(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const override;
+	//~ End UBTDecorator Interface
+
+	UPROPERTY(EditAnywhere, Category = "Utility Brain")
+	EWarriorEnemyAction Action;
+
+	/** Also pass while the key is None, so the same tree keeps working on controllers without the utility brain */
+	UPROPERTY(EditAnywhere, Category = "Utility Brain")
+	bool bPassWithoutDecision;
+};
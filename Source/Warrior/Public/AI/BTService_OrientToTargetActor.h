@@ -4,10 +4,12 @@
 
 #include "CoreMinimal.h"
 #include "BehaviorTree/BTService.h"
+#include "BehaviorTree/BlackboardComponent.h"
 #include "BTService_OrientToTargetActor.generated.h"
 
 /**
- * 
+ * Keeps the pawn turned towards the target actor key while the branch is active.
+ * The turning itself is done by UWarriorOrientationSubsystem, this node only subscribes the pawn and follows changes to the key.
  */
 UCLASS()
 class WARRIOR_API UBTService_OrientToTargetActor : public UBTService
@@ -21,7 +23,15 @@ class WARRIOR_API UBTService_OrientToTargetActor : public UBTService
 	virtual FString GetStaticDescription() const override;
 	//~ End UBTNode Interface
 
-	virtual void TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
+	//~ Begin UBTAuxiliaryNode Interface
+	virtual void OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual void OnCeaseRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	//~ End UBTAuxiliaryNode Interface
+
+	EBlackboardNotificationResult OnTargetActorKeyChanged(const UBlackboardComponent& Blackboard, FBlackboard::FKey ChangedKeyID);
+
+	/** Registers the pawn with the current target, or unregisters it when the key is empty */
+	void UpdateOrientationTarget(const UBlackboardComponent& Blackboard) const;
 
 	UPROPERTY(EditAnywhere, Category = "Target")
 	FBlackboardKeySelector InTargetActorKey;
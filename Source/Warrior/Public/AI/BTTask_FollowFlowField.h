@@ -0,0 +1,40 @@
+// ALL FREE
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BTTaskNode.h"
+#include "BTTask_FollowFlowField.generated.h"
+
+struct FFollowFlowFieldTaskMemory
+{
+	TWeakObjectPtr<APawn> OwningPawn;
+};
+
+/**
+ * Walks the pawn towards the hero along UWarriorFlowFieldSubsystem's shared field instead of planning a path of its own.
+ * Succeeds within FinalApproachDistance of the hero, so a MoveTo after it only has the last stretch to plan.
+ * Fails where the field has no way to go, off the grid or before the field is built, so the tree can fall back to a regular MoveTo.
+ */
+UCLASS()
+class WARRIOR_API UBTTask_FollowFlowField : public UBTTaskNode
+{
+	GENERATED_BODY()
+
+	UBTTask_FollowFlowField();
+
+	//~ Begin UBTNode Interface
+	virtual uint16 GetInstanceMemorySize() const override;
+	virtual FString GetStaticDescription() const override;
+	//~ End UBTNode Interface
+
+	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual void TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
+	virtual void OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult) override;
+
+	/** Measured in the ground plane */
+	bool IsWithinFinalApproach(const APawn* QueryPawn, const FVector& InTargetLocation) const;
+
+	UPROPERTY(EditAnywhere, Category = "Flow Field")
+	float FinalApproachDistance;
+};
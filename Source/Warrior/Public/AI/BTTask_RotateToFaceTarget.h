@@ -12,6 +12,9 @@ struct FRotateToFaceTargetTaskMemory
 	TWeakObjectPtr<APawn> OwningPawn;
 	TWeakObjectPtr<AActor> TargetActor;
 
+	/** Set when the world has no orientation subsystem, the task then turns the pawn itself */
+	bool bRotateInTask = false;
+
 	bool IsValid() const
 	{
 		return OwningPawn.IsValid() && TargetActor.IsValid();
@@ -21,11 +24,12 @@ struct FRotateToFaceTargetTaskMemory
 	{
 		OwningPawn.Reset();
 		TargetActor.Reset();
+		bRotateInTask = false;
 	}
 };
 
 /**
- * 
+ * Turns the pawn towards the target key through UWarriorOrientationSubsystem and succeeds once it faces the target within AnglePrecision.
  */
 UCLASS()
 class WARRIOR_API UBTTask_RotateToFaceTarget : public UBTTaskNode
@@ -42,8 +46,9 @@ class WARRIOR_API UBTTask_RotateToFaceTarget : public UBTTaskNode
 
 	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
 	virtual void TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
+	virtual void OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult) override;
 
-	bool HasReachedAnglePrecision(APawn* QueryPawn, AActor* TargetActor) const;
+	bool HasReachedAnglePrecision(const APawn* QueryPawn, const AActor* TargetActor) const;
 
 	UPROPERTY(EditAnywhere, Category = "Face Target")
 	float AnglePrecision;
@@ -53,5 +58,14 @@ class WARRIOR_API UBTTask_RotateToFaceTarget : public UBTTaskNode
 
 	UPROPERTY(EditAnywhere, Category = "Face Target")
 	FBlackboardKeySelector InTargetToFaceKey;
-	
+
+	/** Cosine of AnglePrecision, set in InitializeFromAsset */
+	float AnglePrecisionCos = 1.f;
+
+public:
+	/**
+	 * Same answer as the old DegAcos check against AnglePrecision, without the acos.
+	 * Measured in the ground plane, since only the yaw is ever turned. A target straight above or below counts as faced.
+	 */
+	bool IsFacingWithinPrecision(const FVector& InForward, const FVector& InToTarget) const;
 };
@@ -0,0 +1,26 @@
+// ALL FREE
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "WarriorBehaviorTreeComponent.generated.h"
+
+/**
+ * Behavior tree component that asks UWarriorBehaviorTreeBudgetSubsystem before every tick.
+ * Skipped frames are handed to the next tick that does run, so latent tasks still see the full elapsed time.
+ */
+UCLASS()
+class WARRIOR_API UWarriorBehaviorTreeComponent : public UBehaviorTreeComponent
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UActorComponent Interface.
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	//~ End UActorComponent Interface
+
+private:
+	/** Time from ticks the budget turned down */
+	float DeferredDeltaTime = 0.f;
+};
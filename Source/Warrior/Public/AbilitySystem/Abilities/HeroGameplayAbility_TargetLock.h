@@ -71,6 +71,13 @@ private:
 	UPROPERTY(EditDefaultsOnly, Category = "Target Lock")
 	float TargetLockCameraOffsetDistance = 25.f;
 
+	/** Drive OnTargetLockTick from a native tick task. The Blueprint graph should skip its own Execute Task On Tick node when this is set. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Target Lock", meta = (AllowPrivateAccess = "true"))
+	bool bUseNativeTick = false;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Target Lock", meta = (EditCondition = "bUseNativeTick", ClampMin = "0.0"))
+	float NativeTickInterval = 0.f;
+
 	UPROPERTY()
 	TArray<AActor*> AvailableActorsToLock;
 
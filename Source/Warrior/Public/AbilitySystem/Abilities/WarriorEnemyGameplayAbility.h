@@ -17,6 +17,11 @@ class WARRIOR_API UWarriorEnemyGameplayAbility : public UWarriorGameplayAbility
 	GENERATED_BODY()
 
 public:
+	//~ Begin UGameplayAbility Interface.
+	virtual void ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData) override;
+	virtual void EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled) override;
+	//~ End UGameplayAbility Interface
+
 	UFUNCTION(BlueprintPure, Category = "Warrior|Ability")
 	AWarriorEnemyCharacter* GetEnemyCharacterFromActorInfo();
 
@@ -26,6 +31,18 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Warrior|Ability")
 	FGameplayEffectSpecHandle MakeEnemyDamageEffectSpecHandle(TSubclassOf<UGameplayEffect> EffectClass, const FScalableFloat& InDamageScalableFloat);
 
+protected:
+	/** Takes one of the attack slots UWarriorAttackTokenSubsystem hands out around the target on activation, turned away enemies are cancelled and get Enemy.Status.Strafing */
+	UPROPERTY(EditDefaultsOnly, Category = "Attack Token")
+	bool bRequiresAttackToken = false;
+
+	/** Slots this archetype takes up, heavier enemies leave less room for others */
+	UPROPERTY(EditDefaultsOnly, Category = "Attack Token", meta = (EditCondition = "bRequiresAttackToken", ClampMin = "1"))
+	int32 AttackTokenCost = 1;
+
 private:
+	/** The blackboard target of the enemy's controller */
+	static AActor* GetAttackTokenTarget(const FGameplayAbilityActorInfo* ActorInfo);
+
 	TWeakObjectPtr<AWarriorEnemyCharacter> CachedWarriorEnemyCharacter;
 };
@@ -24,6 +24,9 @@ UCLASS()
 class WARRIOR_API UWarriorGameplayAbility : public UGameplayAbility
 {
 	GENERATED_BODY()
+
+public:
+	FORCEINLINE const FGameplayTagContainer& GetWarriorAbilityTags() const { return AbilityTags; }
 	
 protected:
 	// ~ Begin UGameplayAbility Interface.
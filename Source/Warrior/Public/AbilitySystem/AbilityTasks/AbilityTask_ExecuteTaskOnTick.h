@@ -7,6 +7,7 @@
 #include "AbilityTask_ExecuteTaskOnTick.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnAbilityTaskTickDelegate, float, DeltaTime);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnAbilityTaskNativeTickDelegate, float /*DeltaTime*/);
 
 /**
  * 
@@ -17,15 +18,26 @@ class WARRIOR_API UAbilityTask_ExecuteTaskOnTick : public UAbilityTask
 	GENERATED_BODY()
 	
 public:
-	UAbilityTask_ExecuteTaskOnTick();
-
+	/** A TickInterval of 0 ticks every frame. Otherwise the delta handed out is the time accumulated since the last tick. */
 	UFUNCTION(BlueprintCallable, Category = "Warrior|AbilityTasks", meta = (HidePin = "OwningAbility", DefaultToSelf = "OwningAbility", BlueprintInternalUseOnly = "true"))
-	static UAbilityTask_ExecuteTaskOnTick* ExecuteTaskOnTick(UGameplayAbility* OwningAbility);
+	static UAbilityTask_ExecuteTaskOnTick* ExecuteTaskOnTick(UGameplayAbility* OwningAbility, float TickInterval = 0.f);
 
 	//~ Begin UGameplayTask Interface
-	virtual void TickTask(float DeltaTime) override;
+	virtual void Activate() override;
+	virtual void OnDestroy(bool bInOwnerFinished) override;
 	//~ End UGameplayTask Interface
 
+	/** Called by UWarriorTaskTickSubsystem once the interval has elapsed */
+	void ExecuteTick(float DeltaTime);
+
 	UPROPERTY(BlueprintAssignable)
 	FOnAbilityTaskTickDelegate OnAbilityTaskTick;
+
+	/** For C++ subscribers, skips the Blueprint VM */
+	FOnAbilityTaskNativeTickDelegate OnAbilityTaskNativeTick;
+
+	FORCEINLINE float GetTickInterval() const { return TickInterval; }
+
+private:
+	float TickInterval = 0.f;
 };
@@ -16,6 +16,12 @@ class WARRIOR_API UWarriorAbilitySystemComponent : public UAbilitySystemComponen
 	GENERATED_BODY()
 
 public:
+	//~ Begin UAbilitySystemComponent Interface.
+	virtual FActiveGameplayEffectHandle ApplyGameplayEffectSpecToSelf(const FGameplayEffectSpec& GameplayEffect, FPredictionKey PredictionKey = FPredictionKey()) override;
+	virtual float PlayMontage(UGameplayAbility* AnimatingAbility, FGameplayAbilityActivationInfo ActivationInfo, UAnimMontage* Montage, float InPlayRate, FName StartSectionName = NAME_None, float StartTimeSeconds = 0.0f) override;
+	virtual void NotifyAbilityActivated(const FGameplayAbilitySpecHandle Handle, UGameplayAbility* Ability) override;
+	//~ End UAbilitySystemComponent Interface
+
 	void OnAbilityInputPressed(const FGameplayTag& InInputTag);
 	void OnAbilityInputReleased(const FGameplayTag& InInputTag);
 	
@@ -27,4 +33,19 @@ public:
 
 	UFUNCTION(BlueprintCallable, Category = "Warrior|Ability")
 	bool TryActivateAbilityByTag(FGameplayTag AbilityTagToActivate);
+
+	/** Collects the remaining time of every active cooldown whose granted tag sits under InCooldownParentTag */
+	void GetRemainingCooldownsByParentTag(const FGameplayTag& InCooldownParentTag, TMap<FGameplayTag, float>& OutRemainingCooldowns) const;
+
+	/** Re-applies the cooldown effect of the ability that owns InCooldownTag, locked to InRemainingTime */
+	bool RestoreCooldownByTag(const FGameplayTag& InCooldownTag, float InRemainingTime);
+
+protected:
+	//~ Begin UAbilitySystemComponent Interface.
+	virtual UGameplayAbility* CreateNewInstanceOfAbility(FGameplayAbilitySpec& Spec, const UGameplayAbility* Ability) override;
+	//~ End UAbilitySystemComponent Interface
+
+private:
+	/** Set while an input press activates its abilities, so activations from anything else are not counted as input latency */
+	bool bIsActivatingFromInput = false;
 };
@@ -55,4 +55,5 @@ protected:
 public:
 	FORCEINLINE UWarriorAbilitySystemComponent* GetWarriorAbilitySystemComponent() const {return WarriorAbilitySystemComponent;}
 	FORCEINLINE UWarriorAttributeSet* GetWarriorAttributeSet() const {return WarriorAttributeSet;}
+	FORCEINLINE const TSoftObjectPtr<UDataAsset_StartupDataBase>& GetCharacterStartUpData() const { return CharacterStartUpData; }
 };
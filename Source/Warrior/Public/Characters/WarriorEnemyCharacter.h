@@ -32,8 +32,19 @@ public:
 	virtual UEnemyUIComponent* GetEnemyUIComponent() const override;
 	//~ End IPawnUIInterface Interface
 
+	/** Applied right away if the start up data is already granted, otherwise as soon as it is */
+	void RestoreHealthPercent(float InHealthPercent);
+
+	/** Lean enemies also register the hit box for the attack window and unregister it once the window closes */
+	void SetHandCollisionBoxEnabled(UBoxComponent* InCollisionBox, bool bShouldEnable);
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	//~ Begin AActor Interface.
+	virtual void PreRegisterAllComponents() override;
+	//~ End AActor Interface
 
 	//~ Begin APawn Interface.
 	virtual void PossessedBy(AController* NewController) override;
@@ -66,14 +77,46 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "UI")
 	UWidgetComponent* EnemyHealthWidgetComponent;
 
+	/**
+	 * Keeps the hand hit boxes unregistered outside of attack windows and the health bar unregistered and uncreated until the enemy is hurt near the hero.
+	 * Unregistered components cost no transform updates, physics state or widget ticks. They are still constructed, so the memory of the enemy itself does not change.
+	 * Warrior.Enemy.LeanComponents overrides this for every enemy.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Performance")
+	bool bUseLeanComponents = false;
+
 	UFUNCTION()
 	virtual void OnBodyCollisionBoxBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
 
+	UFUNCTION()
+	void OnLeanHealthChanged(float NewPercent);
+
 private:
 	void InitEnemyStartUpData();
+	void ApplyRestoredHealthPercent();
+
+	/** Creates the health bar widget the first time, counted as a widget rather than as the enemy */
+	void CreateHealthWidget();
+	void SetHealthWidgetShown(bool bShouldShow);
+
+	/** Shows the health bar of a hurt lean enemy inside Warrior.Enemy.HealthWidgetDistance of the hero, hides it past HealthWidgetHideDistance or once healed */
+	void UpdateLeanHealthWidget();
+
+	TOptional<float> PendingRestoredHealthPercent;
+
+	bool bEnemyStartUpDataGranted = false;
+
+	/** bUseLeanComponents after Warrior.Enemy.LeanComponents, resolved once before the components register */
+	bool bLeanComponentsActive = false;
+
+	float LeanHealthPercent = 1.f;
+
+	/** Runs UpdateLeanHealthWidget while the enemy is hurt, so the bar follows the hero coming and going */
+	FTimerHandle LeanHealthWidgetTimerHandle;
 
 public:
 	FORCEINLINE UEnemyCombatComponent* GetEnemyCombatComponent() const { return EnemyCombatComponent; }
 	FORCEINLINE UBoxComponent* GetLeftHandCollisionBox() const { return LeftHandHitBoxComponent; }
 	FORCEINLINE UBoxComponent* GetRightHandCollisionBox() const { return RightHandHitBoxComponent; }
+	FORCEINLINE bool IsUsingLeanComponents() const { return bLeanComponentsActive; }
 };
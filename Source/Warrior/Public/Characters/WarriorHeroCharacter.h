@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Characters/WarriorBaseCharacter.h"
 #include "GameplayTagContainer.h"
+#include "SaveGame/WarriorSessionSnapshot.h"
 #include "WarriorHeroCharacter.generated.h"
 
 class USpringArmComponent;
@@ -13,6 +14,7 @@ class UDataAsset_InputConfig;
 struct FInputActionValue;
 class UHeroCombatComponent;
 class UHeroUIComponent;
+struct FStreamableHandle;
 
 /**
  * 
@@ -34,6 +36,11 @@ public:
 	virtual UHeroUIComponent* GetHeroUIComponent() const override;
 	//~ End IPawnUIInterface Interface
 
+	void CaptureSessionSnapshot(FWarriorHeroSnapshot& OutHeroSnapshot) const;
+
+	/** Applied right away if the start up data is already granted, otherwise as soon as it is */
+	void RestoreFromSessionSnapshot(const FWarriorHeroSnapshot& InHeroSnapshot);
+
 protected:
 
 	//~ Begin APawn Interface.
@@ -76,8 +83,20 @@ private:
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "UI", meta = (AllowPrivateAccess = "true"))
 	UHeroUIComponent* HeroUIComponent;
+
+	void InitHeroStartUpData();
+	void ApplySessionSnapshot(const FWarriorHeroSnapshot& InHeroSnapshot);
+
+	TSharedPtr<FStreamableHandle> StartUpDataStreamableHandle;
+
+	double PossessedTimeSeconds = 0.0;
+
+	TOptional<FWarriorHeroSnapshot> PendingSessionSnapshot;
+
+	bool bHeroStartUpDataGranted = false;
 	
 public:
 	FORCEINLINE UHeroCombatComponent* GetHeroCombatComponent() const { return HeroCombatComponent; }
+	FORCEINLINE bool HasGrantedHeroStartUpData() const { return bHeroStartUpDataGranted; }
 
 };
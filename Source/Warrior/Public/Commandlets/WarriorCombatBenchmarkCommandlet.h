@@ -0,0 +1,65 @@
+// ALL FREE
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "WarriorCombatBenchmarkCommandlet.generated.h"
+
+class AWarriorBaseCharacter;
+
+/**
+ * Times the combat code that runs on every hit against N attacker and target pairs in an empty game world, reporting ns/op and allocations/op.
+ * Returns non zero when a result is slower than the baseline by more than -Tolerance or allocates more than it. Results with no baseline entry only warn.
+ * UnrealEditor-Cmd Warrior.uproject -run=WarriorCombatBenchmark -nullrhi -unattended [-Actors=1,16,128] [-Ops=20000] [-Tolerance=0.25]
+ *     [-Pawn=<class path>] [-Baseline=<file.csv>] [-Output=<file.csv>] [-UpdateBaseline]
+ * -Pawn defaults to the native enemy class, pass a Blueprint with start up data to measure a fully set up character.
+ * The baseline lives in Build/Benchmarks/WarriorCombatBaseline.csv and is recorded on the build machine with -UpdateBaseline.
+ * Allocations are read from the allocator's own call counters, which only stats builds keep.
+ */
+UCLASS()
+class WARRIOR_API UWarriorCombatBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UWarriorCombatBenchmarkCommandlet();
+
+	//~ Begin UCommandlet Interface.
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+
+	struct FBenchmarkResult
+	{
+		FString Name;
+		int32 NumActors = 0;
+		double NsPerOp = 0.0;
+
+		/** Negative when the allocator doesn't report its call counts */
+		double AllocsPerOp = 0.0;
+	};
+
+	/** Keyed by Name@Actors */
+	static bool LoadBaseline(const FString& InFilePath, TMap<FString, FBenchmarkResult>& OutBaseline);
+	static bool WriteCsv(const FString& InFilePath, const TArray<FBenchmarkResult>& InResults);
+
+	static FString GetBaselineKey(const FBenchmarkResult& InResult);
+
+	static bool IsRegression(const FBenchmarkResult& InResult, const FBenchmarkResult& InBaselineResult, float InTolerance);
+
+private:
+
+	struct FCombatants
+	{
+		TArray<AWarriorBaseCharacter*> Attackers;
+		TArray<AWarriorBaseCharacter*> Targets;
+	};
+
+	static FCombatants SpawnCombatants(UWorld* InWorld, TSubclassOf<AWarriorBaseCharacter> InPawnClass, int32 InNumActors);
+	static void DestroyCombatants(FCombatants& InCombatants);
+
+	static void RunBenchmarks(const FCombatants& InCombatants, int32 InNumOps, TArray<FBenchmarkResult>& OutResults);
+
+	/** Calls InOp InNumOps times per repetition after a short warm up and keeps the best repetition, InOp gets the index of the op */
+	static FBenchmarkResult Measure(const TCHAR* InName, int32 InNumActors, int32 InNumOps, TFunctionRef<void(int32)> InOp);
+};
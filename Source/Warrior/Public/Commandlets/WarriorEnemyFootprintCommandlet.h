@@ -0,0 +1,68 @@
+// ALL FREE
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "WarriorEnemyFootprintCommandlet.generated.h"
+
+class AWarriorEnemyCharacter;
+
+/**
+ * Spawns one instance of every enemy Blueprint under a content path in an empty game world and writes its memory footprint to a CSV.
+ * UnrealEditor-Cmd Warrior.uproject -run=WarriorEnemyFootprint -nullrhi -unattended [-Path=/Game/EnemyCharacter] [-Output=<file.csv>] [-CompareLean]
+ * Registered scene components are the ones moved with the mesh every frame. -CompareLean measures every archetype twice, with and without lean components.
+ * Health bar widgets are created by their widget component, not the enemy, so they get their own columns. They only exist when Slate is initialized.
+ */
+UCLASS()
+class WARRIOR_API UWarriorEnemyFootprintCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UWarriorEnemyFootprintCommandlet();
+
+	//~ Begin UCommandlet Interface.
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+
+private:
+	enum class EReferenceCategory : uint8
+	{
+		Mesh,
+		Anim,
+		Ability,
+		StartUpData,
+		Other,
+		MAX
+	};
+
+	struct FEnemyFootprint
+	{
+		FString ArchetypeName;
+		int32 NumObjects = 0;
+		int32 NumComponents = 0;
+		int32 NumRegisteredComponents = 0;
+		int32 NumRegisteredSceneComponents = 0;
+		int32 NumTickingComponents = 0;
+		int64 OwnedBytes = 0;
+		int32 NumWidgetObjects = 0;
+		int64 WidgetBytes = 0;
+		int32 NumHardReferencedPackages = 0;
+		int64 HardReferencedBytesByCategory[static_cast<uint8>(EReferenceCategory::MAX)] = {};
+	};
+
+	void GatherEnemyClasses(const FString& InContentPath, TArray<TSubclassOf<AWarriorEnemyCharacter>>& OutEnemyClasses) const;
+
+	FEnemyFootprint MeasureEnemy(UWorld* InWorld, TSubclassOf<AWarriorEnemyCharacter> InEnemyClass) const;
+
+	/** Walks the hard package dependencies of InRootPackageName, skipping native /Script packages */
+	static void GatherHardPackageDependencies(FName InRootPackageName, TSet<FName>& OutPackageNames);
+
+	static EReferenceCategory CategorizePackage(const UPackage* InPackage);
+
+	/** Serialized size plus the exclusive resource size reported by the object itself */
+	static int64 GetObjectBytes(UObject* InObject);
+
+	static bool WriteCsv(const FString& InFilePath, const TArray<FEnemyFootprint>& InFootprints);
+};
@@ -0,0 +1,35 @@
+// ALL FREE
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "WarriorTypes/WarriorTelemetryLog.h"
+#include "WarriorTelemetryAnalyzerCommandlet.generated.h"
+
+/**
+ * Turns a telemetry ring file into percentile tables for the whole session, each wave and the frames following each kind of marker.
+ * UnrealEditor-Cmd Warrior.uproject -run=WarriorTelemetryAnalyzer [-Input=<file.wtlm>] [-Output=<file.csv>] [-MarkerWindow=30]
+ * Without -Input the newest file in Saved/Profiling/Telemetry is used.
+ */
+UCLASS()
+class WARRIOR_API UWarriorTelemetryAnalyzerCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UWarriorTelemetryAnalyzerCommandlet();
+
+	//~ Begin UCommandlet Interface.
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+
+private:
+	static FString FindNewestTelemetryFile();
+
+	/** Adds one percentile row per timing to OutLines */
+	static void AppendPercentileRows(const FString& InScope, const FString& InName, TConstArrayView<FWarriorTelemetryFrame> InFrames, TArray<FString>& OutLines);
+
+	/** Nearest rank percentile of an already sorted array */
+	static float GetPercentile(const TArray<float>& InSortedValues, float InPercentile);
+};
@@ -0,0 +1,70 @@
+// ALL FREE
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "Navigation/CrowdManager.h"
+#include "WarriorWaveStressCommandlet.generated.h"
+
+class AWarriorAIController;
+class AWarriorEnemyCharacter;
+
+/**
+ * Crowd manager the wave stress commandlet swaps in, so Detour's own share of the frame can be told apart from the rest of the world tick.
+ */
+UCLASS(Transient, NotBlueprintable)
+class WARRIOR_API UWarriorTimedCrowdManager : public UCrowdManager
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UCrowdManagerBase Interface.
+	virtual void Tick(float DeltaTime) override;
+	//~ End UCrowdManagerBase Interface
+
+	double GetTotalTickMs() const { return TotalTickMs; }
+
+private:
+	double TotalTickMs = 0.0;
+};
+
+/**
+ * Loads a level with a nav mesh, then grows the enemy crowd wave by wave while every enemy chases a hero stand in that circles the level.
+ * Each wave simulates -Frames fixed steps and writes to a CSV the game thread ms/frame, the crowd manager and enemy LOD pass ms/frame and how many agents Detour simulated.
+ * UnrealEditor-Cmd Warrior.uproject -run=WarriorWaveStress -nullrhi -unattended [-Map=/Game/Maps/GamemodeTestMap] [-Pawn=<class path>]
+ *     [-Waves=16,32,64,128] [-Frames=600] [-DisableLOD] [-Output=<file.csv>]
+ * Run once with and once without -DisableLOD to compare the crowd level of detail. Add -trace=cpu,stats to break the crowd time down further in Insights.
+ */
+UCLASS()
+class WARRIOR_API UWarriorWaveStressCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UWarriorWaveStressCommandlet();
+
+	//~ Begin UCommandlet Interface.
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+
+private:
+	struct FWaveResult
+	{
+		int32 NumEnemies = 0;
+		int32 NumFrames = 0;
+		double MeanFrameMs = 0.0;
+		double P95FrameMs = 0.0;
+		double MeanCrowdMs = 0.0;
+		double P95CrowdMs = 0.0;
+		double MeanLODPassMs = 0.0;
+		double MeanSimulatedAgents = 0.0;
+	};
+
+	/** Spawns enemies on random reachable points until there are InNumEnemies of them, returns false when the level has no nav mesh to spawn on */
+	static bool SpawnEnemies(UWorld* InWorld, TSubclassOf<AWarriorEnemyCharacter> InEnemyClass, const FVector& InCenter, int32 InNumEnemies, TArray<AWarriorAIController*>& InOutControllers);
+
+	static FWaveResult SimulateWave(UWorld* InWorld, APawn* InHero, const FVector& InCenter, const TArray<AWarriorAIController*>& InControllers, const UWarriorTimedCrowdManager* InCrowdManager, int32 InNumFrames);
+
+	static bool WriteCsv(const FString& InFilePath, bool bInLODEnabled, const TArray<FWaveResult>& InResults);
+};
@@ -4,10 +4,13 @@
 
 #include "CoreMinimal.h"
 #include "AIController.h"
+#include "BehaviorTree/BehaviorTreeTypes.h"
+#include "WarriorTypes/WarriorEnumTypes.h"
 #include "WarriorAIController.generated.h"
 
 class UAIPerceptionComponent;
 class UAISenseConfig_Sight;
+class UBlackboardData;
 
 /**
  * 
@@ -25,8 +28,26 @@ public:
 	virtual ETeamAttitude::Type GetTeamAttitudeTowards(const AActor& Other) const override;
 	//~ End IGenericTeamAgentInterface Interface
 
+	/** Writes InActor to the TargetActor key unless a target is already set. Returns true if it was written. */
+	bool TrySetTargetActor(AActor* InActor);
+
+	bool HasTargetActor() const;
+
+	AActor* GetTargetActor() const;
+
+	/** Does nothing if the blackboard has no ChosenAction key */
+	void SetChosenAction(EWarriorEnemyAction InAction);
+
+	FORCEINLINE float GetUtilityAttackRange() const { return UtilityAttackRange; }
+	FORCEINLINE float GetUtilityRetreatHealthRatio() const { return UtilityRetreatHealthRatio; }
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	//~ Begin AAIController Interface.
+	virtual FAIRequestID RequestMove(const FAIMoveRequest& MoveRequest, FNavPathSharedPtr Path) override;
+	//~ End AAIController Interface
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
 	UAIPerceptionComponent* EnemyPerceptionComponent;
@@ -46,4 +67,29 @@ private:
 
 	UPROPERTY(EditDefaultsOnly, Category = "Detour Crowd Avoidance Config", meta = (EditCondition = "bEnableDetourCrowdAvoidance"))
 	float CollisionQueryRange = 600.f;
+
+	/** Turns off the sight sense and lets UWarriorAwarenessSubsystem look for the hero instead, using the same sight radius */
+	UPROPERTY(EditDefaultsOnly, Category = "Awareness Config")
+	bool bUseSharedHeroAwareness = false;
+
+	/** Lets UWarriorUtilityBrainSubsystem pick the next action and write it to the ChosenAction key, UBTDecorator_IsChosenAction then lets only that branch run */
+	UPROPERTY(EditDefaultsOnly, Category = "Utility Brain Config")
+	bool bUseUtilityBrain = false;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Utility Brain Config", meta = (EditCondition = "bUseUtilityBrain"))
+	float UtilityAttackRange = 250.f;
+
+	/** Below this share of max health an enemy that is being hit prefers to back off */
+	UPROPERTY(EditDefaultsOnly, Category = "Utility Brain Config", meta = (EditCondition = "bUseUtilityBrain", ClampMin = "0", ClampMax = "1"))
+	float UtilityRetreatHealthRatio = 0.25f;
+
+	/** Resolve the keys once per blackboard asset */
+	FBlackboard::FKey GetTargetActorKeyID() const;
+	FBlackboard::FKey GetChosenActionKeyID() const;
+
+	void CacheBlackboardKeyIDs() const;
+
+	mutable TWeakObjectPtr<const UBlackboardData> CachedBlackboardAsset;
+	mutable FBlackboard::FKey CachedTargetActorKeyID = FBlackboard::InvalidKey;
+	mutable FBlackboard::FKey CachedChosenActionKeyID = FBlackboard::InvalidKey;
 };
@@ -5,8 +5,13 @@
 #include "CoreMinimal.h"
 #include "Engine/GameInstance.h"
 #include "GameplayTagContainer.h"
+#include "Containers/Ticker.h"
 #include "WarriorGameInstance.generated.h"
 
+struct FStreamableHandle;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnLoadScreenPrewarmProgressDelegate, float, PrewarmProgress);
+
 USTRUCT(BlueprintType)
 struct FWarriorGameLevelSet
 {
@@ -18,6 +23,10 @@ struct FWarriorGameLevelSet
 	UPROPERTY(EditDefaultsOnly)
 	TSoftObjectPtr<UWorld> Level;
 
+	/** Projectiles, Niagara systems, UI materials etc. streamed in behind the loading screen before this level is shown */
+	UPROPERTY(EditDefaultsOnly)
+	TArray<FSoftObjectPath> LoadScreenPrewarmAssets;
+
 	bool IsValid() const
 	{
 		return LevelTag.IsValid() && !Level.IsNull();
@@ -36,6 +45,13 @@ class WARRIOR_API UWarriorGameInstance : public UGameInstance
 
 public:
 	virtual void Init() override;
+	virtual void Shutdown() override;
+
+	UPROPERTY(BlueprintAssignable)
+	FOnLoadScreenPrewarmProgressDelegate OnLoadScreenPrewarmProgress;
+
+	/** Called by the hero once its abilities are granted, the load to first input is measured up to this or the loading screen going away, whichever is later */
+	void NotifyHeroReadyForInput();
 
 protected:
 	virtual void OnpenLoadScreen(const FString& MapName);
@@ -44,7 +60,57 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
 	TArray<FWarriorGameLevelSet> GameLevelSets;
 
+	/** Safety net so a stuck or failed stream can never keep the loading screen up forever */
+	UPROPERTY(EditDefaultsOnly, Category = "Load Screen")
+	float MaxLoadScreenPrewarmTime = 15.f;
+
 public:
 	UFUNCTION(BlueprintPure, meta = (GameplayTagFilter = "GameData.Level"))
 	TSoftObjectPtr<UWorld> GetGameLevelByTag(FGameplayTag InTag) const;
+
+	UFUNCTION(BlueprintPure)
+	float GetLoadScreenPrewarmProgress() const { return LoadScreenPrewarmProgress; }
+
+private:
+	const FWarriorGameLevelSet* FindGameLevelSetByWorld(const UWorld* InWorld) const;
+
+	void RequestLoadScreenPrewarmStage(TArray<FSoftObjectPath>&& InAssetsToPrewarm);
+	void CollectFollowUpPrewarmAssets(TArray<FSoftObjectPath>& OutAssetsToPrewarm) const;
+
+	void OnLoadScreenPrewarmStageUpdated(TSharedRef<FStreamableHandle> InHandle);
+	void OnLoadScreenPrewarmStageCompleted(int32 InStageIndex);
+	void FinishLoadScreenPrewarm();
+	bool TickLoadScreenPrewarmTimeout(float DeltaTime);
+
+	void SetLoadScreenPrewarmProgress(float InProgress);
+
+	void TryReportLoadToFirstInput();
+
+	/** Built from GameLevelSets in Init so level lookups by tag don't scan the array */
+	TMap<FGameplayTag, TSoftObjectPtr<UWorld>> GameLevelsByTag;
+
+	/** Kept until the next map load so everything streamed behind the loading screen stays resident */
+	TArray<TSharedPtr<FStreamableHandle>> LoadScreenPrewarmHandles;
+
+	TArray<FSoftObjectPath> LoadScreenPrewarmStageAssets;
+
+	FTSTicker::FDelegateHandle LoadScreenPrewarmTimeoutHandle;
+
+	/** Paused by ExitLoadScreen and unpaused once the loading screen is dismissed. Unset if the world was already paused */
+	TWeakObjectPtr<UWorld> LoadScreenPausedWorld;
+
+	double LoadScreenPrewarmStartTime = 0.0;
+
+	/** Set on PreLoadMap, cleared once the load to first input is reported */
+	double MapLoadStartTime = 0.0;
+
+	int32 LoadScreenPrewarmStageIndex = 0;
+
+	float LoadScreenPrewarmProgress = 0.f;
+
+	bool bIsLoadScreenPrewarming = false;
+
+	bool bIsLoadScreenUp = false;
+
+	bool bIsHeroReadyForInput = false;
 };
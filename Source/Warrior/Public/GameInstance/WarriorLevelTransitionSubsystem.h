@@ -0,0 +1,54 @@
+// ALL FREE
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "GameplayTagContainer.h"
+#include "WarriorLevelTransitionSubsystem.generated.h"
+
+struct FStreamableHandle;
+
+/**
+ * Opens levels by gameplay tag and lets menus stream the likely next level in ahead of time,
+ * so the transition only has to initialize an already loaded world package.
+ */
+UCLASS()
+class WARRIOR_API UWarriorLevelTransitionSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin USubsystem Interface.
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	UFUNCTION(BlueprintCallable, Category = "Warrior|LevelTransition", meta = (GameplayTagFilter = "GameData.Level"))
+	void PrefetchLevelByTag(FGameplayTag InLevelTag);
+
+	UFUNCTION(BlueprintCallable, Category = "Warrior|LevelTransition", meta = (GameplayTagFilter = "GameData.Level"))
+	void CancelLevelPrefetch(FGameplayTag InLevelTag);
+
+	UFUNCTION(BlueprintPure, Category = "Warrior|LevelTransition", meta = (GameplayTagFilter = "GameData.Level"))
+	bool IsLevelPrefetched(FGameplayTag InLevelTag) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Warrior|LevelTransition", meta = (GameplayTagFilter = "GameData.Level"))
+	void OpenLevelByTag(FGameplayTag InLevelTag, const FString& Options = FString(TEXT("")));
+
+	UFUNCTION(BlueprintPure, Category = "Warrior|LevelTransition")
+	float GetLastLevelTransitionTime() const { return LastLevelTransitionTime; }
+
+private:
+	void OnPostLoadMapWithWorld(UWorld* LoadedWorld);
+
+	TMap<FGameplayTag, TSharedPtr<FStreamableHandle>> LevelPrefetchHandles;
+
+	FDelegateHandle PostLoadMapDelegateHandle;
+
+	double LevelTransitionStartTime = 0.0;
+
+	float LastLevelTransitionTime = 0.f;
+
+	bool bIsTransitioningToPrefetchedLevel = false;
+};
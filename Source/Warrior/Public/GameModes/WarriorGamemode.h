@@ -7,6 +7,8 @@
 #include "WarriorTypes/WarriorEnumTypes.h"
 #include "WarriorGamemode.generated.h"
 
+struct FStreamableHandle;
+
 /**
  * 
  */
@@ -18,10 +20,23 @@ class WARRIOR_API AWarriorGamemode : public AGameModeBase
 public:
 	AWarriorGamemode();
 
+	/** Assets the game instance streams in behind the loading screen before this game mode's level is shown */
+	virtual void GetLoadScreenPrewarmAssets(TArray<FSoftObjectPath>& OutAssetsToPrewarm) const;
+
+	/** False when Warrior.Hero.LoadStartUpDataOnPossession asks for the old blocking load, to measure load to first input against it */
+	static bool ShouldPreLoadHeroStartUpData();
+
 protected:
+	virtual void InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage) override;
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Game Settings")
 	EWarriorGameplayDifficulty WarriorGameplaydifficulty;
 
+private:
+	void PreLoadDefaultPawnStartUpData();
+
+	TSharedPtr<FStreamableHandle> DefaultPawnStartUpDataStreamableHandle;
+
 public:
 	FORCEINLINE EWarriorGameplayDifficulty GetCurrentGameDifficulty() const { return WarriorGameplaydifficulty; }
 };
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameModes/WarriorGamemode.h"
+#include "SaveGame/WarriorSessionSnapshot.h"
 #include "WarriorSurvialGamemode.generated.h"
 
 class AWarriorEnemyCharacter;
@@ -66,8 +67,14 @@ private:
 	void PreLoadNextWaveEnemies();
 	FWarriorEnemyWaveSpawnerTableRow* GetCurrentWaveSpawnerTableRow() const;
 	int32 TrySpawnWaveEnemiesNum();
+	AWarriorEnemyCharacter* SpawnWaveEnemy(UClass* InEnemyClass, const FVector& InLocation, const FRotator& InRotation);
 	bool ShouldKeepSpawnEnemies() const;
 
+	void CaptureSessionSnapshot(FWarriorSessionSnapshot& OutSnapshot) const;
+	void WriteSessionCheckpoint(bool bWaveCompleted);
+	void RestoreSessionCheckpoint();
+	void OnSessionCheckpointEnemiesLoaded();
+
 	UFUNCTION()
 	void OnEnemyDestroyed(AActor* DestroyedActor);
 
@@ -107,10 +114,30 @@ private:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "WaveDefinition", meta = (AllowPrivateAccess = "true"))
 	float WaveCompletedWaitTime = 5.f;
 
+	/** How many of the first waves have their enemy classes streamed in behind the loading screen */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "WaveDefinition", meta = (AllowPrivateAccess = "true", ClampMin = "0"))
+	int32 NumWavesToPrewarm = 2;
+
 	UPROPERTY()
 	TMap <TSoftClassPtr<AWarriorEnemyCharacter>, UClass* > PreLoadedEnemyClassMap;
 
+	/** Filled in InitGame when the map was opened with ?RestoreCheckpoint and a checkpoint exists */
+	FWarriorSessionSnapshot PendingSessionCheckpoint;
+
+	TSharedPtr<FStreamableHandle> SessionCheckpointStreamableHandle;
+
+	bool bIsRestoringSessionCheckpoint = false;
+
+	/** Set when a spawn skipped an enemy class that had not finished preloading, the preload spawns once it lands */
+	bool bIsWaveSpawnWaitingForPreload = false;
+
+	/** Feeds STAT_Warrior_EnemySpawnsPerSecond */
+	int32 EnemySpawnsInStatWindow = 0;
+	float EnemySpawnStatWindowTime = 0.f;
+
 public:
+	FORCEINLINE int32 GetCurrentWaveCount() const { return CurrentWaveCount; }
+
 	UFUNCTION(Blueprintcallable)
 	void RegisterSummonSpawnEnemies(const TArray<AWarriorEnemyCharacter*>& InEnemiesToRegister);
 };
@@ -0,0 +1,94 @@
+// ALL FREE
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Tasks/Task.h"
+#include "WarriorTypes/WarriorEnumTypes.h"
+#include "SaveGame/WarriorSessionSnapshot.h"
+#include "WarriorSaveGameSubsystem.generated.h"
+
+class USaveGame;
+class UWarriorSaveGame;
+
+/**
+ * Owns the player's save profile. The slot is read once when the game instance starts,
+ * reads are then served from memory and writes go to disk asynchronously, with bursts
+ * of writes coalesced into a single follow-up save.
+ */
+UCLASS()
+class WARRIOR_API UWarriorSaveGameSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin USubsystem Interface.
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	UFUNCTION(BlueprintCallable, Category = "Warrior|SaveGame")
+	void SetSavedGameDifficulty(EWarriorGameplayDifficulty InGameDifficulty);
+
+	UFUNCTION(BlueprintCallable, Category = "Warrior|SaveGame")
+	bool TryGetSavedGameDifficulty(EWarriorGameplayDifficulty& OutGameDifficulty) const;
+
+	/** Queues an async write of the cached profile. Safe to call repeatedly, in flight writes are coalesced. */
+	UFUNCTION(BlueprintCallable, Category = "Warrior|SaveGame")
+	void RequestSave();
+
+	UFUNCTION(BlueprintPure, Category = "Warrior|SaveGame")
+	bool HasSavedProfile() const { return bHasSavedProfile; }
+
+	UFUNCTION(BlueprintPure, Category = "Warrior|SaveGame")
+	float GetLastLoadLatency() const { return LastLoadLatency; }
+
+	UFUNCTION(BlueprintPure, Category = "Warrior|SaveGame")
+	float GetLastSaveLatency() const { return LastSaveLatency; }
+
+	UWarriorSaveGame* GetCachedSaveGame() const { return CachedSaveGame; }
+
+	/** Keeps the checkpoint in memory and hands it to the background writer */
+	void WriteSessionCheckpoint(FWarriorSessionSnapshot&& InSnapshot);
+
+	bool TryGetSessionCheckpoint(FWarriorSessionSnapshot& OutSnapshot) const;
+
+	void ClearSessionCheckpoint();
+
+	UFUNCTION(BlueprintPure, Category = "Warrior|SaveGame")
+	bool HasSessionCheckpoint() const { return bHasSessionCheckpoint; }
+
+private:
+	void LoadProfileFromSlot();
+	void BeginAsyncSave();
+	void OnAsyncSaveFinished(const FString& InSlotName, const int32 InUserIndex, bool bSuccess);
+
+	UPROPERTY(Transient)
+	TObjectPtr<UWarriorSaveGame> CachedSaveGame;
+
+	/** Writes the serialized profile to the slot, waited on before the synchronous flush in Deinitialize */
+	UE::Tasks::FTask InFlightSaveTask;
+
+	TUniquePtr<FWarriorSessionSnapshotWriter> SessionSnapshotWriter;
+
+	FWarriorSessionSnapshot SessionCheckpoint;
+
+	FString SlotName;
+
+	int32 UserIndex = 0;
+
+	double SaveStartTime = 0.0;
+
+	float LastLoadLatency = 0.f;
+
+	float LastSaveLatency = 0.f;
+
+	bool bHasSavedProfile = false;
+
+	bool bIsSaveInFlight = false;
+
+	bool bIsSaveDirty = false;
+
+	bool bHasSessionCheckpoint = false;
+};
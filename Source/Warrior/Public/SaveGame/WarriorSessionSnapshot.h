@@ -0,0 +1,107 @@
+// ALL FREE
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "Tasks/Pipe.h"
+
+struct FWarriorCooldownSnapshot
+{
+	FGameplayTag CooldownTag;
+
+	float RemainingTime = 0.f;
+};
+
+struct FWarriorHeroSnapshot
+{
+	FVector Location = FVector::ZeroVector;
+
+	float Yaw = 0.f;
+
+	float CurrentHealth = 0.f;
+
+	float CurrentRage = 0.f;
+
+	FGameplayTag EquippedWeaponTag;
+
+	TArray<FWarriorCooldownSnapshot> Cooldowns;
+
+	bool bIsValid = false;
+};
+
+struct FWarriorEnemySnapshot
+{
+	FSoftClassPath EnemyClass;
+
+	FVector Location = FVector::ZeroVector;
+
+	float Yaw = 0.f;
+
+	float HealthPercent = 1.f;
+};
+
+/** A survival run checkpoint. Captured on the game thread at wave boundaries, encoded and written in the background. */
+struct FWarriorSessionSnapshot
+{
+	int32 WaveCount = 1;
+
+	int32 TotalSpawnedEnemiesThisWave = 0;
+
+	uint8 GameDifficulty = 0;
+
+	FWarriorHeroSnapshot Hero;
+
+	TArray<FWarriorEnemySnapshot> Enemies;
+};
+
+/**
+ * Encodes session snapshots into a compact, versioned binary log on disk.
+ * Every record only carries the sections that changed since the previous one, and the log is compacted
+ * back into a single full record every few writes. Encoding and file IO run on a background pipe,
+ * so handing a snapshot over is the only cost on the game thread.
+ */
+class WARRIOR_API FWarriorSessionSnapshotWriter
+{
+public:
+	explicit FWarriorSessionSnapshotWriter(const FString& InFilePath);
+	~FWarriorSessionSnapshotWriter();
+
+	void EnqueueSnapshot(FWarriorSessionSnapshot&& InSnapshot);
+	void EnqueueClear();
+	void Flush();
+
+	/** Replays the log on disk into OutSnapshot. Must be called before anything is enqueued. */
+	bool ReadLatestSnapshot(FWarriorSessionSnapshot& OutSnapshot);
+
+private:
+	void WriteSnapshot(const FWarriorSessionSnapshot& InSnapshot);
+	void ClearSnapshot();
+
+	void EncodeSessionSection(const FWarriorSessionSnapshot& InSnapshot, TArray<uint8>& OutBytes) const;
+	void EncodeHeroSection(const FWarriorHeroSnapshot& InHeroSnapshot, TArray<uint8>& OutBytes);
+	void EncodeEnemiesSection(const TArray<FWarriorEnemySnapshot>& InEnemySnapshots, TArray<uint8>& OutBytes);
+	void EncodeStringTableSection(TArray<uint8>& OutBytes) const;
+
+	bool DecodeSections(uint16 InVersion, FWarriorSessionSnapshot& OutSnapshot);
+
+	uint32 InternString(const FString& InString);
+
+	bool WriteFullLog();
+	bool AppendRecord(const FString& InFilePath, uint8 InSectionMask);
+
+	FString FilePath;
+
+	UE::Tasks::FPipe WritePipe;
+
+	/** Append only between compactions, so records never have to rewrite indices they already stored */
+	TArray<FString> StringTable;
+
+	TMap<FString, uint32> StringTableLookup;
+
+	TArray<TArray<uint8>> LastSectionBytes;
+
+	int32 NumRecordsSinceCompaction = 0;
+
+	bool bLogHasHeader = false;
+};
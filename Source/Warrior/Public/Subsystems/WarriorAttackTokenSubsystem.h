@@ -0,0 +1,74 @@
+// ALL FREE
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "GameplayAbilitySpecHandle.h"
+#include "WarriorAttackTokenSubsystem.generated.h"
+
+/**
+ * Hands out a limited number of concurrent attack slots per target, Warrior.AttackTokens.MaxPerTarget around the hero.
+ * Attackers that were turned away queue up in the order they first asked, a freed slot goes to the front of the queue before any newcomer.
+ * Waiters that stop asking for Warrior.AttackTokens.WaitTimeout seconds lose their place, and tokens held past MaxHoldSeconds are taken back.
+ */
+UCLASS()
+class WARRIOR_API UWarriorAttackTokenSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin USubsystem Interface.
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	/** Pure query, nobody is queued. InCost is how many slots the attacker takes, clamped to the slots there are. */
+	bool CanAcquireToken(const AActor* InAttacker, const AActor* InTarget, int32 InCost) const;
+
+	/** Tokens are held per ability, so one ability ending never frees a token another ability of the same attacker holds. Queues InAttacker when the answer is no. */
+	bool TryAcquireToken(AActor* InAttacker, FGameplayAbilitySpecHandle InAbilityHandle, const AActor* InTarget, int32 InCost);
+	void ReleaseToken(const AActor* InAttacker, FGameplayAbilitySpecHandle InAbilityHandle);
+
+	bool HasToken(const AActor* InAttacker) const;
+
+protected:
+	//~ Begin UWorldSubsystem Interface.
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~ End UWorldSubsystem Interface
+
+private:
+	struct FAttackTokenHolder
+	{
+		TWeakObjectPtr<AActor> Attacker;
+		FGameplayAbilitySpecHandle AbilityHandle;
+		int32 Cost = 1;
+		double AcquiredTime = 0.0;
+	};
+
+	struct FAttackTokenWaiter
+	{
+		TWeakObjectPtr<AActor> Attacker;
+		int32 Cost = 1;
+		double LastRequestTime = 0.0;
+	};
+
+	struct FAttackTokenPool
+	{
+		TArray<FAttackTokenHolder> Holders;
+		TArray<FAttackTokenWaiter> Waiters;
+	};
+
+	/** Drops dead attackers, expired holders and waiters that gave up, taking Enemy.Status.Strafing off the ones that gave up */
+	void PrunePool(FAttackTokenPool& InPool, double InNow) const;
+
+	/** Whether InCost more slots fit once everyone queued ahead of InAttacker is served, attackers the queue does not know yet stand at the back */
+	bool HasRoomFor(const FAttackTokenPool& InPool, const AActor* InAttacker, int32 InCost) const;
+
+	static int32 ClampCost(int32 InCost);
+
+	void UpdateTokensInUseStat() const;
+
+	TMap<FObjectKey, FAttackTokenPool> PoolsByTarget;
+};
@@ -0,0 +1,64 @@
+// ALL FREE
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "WarriorAwarenessSubsystem.generated.h"
+
+class AWarriorAIController;
+
+/**
+ * Shared hero sight for enemies whose controller sets bUseSharedHeroAwareness, replacing their own sight sense.
+ * Every Warrior.Awareness.Interval seconds a single pass range checks all of them against the player pawn and queues one async line of sight trace per enemy in range.
+ * The traces are read back on the next frame, enemies that see the hero get it written to their TargetActor key.
+ */
+UCLASS()
+class WARRIOR_API UWarriorAwarenessSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin USubsystem Interface.
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	//~ Begin FTickableGameObject Interface.
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	void RegisterController(AWarriorAIController* InController, float InSightRadius);
+	void UnregisterController(const AWarriorAIController* InController);
+
+protected:
+	//~ Begin UWorldSubsystem Interface.
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~ End UWorldSubsystem Interface
+
+private:
+	struct FAwareController
+	{
+		TWeakObjectPtr<AWarriorAIController> Controller;
+		float SightRadiusSquared = 0.f;
+	};
+
+	struct FPendingSightTrace
+	{
+		FTraceHandle TraceHandle;
+		TWeakObjectPtr<AWarriorAIController> Controller;
+		TWeakObjectPtr<AActor> TargetActor;
+	};
+
+	/** Applies the traces queued last frame, async results are only readable for one frame */
+	void ConsumePendingSightTraces(UWorld& InWorld);
+
+	void QueueSightTraces(UWorld& InWorld, AActor* InHero);
+
+	TArray<FAwareController> AwareControllers;
+	TArray<FPendingSightTrace> PendingSightTraces;
+
+	float AccumulatedDeltaTime = 0.f;
+};
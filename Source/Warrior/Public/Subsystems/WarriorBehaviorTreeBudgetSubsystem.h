@@ -0,0 +1,50 @@
+// ALL FREE
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WarriorBehaviorTreeBudgetSubsystem.generated.h"
+
+class UBehaviorTreeComponent;
+
+/**
+ * Per frame time budget for UWarriorBehaviorTreeComponent ticks, Warrior.AIBudget.FrameBudgetMs.
+ * Trees of enemies within Warrior.AIBudget.NearDistance of the hero always tick, the rest tick at most every MinInterval and only while the budget lasts.
+ * No tree waits longer than MaxDelay, whatever the budget says. 'stat Warrior' shows what the trees cost each frame.
+ */
+UCLASS()
+class WARRIOR_API UWarriorBehaviorTreeBudgetSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin USubsystem Interface.
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	//~ Begin FTickableGameObject Interface.
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	/** InPendingDeltaTime is everything the tree has not been ticked for yet, this frame included */
+	bool ShouldTickTree(const UBehaviorTreeComponent& InTreeComponent, float InPendingDeltaTime);
+
+	void AddTreeTickCost(double InMs);
+
+protected:
+	//~ Begin UWorldSubsystem Interface.
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~ End UWorldSubsystem Interface
+
+private:
+	/** Taken once per frame, every tree compares against the same location */
+	TOptional<FVector> HeroLocation;
+
+	double FrameCostMs = 0.0;
+
+	int32 NumTreesTicked = 0;
+	int32 NumTreesDeferred = 0;
+};
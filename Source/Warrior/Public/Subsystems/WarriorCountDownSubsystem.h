@@ -0,0 +1,70 @@
+// ALL FREE
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "WarriorTypes/WarriorCountDownAction.h"
+#include "WarriorTypes/WarriorTimerWheel.h"
+#include "WarriorCountDownSubsystem.generated.h"
+
+/**
+ * Drives every CountDown node in the world from a single timer wheel.
+ * Count downs only wake at their update interval boundaries and the subsystem stops ticking when none are running.
+ */
+UCLASS()
+class WARRIOR_API UWarriorCountDownSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin USubsystem Interface.
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	//~ Begin FTickableGameObject Interface.
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	/** Does nothing if the node already has a count down running, same as the latent action it replaces */
+	void StartCountDown(float InTotalTime, float InUpdateInterval, float& OutRemainingTime, EWarriorCountDownActionOutput& OutCountDownOutput, const FLatentActionInfo& InLatentInfo);
+
+	void CancelCountDown(const FLatentActionInfo& InLatentInfo);
+
+	int32 GetNumActiveCountDowns() const { return CountDownActions.Num(); }
+
+protected:
+	//~ Begin UWorldSubsystem Interface.
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~ End UWorldSubsystem Interface
+
+private:
+	using FCountDownKey = TPair<FObjectKey, int32>;
+
+	struct FCountDownEntry
+	{
+		TUniquePtr<FWarriorCountDownAction> Action;
+		FCountDownKey Key;
+		int32 TimerId = INDEX_NONE;
+		uint64 IntervalTicks = 1;
+
+		/** Wheel tick the action was started or last woken at */
+		uint64 LastWakeTick = 0;
+	};
+
+	void RemoveCountDown(int32 InEntryIndex);
+
+	/** Entries stay put while callbacks run, so a node starting another count down can't move the one being updated */
+	TSparseArray<FCountDownEntry> CountDownActions;
+
+	TMap<FCountDownKey, int32> CountDownLookup;
+
+	FWarriorTimerWheel TimerWheel;
+
+	TArray<int32> ExpiredEntryIndices;
+
+	float UnconsumedTime = 0.f;
+};
@@ -0,0 +1,93 @@
+// ALL FREE
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Navigation/CrowdFollowingComponent.h"
+#include "WarriorEnemyLODSubsystem.generated.h"
+
+class AWarriorAIController;
+class ACharacter;
+
+/**
+ * Scales Detour crowd avoidance and character movement of registered enemies with their distance to the hero and the size of the crowd.
+ * Only the closest Warrior.EnemyLOD.MaxFullQualityAgents moving enemies within NearDistance keep the quality and query range their controller asks for.
+ * The rest step down to medium or low quality with a shorter query range, and idle enemies leave the simulation as obstacles until their next move.
+ * Enemies beyond MovementNearDistance and out of combat nav walk instead of running floor sweeps, off screen ones also update their movement less often.
+ */
+UCLASS()
+class WARRIOR_API UWarriorEnemyLODSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin USubsystem Interface.
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	//~ Begin FTickableGameObject Interface.
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	/** InFullQuality and InFullQueryRange are what the enemy gets at the highest level of detail, ignored unless bInScaleCrowdAvoidance */
+	void RegisterEnemy(AWarriorAIController* InController, bool bInScaleCrowdAvoidance, ECrowdAvoidanceQuality::Type InFullQuality, float InFullQueryRange);
+	void UnregisterEnemy(const AWarriorAIController* InController);
+
+	/** Time spent in LOD passes since the subsystem was created, read by the wave stress commandlet */
+	double GetTotalPassMs() const { return TotalPassMs; }
+
+protected:
+	//~ Begin UWorldSubsystem Interface.
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~ End UWorldSubsystem Interface
+
+private:
+	enum class ECrowdLOD : uint8
+	{
+		Full,
+		Reduced,
+		Minimal,
+		Idle,
+		Unset
+	};
+
+	enum class EMovementLOD : uint8
+	{
+		Full,
+		NavWalking,
+		NavWalkingThrottled,
+		Unset
+	};
+
+	struct FEnemyLODEntry
+	{
+		TWeakObjectPtr<UCrowdFollowingComponent> CrowdComp;
+		TWeakObjectPtr<const AWarriorAIController> Controller;
+		bool bScaleCrowdAvoidance = false;
+		ECrowdAvoidanceQuality::Type FullQuality = ECrowdAvoidanceQuality::High;
+		float FullQueryRange = 0.f;
+		ECrowdLOD AppliedCrowdLOD = ECrowdLOD::Unset;
+		EMovementLOD AppliedMovementLOD = EMovementLOD::Unset;
+	};
+
+	void UpdateCrowdLOD(const APawn* InHero);
+	void UpdateMovementLOD(const APawn* InHero);
+
+	static void ApplyCrowdLOD(FEnemyLODEntry& InEntry, ECrowdLOD InCrowdLOD);
+	static void ApplyMovementLOD(FEnemyLODEntry& InEntry, ACharacter& InCharacter, EMovementLOD InMovementLOD);
+
+	TArray<FEnemyLODEntry> Entries;
+
+	/** Distance squared to the hero and entry index of every moving enemy, kept around to avoid reallocating */
+	TArray<TPair<float, int32>> MovingEnemies;
+
+	float AccumulatedDeltaTime = 0.f;
+
+	double TotalPassMs = 0.0;
+
+	int32 LastRecordedSimulatedAgents = INDEX_NONE;
+};
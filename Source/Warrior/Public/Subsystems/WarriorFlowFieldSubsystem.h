@@ -0,0 +1,108 @@
+// ALL FREE
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WarriorFlowFieldSubsystem.generated.h"
+
+/**
+ * Distance field towards the hero over a grid laid across the level's nav mesh bounds, shared by every enemy following it.
+ * The grid is projected onto the nav mesh once, a few cells per frame. Neighbouring cells only connect when a nav mesh raycast between them is clear.
+ * When the hero enters another cell the field is rebuilt over several frames, followers keep using the previous one until the new one is done.
+ * Registered followers get their movement input here every frame, so looking up the way to go costs a cell lookup instead of a path query.
+ */
+UCLASS()
+class WARRIOR_API UWarriorFlowFieldSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin USubsystem Interface.
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	//~ Begin UWorldSubsystem Interface.
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	//~ End UWorldSubsystem Interface
+
+	//~ Begin FTickableGameObject Interface.
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	/** In the ground plane. False outside the grid, before the first field is done and where the hero can't be reached from. */
+	bool GetFlowDirection(const FVector& InLocation, FVector& OutDirection) const;
+
+	/** Where the hero was this frame */
+	const TOptional<FVector>& GetTargetLocation() const { return TargetLocation; }
+
+	/** InPawn gets movement input along the field every frame until it is unregistered */
+	void RegisterFollower(APawn* InPawn);
+	void UnregisterFollower(const APawn* InPawn);
+
+protected:
+	//~ Begin UWorldSubsystem Interface.
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~ End UWorldSubsystem Interface
+
+private:
+	enum class EGridBuildPhase : uint8
+	{
+		None,
+		ProjectingCells,
+		ConnectingCells,
+		Done
+	};
+
+	struct FOpenCell
+	{
+		float Distance = 0.f;
+		int32 CellIndex = INDEX_NONE;
+	};
+
+	/** Both spend InOutBudget and return once it runs out */
+	void StepGridBuild(int32& InOutBudget);
+	void StepFieldBuild(int32& InOutBudget);
+
+	void StartFieldBuild(int32 InTargetCellIndex);
+
+	void MoveFollowers() const;
+
+	int32 WorldToCellIndex(const FVector& InLocation) const;
+	FVector GetCellLocation(int32 InCellIndex) const;
+
+	/** Returns INDEX_NONE when there is no neighbour that way or it can't be walked to */
+	int32 GetConnectedNeighbour(int32 InCellIndex, int32 InDirection) const;
+
+	FVector2D GridOrigin = FVector2D::ZeroVector;
+	float GridZ = 0.f;
+	float GridHalfHeight = 0.f;
+	float CellSize = 0.f;
+	int32 NumCellsX = 0;
+	int32 NumCellsY = 0;
+
+	EGridBuildPhase GridBuildPhase = EGridBuildPhase::None;
+	int32 NextCellToBuild = 0;
+
+	/** Nav mesh height of each cell, unset where the cell is off the nav mesh */
+	TArray<TOptional<float>> CellHeights;
+
+	/** One bit per straight direction, diagonals are derived from them */
+	TArray<uint8> CellConnections;
+
+	/** The field followers read */
+	TArray<float> CellDistances;
+	int32 FieldTargetCellIndex = INDEX_NONE;
+
+	/** The field being built, swapped in once done */
+	TArray<float> BuildingCellDistances;
+	TArray<FOpenCell> OpenCells;
+	int32 BuildingTargetCellIndex = INDEX_NONE;
+
+	TOptional<FVector> TargetLocation;
+
+	TArray<TWeakObjectPtr<APawn>> Followers;
+};
@@ -0,0 +1,59 @@
+// ALL FREE
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WarriorStats.h"
+#include "WarriorHitchSubsystem.generated.h"
+
+/**
+ * Flags frames longer than Warrior.Hitch.ThresholdMs and writes a report to Saved/Profiling/Hitches with the wave,
+ * the alive enemy count and how long each WARRIOR_HITCH_SCOPE took during that frame.
+ * When Unreal Trace is running, a trace snapshot covering the frames around the hitch is saved next to the report.
+ */
+UCLASS()
+class WARRIOR_API UWarriorHitchSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin USubsystem Interface.
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	//~ Begin FTickableGameObject Interface.
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+protected:
+	//~ Begin UWorldSubsystem Interface.
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~ End UWorldSubsystem Interface
+
+private:
+	void ReportHitch(double InFrameMs, const WarriorStats::FHitchScopeTimings& InScopeTimings);
+	void WritePendingTraceSnapshot();
+
+	int32 CountAliveEnemies() const;
+
+	void OnPreGarbageCollect();
+	void OnPostGarbageCollect();
+
+	FDelegateHandle PreGarbageCollectDelegateHandle;
+	FDelegateHandle PostGarbageCollectDelegateHandle;
+
+	double GarbageCollectStartTime = 0.0;
+
+	/** Zero until the first tick, the frame a world starts on is not worth reporting */
+	double LastTickTime = 0.0;
+
+	double LastReportTime = -DBL_MAX;
+
+	FString PendingTraceSnapshotPath;
+
+	uint64 PendingTraceSnapshotFrame = 0;
+};
@@ -0,0 +1,82 @@
+// ALL FREE
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayTagContainer.h"
+#include "ProfilingDebugging/Histogram.h"
+#include "WarriorInputLatencySubsystem.generated.h"
+
+class UGameplayAbility;
+
+/**
+ * Measures how long a hero ability input takes to activate its ability, start its montage and land its first hit.
+ * Timings are kept per ability tag in histograms that are logged when the world ends or on Warrior.InputLatency.Dump,
+ * and the latest sample of each stage is shown under 'stat Warrior'.
+ * Only the newest press is tracked, a press that has not landed a hit within Warrior.InputLatency.MaxSampleSeconds is dropped.
+ */
+UCLASS()
+class WARRIOR_API UWarriorInputLatencySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin USubsystem Interface.
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	/** The static versions below do nothing when latency tracking is off for the world of WorldContextObject */
+	static void MarkInputPressed(const UObject* WorldContextObject, const FGameplayTag& InInputTag);
+	static void MarkAbilityActivated(const UObject* WorldContextObject, const UGameplayAbility* InAbility);
+	static void MarkMontageStarted(const UObject* WorldContextObject, const UGameplayAbility* InAnimatingAbility);
+	static void MarkHitLanded(const UObject* WorldContextObject);
+
+	void DumpToLog() const;
+
+protected:
+	//~ Begin UWorldSubsystem Interface.
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~ End UWorldSubsystem Interface
+
+private:
+	struct FPendingSample
+	{
+		double InputPressedTime = 0.0;
+
+		FGameplayTag InputTag;
+
+		/** Set on activation, the first ability tag or the input tag for abilities without one */
+		FGameplayTag AbilityTag;
+
+		TWeakObjectPtr<const UClass> AbilityClass;
+
+		bool bMontageStarted = false;
+	};
+
+	struct FAbilityLatencyHistograms
+	{
+		FAbilityLatencyHistograms();
+
+		FHistogram InputToActivation;
+		FHistogram InputToMontageStart;
+		FHistogram InputToFirstHit;
+	};
+
+	void OnInputPressed(const FGameplayTag& InInputTag);
+	void OnAbilityActivated(const UGameplayAbility* InAbility);
+	void OnMontageStarted(const UGameplayAbility* InAnimatingAbility);
+	void OnHitLanded();
+
+	/** Elapsed ms of the pending sample, unset once it has gone stale */
+	TOptional<double> GetPendingSampleMs();
+
+	static UWarriorInputLatencySubsystem* Get(const UObject* WorldContextObject);
+
+	static void DumpHistogramToLog(const TCHAR* InStageName, const FHistogram& InHistogram);
+
+	TOptional<FPendingSample> PendingSample;
+
+	TMap<FGameplayTag, FAbilityLatencyHistograms> AbilityHistograms;
+};
@@ -0,0 +1,67 @@
+// ALL FREE
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "WarriorOrientationSubsystem.generated.h"
+
+/**
+ * Turns every registered pawn towards its target in a single pass per frame.
+ * Positions are gathered into flat arrays, the yaw interpolation runs over those and only pawns that actually turned get SetActorRotation.
+ * Pawns further than Warrior.Orientation.FarDistance from their target update every Warrior.Orientation.FarInterval seconds instead of every frame.
+ * Several nodes may ask to turn the same pawn, the most recent request wins and the previous one resumes once it is withdrawn.
+ */
+UCLASS()
+class WARRIOR_API UWarriorOrientationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin USubsystem Interface.
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	//~ Begin FTickableGameObject Interface.
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	/** Updates the request if InRequester already has one for InPawn */
+	void RegisterPawn(APawn* InPawn, AActor* InTargetActor, float InRotationInterpSpeed, const UObject* InRequester);
+	void UnregisterPawn(const APawn* InPawn, const UObject* InRequester);
+
+	int32 GetNumRegisteredPawns() const { return Pawns.Num(); }
+
+private:
+	struct FOrientationRequest
+	{
+		FObjectKey Requester;
+		TWeakObjectPtr<AActor> TargetActor;
+		float RotationInterpSpeed = 0.f;
+	};
+
+	using FOrientationRequestStack = TArray<FOrientationRequest, TInlineAllocator<2>>;
+
+	/** Copies the newest request of a slot into the flat arrays the per frame pass reads */
+	void ApplyTopRequest(int32 InIndex);
+
+	void RemoveAtSwap(int32 InIndex);
+
+	/** Parallel arrays, one slot per registered pawn */
+	TArray<TWeakObjectPtr<APawn>> Pawns;
+	TArray<FOrientationRequestStack> RequestStacks;
+	TArray<TWeakObjectPtr<AActor>> TargetActors;
+	TArray<float> RotationInterpSpeeds;
+	TArray<float> AccumulatedDeltaTimes;
+
+	/** Scratch for the per frame pass, kept around to avoid reallocating */
+	TArray<int32> DueIndices;
+	TArray<float> CurrentYaws;
+	TArray<float> NewYaws;
+	TArray<float> DeltaXs;
+	TArray<float> DeltaYs;
+	TArray<float> InterpAlphas;
+};
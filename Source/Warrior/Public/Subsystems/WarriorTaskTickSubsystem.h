@@ -0,0 +1,58 @@
+// ALL FREE
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WarriorTaskTickSubsystem.generated.h"
+
+class UAbilityTask_ExecuteTaskOnTick;
+
+/**
+ * Ticks every active UAbilityTask_ExecuteTaskOnTick in a single pass per frame.
+ * Tasks sharing a tick interval share a bucket, so the bucket is skipped as a whole until one of them is due.
+ */
+UCLASS()
+class WARRIOR_API UWarriorTaskTickSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin USubsystem Interface.
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	//~ Begin FTickableGameObject Interface.
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	void RegisterTickTask(UAbilityTask_ExecuteTaskOnTick* InTask);
+	void UnregisterTickTask(UAbilityTask_ExecuteTaskOnTick* InTask);
+
+private:
+	struct FTickTaskEntry
+	{
+		TWeakObjectPtr<UAbilityTask_ExecuteTaskOnTick> Task;
+		float JoinedAtDeltaTime = 0.f;
+	};
+
+	struct FTickTaskBucket
+	{
+		float TickInterval = 0.f;
+		float AccumulatedDeltaTime = 0.f;
+		TArray<FTickTaskEntry> Entries;
+	};
+
+	FTickTaskBucket& FindOrAddBucket(float InTickInterval);
+	void RemoveEndedTasks();
+
+	TArray<FTickTaskBucket> TickTaskBuckets;
+
+	int32 NumRegisteredTasks = 0;
+
+	bool bIsTickingTasks = false;
+
+	bool bHasPendingRemovals = false;
+};
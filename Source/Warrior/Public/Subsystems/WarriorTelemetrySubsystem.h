@@ -0,0 +1,56 @@
+// ALL FREE
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WarriorTypes/WarriorTelemetryLog.h"
+#include "WarriorTelemetrySubsystem.generated.h"
+
+/**
+ * Records frame, game thread, render thread, GPU and GC times plus gameplay markers for the lifetime of a game world.
+ * Off unless Warrior.Telemetry.Enabled is set, e.g. -ini:Engine:[ConsoleVariables]:Warrior.Telemetry.Enabled=1 on a playtest build.
+ * Files land in Saved/Profiling/Telemetry and are read back by -run=WarriorTelemetryAnalyzer.
+ */
+UCLASS()
+class WARRIOR_API UWarriorTelemetrySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin USubsystem Interface.
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	//~ Begin FTickableGameObject Interface.
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	void RecordMarker(EWarriorTelemetryMarker InMarker, int32 InValue = 0);
+
+	/** Does nothing when telemetry is off for the world of WorldContextObject */
+	static void RecordMarker(const UObject* WorldContextObject, EWarriorTelemetryMarker InMarker, int32 InValue = 0);
+
+protected:
+	//~ Begin UWorldSubsystem Interface.
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~ End UWorldSubsystem Interface
+
+private:
+	void OnPreGarbageCollect();
+	void OnPostGarbageCollect();
+
+	TUniquePtr<FWarriorTelemetryRingWriter> RingWriter;
+
+	FDelegateHandle PreGarbageCollectDelegateHandle;
+	FDelegateHandle PostGarbageCollectDelegateHandle;
+
+	double GarbageCollectStartTime = 0.0;
+
+	/** GC time since the last recorded frame */
+	double PendingGarbageCollectMs = 0.0;
+};
@@ -0,0 +1,92 @@
+// ALL FREE
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayTagContainer.h"
+#include "WarriorTypes/WarriorEnumTypes.h"
+#include "WarriorUtilityBrainSubsystem.generated.h"
+
+class AWarriorAIController;
+class UAbilitySystemComponent;
+
+/**
+ * Picks the next action of every enemy whose controller sets bUseUtilityBrain, every Warrior.UtilityBrain.Interval seconds.
+ * The game thread only copies a few values per enemy into plain structs. Scoring runs across worker threads with ParallelFor, and every enemy
+ * weighs itself against the whole crowd on the same target, so the cost that grows with the wave is the part spread over the cores.
+ * Decisions are written back to each ChosenAction key on the game thread, where UBTDecorator_IsChosenAction gates the tree's branches.
+ */
+UCLASS()
+class WARRIOR_API UWarriorUtilityBrainSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin USubsystem Interface.
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	//~ Begin FTickableGameObject Interface.
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	void RegisterController(AWarriorAIController* InController);
+	void UnregisterController(const AWarriorAIController* InController);
+
+protected:
+	//~ Begin UWorldSubsystem Interface.
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~ End UWorldSubsystem Interface
+
+private:
+	/** Everything an enemy's choice depends on, copied out so scoring needs no UObject */
+	struct FDecisionInput
+	{
+		FVector Location = FVector::ZeroVector;
+		float DistanceToTarget = 0.f;
+		float AttackRange = 0.f;
+		float HealthRatio = 1.f;
+		float RetreatHealthRatio = 0.f;
+
+		/** Enemies with the same index chase the same target, INDEX_NONE without one */
+		int32 TargetIndex = INDEX_NONE;
+
+		bool bAttackOnCooldown = false;
+		bool bHoldsAttackToken = false;
+		bool bUnderAttack = false;
+		bool bStrafing = false;
+		bool bDead = false;
+	};
+
+	struct FBrainEntry
+	{
+		TWeakObjectPtr<AWarriorAIController> Controller;
+
+		/** Cooldown tags of the enemy's melee abilities, rebuilt when its granted abilities change instead of walking them every pass */
+		FGameplayTagContainer MeleeCooldownTags;
+		int32 NumAbilitySpecs = INDEX_NONE;
+	};
+
+	/** Game thread only */
+	void GatherDecisionInputs();
+	void ApplyDecisions();
+
+	static void CacheMeleeCooldownTags(FBrainEntry& InEntry, const UAbilitySystemComponent& InASC);
+
+	/** Pure, runs on worker threads */
+	static EWarriorEnemyAction ChooseAction(const FDecisionInput& InInput, TConstArrayView<FDecisionInput> InCrowd, int32 InMaxEngagedPerTarget);
+
+	TArray<FBrainEntry> Entries;
+
+	/** Index aligned with Entries for the duration of a pass */
+	TArray<FDecisionInput> DecisionInputs;
+	TArray<EWarriorEnemyAction> Decisions;
+
+	/** Targets seen this pass, only used to hand out TargetIndex */
+	TArray<const AActor*> PassTargets;
+
+	float AccumulatedDeltaTime = 0.f;
+};
@@ -1,28 +1,87 @@
-
 #pragma once
 
+#include "Warrior.h"
+
+#define WARRIOR_ENABLE_LOGGING (!NO_LOGGING && !UE_BUILD_SHIPPING)
+#define WARRIOR_ENABLE_DEBUG_DRAW (!UE_BUILD_SHIPPING && !UE_BUILD_TEST)
+
+#if WARRIOR_ENABLE_LOGGING
+
+/** Logs to LogWarrior. Arguments are only evaluated and formatted when the verbosity is enabled. */
+#define WARRIOR_LOG(Verbosity, Format, ...) \
+	UE_LOG(LogWarrior, Verbosity, Format, ##__VA_ARGS__)
+
+/** Same as WARRIOR_LOG, but each call site logs at most once every MinIntervalSeconds */
+#define WARRIOR_LOG_RATE_LIMITED(Verbosity, MinIntervalSeconds, Format, ...) \
+	do \
+	{ \
+		if (!LogWarrior.IsSuppressed(ELogVerbosity::Verbosity)) \
+		{ \
+			static double WarriorLogLastTime = -DBL_MAX; \
+			static int32 WarriorLogNumSkipped = 0; \
+			const double WarriorLogNow = FPlatformTime::Seconds(); \
+			if (WarriorLogNow - WarriorLogLastTime >= (MinIntervalSeconds)) \
+			{ \
+				UE_LOG(LogWarrior, Verbosity, Format, ##__VA_ARGS__); \
+				if (WarriorLogNumSkipped > 0) \
+				{ \
+					UE_LOG(LogWarrior, Verbosity, TEXT("(%d more like this since the last one)"), WarriorLogNumSkipped); \
+				} \
+				WarriorLogLastTime = WarriorLogNow; \
+				WarriorLogNumSkipped = 0; \
+			} \
+			else \
+			{ \
+				WarriorLogNumSkipped++; \
+			} \
+		} \
+	} while (0)
+
+/** Logs and mirrors the message on screen, for things worth seeing while playing in a development build */
+#define WARRIOR_SCREEN_LOG(Color, Format, ...) \
+	do \
+	{ \
+		if (GEngine && !LogWarrior.IsSuppressed(ELogVerbosity::Log)) \
+		{ \
+			const FString WarriorScreenLogMessage = FString::Printf(Format, ##__VA_ARGS__); \
+			GEngine->AddOnScreenDebugMessage(INDEX_NONE, 7.f, Color, WarriorScreenLogMessage); \
+			UE_LOG(LogWarrior, Log, TEXT("%s"), *WarriorScreenLogMessage); \
+		} \
+	} while (0)
+
+#else
+
+#define WARRIOR_LOG(Verbosity, Format, ...) do {} while (0)
+#define WARRIOR_LOG_RATE_LIMITED(Verbosity, MinIntervalSeconds, Format, ...) do {} while (0)
+#define WARRIOR_SCREEN_LOG(Color, Format, ...) do {} while (0)
+
+#endif // WARRIOR_ENABLE_LOGGING
+
 namespace Debug
 {
     static void Print(const FString& Msg, const FColor& Color = FColor::MakeRandomColor(), int32 InKey = -1)
     {
+#if WARRIOR_ENABLE_LOGGING
         if (GEngine)
         {
             GEngine -> AddOnScreenDebugMessage(InKey, 7.f, Color, Msg);
 
-            UE_LOG(LogTemp, Warning, TEXT("%s"), *Msg);
+            UE_LOG(LogWarrior, Log, TEXT("%s"), *Msg);
         }
+#endif
     }
 
     static void Print(const FString& FloatTitle, float FloatValueToPrint, int32 InKey = -1, const FColor& Color = FColor::MakeRandomColor())
     {
+#if WARRIOR_ENABLE_LOGGING
         if (GEngine)
         {
             const FString FinalMsg = FloatTitle + TEXT(": ") + FString::SanitizeFloat(FloatValueToPrint);
 
             GEngine->AddOnScreenDebugMessage(InKey, 7.f, Color, FinalMsg);
 
-            UE_LOG(LogTemp, Warning, TEXT("%s"), *FinalMsg);
+            UE_LOG(LogWarrior, Log, TEXT("%s"), *FinalMsg);
         }
+#endif
     }
 }
-
@@ -66,9 +66,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Warrior|FunctionLibrary", meta = (WorldContext = "WorldContextObject"))
 	static void ToggleInputMode(const UObject* WorldContextObject, EWarriorInputMode InInputMode);
 
-	UFUNCTION(BlueprintCallable, Category = "Warrior|FunctionLibrary")
-	static void SaveCurrentGameDifficulty(EWarriorGameplayDifficulty ToSaveGameDifficulty);
+	UFUNCTION(BlueprintCallable, Category = "Warrior|FunctionLibrary", meta = (WorldContext = "WorldContextObject"))
+	static void SaveCurrentGameDifficulty(const UObject* WorldContextObject, EWarriorGameplayDifficulty ToSaveGameDifficulty);
 
-	UFUNCTION(BlueprintCallable, Category = "Warrior|FunctionLibrary")
-	static bool TryLoadSavedGameDifficulty(EWarriorGameplayDifficulty& OutSavedGameplayDifficulity);
+	UFUNCTION(BlueprintCallable, Category = "Warrior|FunctionLibrary", meta = (WorldContext = "WorldContextObject"))
+	static bool TryLoadSavedGameDifficulty(const UObject* WorldContextObject, EWarriorGameplayDifficulty& OutSavedGameplayDifficulity);
 };
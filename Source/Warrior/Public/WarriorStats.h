@@ -0,0 +1,140 @@
+// ALL FREE
+
+#pragma once
+
+#include "Stats/Stats.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "Engine/StreamableManager.h"
+
+DECLARE_STATS_GROUP(TEXT("Warrior"), STATGROUP_Warrior, STATCAT_Advanced);
+
+/** Level Transition **/
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Last Level Transition (ms)"), STAT_Warrior_LastLevelTransitionMs, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Last Level Transition Was Prefetched"), STAT_Warrior_LastLevelTransitionPrefetched, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Last Load To First Input (ms)"), STAT_Warrior_LastLoadToFirstInputMs, STATGROUP_Warrior, WARRIOR_API);
+
+/** Save Game **/
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Save Profile Load Latency (ms)"), STAT_Warrior_SaveGameLoadLatencyMs, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Save Profile Save Latency (ms)"), STAT_Warrior_SaveGameSaveLatencyMs, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Save Profile Writes"), STAT_Warrior_SaveGameWrites, STATGROUP_Warrior, WARRIOR_API);
+
+/** Gameplay Counters **/
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Alive Enemies"), STAT_Warrior_AliveEnemies, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Enemy Spawns Per Second"), STAT_Warrior_EnemySpawnsPerSecond, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Pending Async Loads"), STAT_Warrior_PendingAsyncLoads, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Gameplay Effects Applied"), STAT_Warrior_GameplayEffectsApplied, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Melee Overlaps"), STAT_Warrior_MeleeOverlaps, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Tag Queries"), STAT_Warrior_TagQueries, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Target Lock Candidates"), STAT_Warrior_TargetLockCandidates, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Oriented Pawns"), STAT_Warrior_OrientedPawns, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Aware Enemies"), STAT_Warrior_AwareEnemies, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Awareness Traces"), STAT_Warrior_AwarenessTraces, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Crowd Agents Simulated"), STAT_Warrior_CrowdAgentsSimulated, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Crowd Agents Full Quality"), STAT_Warrior_CrowdAgentsFullQuality, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Enemies Nav Walking"), STAT_Warrior_EnemiesNavWalking, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Attack Tokens In Use"), STAT_Warrior_AttackTokensInUse, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Attack Tokens Denied"), STAT_Warrior_AttackTokensDenied, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Flow Field Followers"), STAT_Warrior_FlowFieldFollowers, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Utility Brain Enemies"), STAT_Warrior_UtilityBrainEnemies, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Lean Enemy Health Bars Shown"), STAT_Warrior_EnemyHealthBarsShown, STATGROUP_Warrior, WARRIOR_API);
+
+/** Gameplay Cycles **/
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Survival Spawn Wave Enemies"), STAT_Warrior_SurvivalSpawn, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Target Lock Tick"), STAT_Warrior_TargetLockTick, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Target Lock Acquire"), STAT_Warrior_TargetLockAcquire, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Damage Execution"), STAT_Warrior_DamageExecution, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Attribute Post Execute"), STAT_Warrior_AttributePostExecute, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Combat Hit Target"), STAT_Warrior_CombatHitTarget, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AI Service Tick"), STAT_Warrior_AIServiceTick, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Orientation Batch"), STAT_Warrior_OrientationBatch, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Awareness Pass"), STAT_Warrior_AwarenessPass, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Enemy LOD Pass"), STAT_Warrior_EnemyLODPass, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Flow Field Update"), STAT_Warrior_FlowFieldUpdate, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Utility Brain Pass"), STAT_Warrior_UtilityBrainPass, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Utility Brain Scoring"), STAT_Warrior_UtilityBrainScoring, STATGROUP_Warrior, WARRIOR_API);
+
+/** Input Latency **/
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Input To Ability Activation (ms)"), STAT_Warrior_InputToActivationMs, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Input To Montage Start (ms)"), STAT_Warrior_InputToMontageStartMs, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Input To First Hit (ms)"), STAT_Warrior_InputToFirstHitMs, STATGROUP_Warrior, WARRIOR_API);
+
+/** AI Budget **/
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Behavior Tree Tick"), STAT_Warrior_BehaviorTreeTick, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Behavior Tree Frame Cost (ms)"), STAT_Warrior_BehaviorTreeFrameMs, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Behavior Trees Ticked"), STAT_Warrior_BehaviorTreesTicked, STATGROUP_Warrior, WARRIOR_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Behavior Trees Deferred"), STAT_Warrior_BehaviorTreesDeferred, STATGROUP_Warrior, WARRIOR_API);
+
+/** Memory **/
+// Shown under 'stat LLM' / 'stat LLMFULL' and in -llm captures. Wrap allocations with LLM_SCOPE_BYTAG(Warrior_X).
+LLM_DECLARE_TAG_API(Warrior_Enemies, WARRIOR_API);
+LLM_DECLARE_TAG_API(Warrior_Abilities, WARRIOR_API);
+LLM_DECLARE_TAG_API(Warrior_Widgets, WARRIOR_API);
+LLM_DECLARE_TAG_API(Warrior_Projectiles, WARRIOR_API);
+LLM_DECLARE_TAG_API(Warrior_WaveArchetypes, WARRIOR_API);
+
+/** Hitch Attribution **/
+#define WARRIOR_ENABLE_HITCH_SCOPES (!UE_BUILD_SHIPPING)
+
+enum class EWarriorHitchScope : uint8
+{
+	EnemySpawn,
+	AsyncLoadCompletion,
+	GarbageCollection,
+	DamageResolution,
+	WidgetCreation,
+	AbilityActivation,
+	InputMappingChange,
+	Num
+};
+
+WARRIOR_API const TCHAR* LexToString(EWarriorHitchScope InScope);
+
+namespace WarriorStats
+{
+	/** RequestAsyncLoad that counts the load in STAT_Warrior_PendingAsyncLoads until it either completes, then forwards to InDelegate, or is cancelled */
+	WARRIOR_API TSharedPtr<FStreamableHandle> RequestTrackedAsyncLoad(FStreamableManager& InStreamableManager, TArray<FSoftObjectPath> InTargetsToStream, FStreamableDelegate InDelegate, TAsyncLoadPriority InPriority = FStreamableManager::DefaultAsyncLoadPriority);
+	WARRIOR_API TSharedPtr<FStreamableHandle> RequestTrackedAsyncLoad(FStreamableManager& InStreamableManager, const FSoftObjectPath& InTargetToStream, FStreamableDelegate InDelegate, TAsyncLoadPriority InPriority = FStreamableManager::DefaultAsyncLoadPriority);
+
+	struct FHitchScopeTiming
+	{
+		double TotalMs = 0.0;
+		int32 Count = 0;
+	};
+
+	using FHitchScopeTimings = FHitchScopeTiming[static_cast<uint8>(EWarriorHitchScope::Num)];
+
+	/** Game thread only */
+	WARRIOR_API void AddHitchScopeTiming(EWarriorHitchScope InScope, double InMs);
+
+	/** Copies out everything timed since the previous call and starts over */
+	WARRIOR_API void ConsumeHitchScopeTimings(FHitchScopeTimings& OutTimings);
+}
+
+#if WARRIOR_ENABLE_HITCH_SCOPES
+/** Times a game thread region for the hitch detector. Times are inclusive, so nested scopes of different kinds overlap. */
+class FWarriorHitchScope
+{
+public:
+	explicit FWarriorHitchScope(EWarriorHitchScope InScope)
+		: Scope(InScope)
+		, StartCycles(IsInGameThread() ? FPlatformTime::Cycles64() : 0)
+	{
+	}
+
+	~FWarriorHitchScope()
+	{
+		if (StartCycles != 0)
+		{
+			WarriorStats::AddHitchScopeTiming(Scope, FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles));
+		}
+	}
+
+private:
+	EWarriorHitchScope Scope;
+	uint64 StartCycles;
+};
+
+#define WARRIOR_HITCH_SCOPE(Scope) FWarriorHitchScope PREPROCESSOR_JOIN(WarriorHitchScope_, __LINE__)(EWarriorHitchScope::Scope)
+#else
+#define WARRIOR_HITCH_SCOPE(Scope)
+#endif // WARRIOR_ENABLE_HITCH_SCOPES
@@ -5,8 +5,11 @@
 #include "CoreMinimal.h"
 #include "WarriorEnumTypes.h"
 
-
-class FWarriorCountDownAction : public FPendingLatentAction
+/**
+ * State of one CountDown node. Owned and woken by UWarriorCountDownSubsystem at every update interval
+ * boundary, instead of being polled each frame by the latent action manager.
+ */
+class FWarriorCountDownAction
 {
 public:
 	FWarriorCountDownAction(float InTotalCountDownTime, float InUpdateInterval, float& InOutRemainingTime, EWarriorCountDownActionOutput& InCountDownOutput, const FLatentActionInfo& LatentInfo)
@@ -18,15 +21,20 @@ public:
 		, ExecutionFunction(LatentInfo.ExecutionFunction)
 		, OutputLink(LatentInfo.Linkage)
 		, CallbackTarget(LatentInfo.CallbackTarget)
-		, ElapsedInterval(0.f)
 		, ElapsedTimeSinceStart(0.f)
 	{
 	}
 
-	virtual void UpdateOperation(FLatentResponse& Response)override;
+	/** Called once per update interval with the real time since the last call, which runs over the interval on slow frames. Returns true when the count down is finished and can be removed. */
+	bool UpdateOperation(float InElapsedTime);
 	void CancelAction();
 
+	FORCEINLINE bool IsCancelled() const { return bNeedToCancel; }
+	FORCEINLINE float GetUpdateInterval() const { return UpdateInterval; }
+
 private:
+	void TriggerOutput(EWarriorCountDownActionOutput InOutput);
+
 	bool bNeedToCancel;
 	float TotalCountDownTime;
 	float UpdateInterval;
@@ -35,6 +43,5 @@ private:
 	FName ExecutionFunction;
 	int32 OutputLink;
 	FWeakObjectPtr CallbackTarget;
-	float ElapsedInterval;
 	float ElapsedTimeSinceStart;
 };
@@ -50,4 +50,15 @@ enum class EWarriorInputMode : uint8
 {
 	GameOnly,
 	UIOnly 
-};
\ No newline at end of file
+};
+
+/** Written to the ChosenAction blackboard key by UWarriorUtilityBrainSubsystem */
+UENUM(BlueprintType)
+enum class EWarriorEnemyAction : uint8
+{
+	None,
+	Chase,
+	Attack,
+	Strafe,
+	Retreat
+};
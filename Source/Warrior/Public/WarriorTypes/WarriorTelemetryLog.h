@@ -0,0 +1,89 @@
+// ALL FREE
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Pipe.h"
+
+class IFileHandle;
+
+enum class EWarriorTelemetryMarker : uint8
+{
+	WaveStarted,
+	WaveCompleted,
+	SpawnBurst,
+	TargetLockOn,
+	TargetLockOff,
+	WeaponEquipped,
+	WeaponUnequipped,
+	CrowdAgents,
+	Num
+};
+
+WARRIOR_API const TCHAR* LexToString(EWarriorTelemetryMarker InMarker);
+
+struct FWarriorTelemetryFrame
+{
+	uint32 FrameNumber = 0;
+
+	float FrameMs = 0.f;
+
+	float GameThreadMs = 0.f;
+
+	float RenderThreadMs = 0.f;
+
+	float GPUMs = 0.f;
+
+	float GCMs = 0.f;
+};
+
+struct FWarriorTelemetryMarker
+{
+	uint32 FrameNumber = 0;
+
+	EWarriorTelemetryMarker Marker = EWarriorTelemetryMarker::WaveStarted;
+
+	int32 Value = 0;
+};
+
+/**
+ * Writes frame timings and gameplay markers into a fixed size ring file of 16 byte records.
+ * Appending only encodes into a pending batch on the game thread, file IO runs on a background pipe.
+ * Once the ring is full the oldest records are overwritten, so a long session keeps its most recent history.
+ */
+class WARRIOR_API FWarriorTelemetryRingWriter
+{
+public:
+	FWarriorTelemetryRingWriter(const FString& InFilePath, uint32 InCapacity);
+	~FWarriorTelemetryRingWriter();
+
+	void AppendFrame(const FWarriorTelemetryFrame& InFrame);
+	void AppendMarker(const FWarriorTelemetryMarker& InMarker);
+
+	/** Hands the pending records to the background pipe */
+	void Submit();
+	void Flush();
+
+	int32 GetNumPendingRecords() const { return PendingBytes.Num() / RecordSize; }
+
+	/** Reads a ring file back in the order the records were written */
+	static bool ReadRingFile(const FString& InFilePath, TArray<FWarriorTelemetryFrame>& OutFrames, TArray<FWarriorTelemetryMarker>& OutMarkers);
+
+	static constexpr int32 RecordSize = 16;
+
+private:
+	void WriteBatch(const TArray<uint8>& InBatch, uint64 InFirstRecordIndex);
+
+	FString FilePath;
+
+	uint32 Capacity;
+
+	UE::Tasks::FPipe WritePipe;
+
+	/** Only touched from the pipe */
+	TUniquePtr<IFileHandle> FileHandle;
+
+	TArray<uint8> PendingBytes;
+
+	uint64 NumRecordsSubmitted = 0;
+};
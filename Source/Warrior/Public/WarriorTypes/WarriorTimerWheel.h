@@ -0,0 +1,59 @@
+// ALL FREE
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Hierarchical timer wheel. Three levels of 256 slots cover about 46 hours at a 10ms resolution,
+ * anything further out waits in an overflow list. Adding and removing a timer is O(1) and advancing
+ * only touches the slots that are due, so idle timers cost nothing per frame.
+ */
+class WARRIOR_API FWarriorTimerWheel
+{
+public:
+	FWarriorTimerWheel();
+
+	/** Returns the id of the new timer. Delays shorter than one tick still wait for the next tick. */
+	int32 AddTimer(uint64 InDelayTicks, int32 InPayload);
+
+	void RemoveTimer(int32 InTimerId);
+
+	/** Moves time forward and appends the payload of every timer that came due, in expiry order */
+	void Advance(uint64 InNumTicks, TArray<int32>& OutExpiredPayloads);
+
+	void Reset();
+
+	bool IsEmpty() const { return Timers.IsEmpty(); }
+
+	int32 Num() const { return Timers.Num(); }
+
+	uint64 GetCurrentTick() const { return CurrentTick; }
+
+private:
+	static constexpr int32 NumLevels = 3;
+	static constexpr int32 SlotBits = 8;
+	static constexpr int32 SlotsPerLevel = 1 << SlotBits;
+	static constexpr uint64 SlotMask = SlotsPerLevel - 1;
+	static constexpr int32 OverflowSlot = NumLevels * SlotsPerLevel;
+
+	struct FTimer
+	{
+		uint64 ExpireTick = 0;
+		int32 Payload = INDEX_NONE;
+		int32 Slot = INDEX_NONE;
+		int32 Prev = INDEX_NONE;
+		int32 Next = INDEX_NONE;
+	};
+
+	void LinkTimer(int32 InTimerId);
+	void UnlinkTimer(int32 InTimerId);
+	void CascadeSlot(int32 InSlot);
+
+	TSparseArray<FTimer> Timers;
+
+	/** Head of the intrusive list of timers in every slot, with the overflow list last */
+	int32 SlotHeads[OverflowSlot + 1];
+
+	uint64 CurrentTick = 0;
+};
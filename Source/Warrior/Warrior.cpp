@@ -3,4 +3,6 @@
 #include "Warrior.h"
 #include "Modules/ModuleManager.h"
 
+DEFINE_LOG_CATEGORY(LogWarrior);
+
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, Warrior, "Warrior" );